@@ -351,6 +351,76 @@ public:
     return true;
   }
 
+  /* reports entries in which a value of one of the tracked columns (for which
+   * smaller is better) grew by more than `tolerance` relative to the old
+   * dataset; returns false if there is any such entry */
+  bool check_regressions( std::vector<std::string> const& track_columns,
+                          double tolerance = 0.1,
+                          std::string const& old_version = {},
+                          std::string const& current_version = {},
+                          std::ostream& os = std::cout ) const
+  {
+    if ( data_.empty() || ( data_.size() < 2u && old_version.empty() ) )
+    {
+      fmt::print( "[w] dataset contains less than two entry sets\n" );
+      return true;
+    }
+
+    try
+    {
+      auto const& data_old = dataset( old_version, data_[data_.size() < 2u ? 0u : data_.size() - 2u] );
+      auto const& data_cur = dataset( current_version, data_.back() );
+
+      fmt::print( "[i] check regressions of " );
+      fmt::print( fg( fmt::terminal_color::blue ), "{}", data_cur["version"] );
+      fmt::print( " against " );
+      fmt::print( fg( fmt::terminal_color::blue ), "{}\n", data_old["version"] );
+
+      uint32_t regressions{0u};
+      for ( auto const& entry : data_cur["entries"] )
+      {
+        auto const& key = entry[column_names_.front()];
+        auto const it = std::find_if( data_old["entries"].begin(), data_old["entries"].end(), [&]( auto const& old_entry ) {
+          return old_entry[column_names_.front()] == key;
+        } );
+        if ( it == data_old["entries"].end() )
+        {
+          continue;
+        }
+
+        for ( auto const& column : track_columns )
+        {
+          if ( !entry.contains( column ) || !it->contains( column ) || !entry[column].is_number() || !( *it )[column].is_number() )
+          {
+            continue;
+          }
+          double const value_old = ( *it )[column];
+          double const value_cur = entry[column];
+          if ( value_old > 0 && value_cur > value_old * ( 1.0 + tolerance ) )
+          {
+            os << fmt::format( "[w] {} {}: {:.2f} -> {:.2f} (+{:.1f}%)\n", key.dump(), column, value_old, value_cur, 100.0 * ( value_cur - value_old ) / value_old );
+            ++regressions;
+          }
+        }
+      }
+
+      if ( regressions == 0u )
+      {
+        os << fmt::format( "[i] no regressions above {:.1f}%\n", 100.0 * tolerance );
+      }
+      else
+      {
+        os << fmt::format( "[i] {} regressions above {:.1f}%\n", regressions, 100.0 * tolerance );
+      }
+      return regressions == 0u;
+    }
+    catch ( ... )
+    {
+      fmt::print( "[w] dataset not found\n" );
+      return false;
+    }
+  }
+
 private:
   std::string name_;
   std::string filename_;
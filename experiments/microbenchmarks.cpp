@@ -0,0 +1,396 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+  Throughput of core network operations.
+
+  Usage: microbenchmarks [options] [benchmark...]
+
+    --repetitions N   runs of each operation, the fastest run is reported (default: 5)
+    --save VERSION    stores the results under VERSION instead of the git revision
+    --baseline VERSION
+                      checks for regressions against VERSION instead of the previous results
+    --tolerance X     relative slowdown that is reported as a regression (default: 0.1)
+
+  Results are stored in microbenchmarks.json.  The program returns 1 if some
+  operation got slower (or used more memory) than in the baseline by more
+  than the tolerance.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <sys/resource.h>
+#endif
+
+#include <fmt/format.h>
+#include <kitty/partial_truth_table.hpp>
+#include <kitty/constructors.hpp>
+#include <kitty/static_truth_table.hpp>
+#include <lorina/aiger.hpp>
+#include <lorina/genlib.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/mapper.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <mockturtle/io/write_aiger.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/node_map.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/utils/tech_library.hpp>
+
+#include <experiments.hpp>
+
+std::string const library = "GATE   inv1    1 O=!a;           PIN * INV 1 999 0.9 0.3 0.9 0.3\n"
+                            "GATE   nand2   2 O=!(ab);        PIN * INV 1 999 1.0 0.2 1.0 0.2\n"
+                            "GATE   nand3   3 O=!(abc);       PIN * INV 1 999 1.1 0.3 1.1 0.3\n"
+                            "GATE   nor2    2 O=!{ab};        PIN * INV 1 999 1.4 0.5 1.4 0.5\n"
+                            "GATE   and2    3 O=(ab);         PIN * NONINV 1 999 1.9 0.3 1.9 0.3\n"
+                            "GATE   or2     3 O={ab};         PIN * NONINV 1 999 2.4 0.3 2.4 0.3\n"
+                            "GATE   xor2    5 O=[ab];         PIN * UNKNOWN 2 999 1.9 0.5 1.9 0.5\n"
+                            "GATE   aoi21   3 O=!{(ab)c};     PIN * INV 1 999 1.6 0.4 1.6 0.4\n"
+                            "GATE   oai21   3 O=!({ab}c);     PIN * INV 1 999 1.6 0.4 1.6 0.4\n"
+                            "GATE   buf     2 O=a;            PIN * NONINV 1 999 1.0 0.0 1.0 0.0\n"
+                            "GATE   zero    0 O=0;\n"
+                            "GATE   one     0 O=1;";
+
+/* keeps results of otherwise unused computations */
+volatile uint64_t sink;
+
+/* resets the peak resident set size of the process (Linux only) */
+void reset_peak_rss()
+{
+  std::ofstream out( "/proc/self/clear_refs" );
+  if ( out.is_open() )
+  {
+    out << "5";
+  }
+}
+
+/* peak resident set size in MB */
+double peak_rss()
+{
+  std::ifstream in( "/proc/self/status" );
+  std::string line;
+  while ( std::getline( in, line ) )
+  {
+    if ( line.compare( 0u, 6u, "VmHWM:" ) == 0 )
+    {
+      return std::strtod( line.c_str() + 6u, nullptr ) / 1024.0;
+    }
+  }
+
+#if defined( __APPLE__ )
+  struct rusage usage;
+  getrusage( RUSAGE_SELF, &usage );
+  return usage.ru_maxrss / ( 1024.0 * 1024.0 );
+#elif defined( __unix__ )
+  struct rusage usage;
+  getrusage( RUSAGE_SELF, &usage );
+  return usage.ru_maxrss / 1024.0;
+#else
+  return 0.0;
+#endif
+}
+
+/* simulates primary inputs with random patterns */
+template<uint32_t NumVars>
+class random_static_simulator
+{
+public:
+  kitty::static_truth_table<NumVars> compute_constant( bool value ) const
+  {
+    kitty::static_truth_table<NumVars> tt;
+    return value ? ~tt : tt;
+  }
+
+  kitty::static_truth_table<NumVars> compute_pi( uint32_t index ) const
+  {
+    kitty::static_truth_table<NumVars> tt;
+    kitty::create_random( tt, index );
+    return tt;
+  }
+
+  kitty::static_truth_table<NumVars> compute_not( kitty::static_truth_table<NumVars> const& value ) const
+  {
+    return ~value;
+  }
+};
+
+int main( int argc, char** argv )
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  uint32_t repetitions{5u};
+  double tolerance{0.1};
+  std::string version{use_github_revision};
+  std::string baseline;
+  std::vector<std::string> benchmarks;
+  for ( auto i = 1; i < argc; ++i )
+  {
+    std::string const arg = argv[i];
+    if ( arg == "--repetitions" && i + 1 < argc )
+    {
+      repetitions = std::max( 1, std::atoi( argv[++i] ) );
+    }
+    else if ( arg == "--tolerance" && i + 1 < argc )
+    {
+      tolerance = std::atof( argv[++i] );
+    }
+    else if ( arg == "--save" && i + 1 < argc )
+    {
+      version = argv[++i];
+    }
+    else if ( arg == "--baseline" && i + 1 < argc )
+    {
+      baseline = argv[++i];
+    }
+    else
+    {
+      benchmarks.push_back( arg );
+    }
+  }
+  if ( benchmarks.empty() )
+  {
+    benchmarks = epfl_benchmarks( experiments::sin | experiments::square | experiments::voter );
+  }
+
+  experiment<std::string, double, double, double> exp( "microbenchmarks", "operation", "ns/op", "nodes/s", "RSS (MB)" );
+
+  /* `fn` is called once per repetition and accumulates the time to measure in its argument */
+  auto const run = [&]( std::string const& operation, std::string const& benchmark, uint64_t num_ops, uint64_t num_nodes, auto&& fn ) {
+    double best = std::numeric_limits<double>::max();
+    reset_peak_rss();
+    for ( auto r = 0u; r < repetitions; ++r )
+    {
+      stopwatch<>::duration time{0};
+      fn( time );
+      best = std::min( best, to_seconds( time ) );
+    }
+    best = std::max( best, 1e-9 );
+
+    auto const ns_per_op = 1e9 * best / std::max<uint64_t>( num_ops, 1u );
+    auto const nodes_per_second = num_nodes / best;
+    auto const rss = peak_rss();
+    fmt::print( "[i] {:<28} {:>10.2f} ns/op {:>14.0f} nodes/s {:>8.1f} MB\n", operation, ns_per_op, nodes_per_second, rss );
+    exp( fmt::format( "{}/{}", operation, benchmark ), ns_per_op, nodes_per_second, rss );
+  };
+
+  std::vector<gate> gates;
+  std::istringstream in( library );
+  if ( lorina::read_genlib( in, genlib_reader( gates ) ) != lorina::return_code::success )
+  {
+    return 1;
+  }
+  tech_library tech_lib( gates );
+
+  /* library generation with supergates, mostly to track its peak memory */
+  run( "tech_library (supergates)", "library", 1u, 1u, [&]( auto& time ) {
+    tech_library_params ps;
+    ps.supergate_levels = 2u;
+    ps.supergate_inputs = 5u;
+    call_with_stopwatch( time, [&]() {
+      tech_library<5> lib( gates, ps );
+      sink = lib.num_supergates();
+    } );
+  } );
+
+  for ( auto const& benchmark : benchmarks )
+  {
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+    fmt::print( "[i] processing {} ({} gates)\n", benchmark, aig.num_gates() );
+    uint64_t const num_gates = aig.num_gates();
+
+    /* I/O */
+    run( "aiger_reader", benchmark, num_gates, num_gates, [&]( auto& time ) {
+      aig_network ntk;
+      call_with_stopwatch( time, [&]() {
+        return lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( ntk ) );
+      } );
+    } );
+
+    run( "write_aiger", benchmark, num_gates, num_gates, [&]( auto& time ) {
+      std::ostringstream os;
+      call_with_stopwatch( time, [&]() {
+        write_aiger( aig, os );
+      } );
+    } );
+
+    /* network construction: new nodes, then structural hashing hits */
+    auto const rebuild = [&]( aig_network& ntk, node_map<aig_network::signal, aig_network>& old_to_new ) {
+      aig.foreach_gate( [&]( auto const& n ) {
+        std::array<aig_network::signal, 2u> children;
+        aig.foreach_fanin( n, [&]( auto const& f, auto i ) {
+          children[i] = old_to_new[f] ^ aig.is_complemented( f );
+        } );
+        old_to_new[n] = ntk.create_and( children[0], children[1] );
+      } );
+    };
+
+    run( "create_and", benchmark, num_gates, num_gates, [&]( auto& time ) {
+      aig_network ntk;
+      node_map<aig_network::signal, aig_network> old_to_new( aig );
+      old_to_new[aig.get_constant( false )] = ntk.get_constant( false );
+      aig.foreach_pi( [&]( auto const& n ) {
+        old_to_new[n] = ntk.create_pi();
+      } );
+      call_with_stopwatch( time, [&]() {
+        rebuild( ntk, old_to_new );
+      } );
+    } );
+
+    run( "create_and (strash hit)", benchmark, num_gates, num_gates, [&]( auto& time ) {
+      aig_network ntk;
+      node_map<aig_network::signal, aig_network> old_to_new( aig );
+      old_to_new[aig.get_constant( false )] = ntk.get_constant( false );
+      aig.foreach_pi( [&]( auto const& n ) {
+        old_to_new[n] = ntk.create_pi();
+      } );
+      rebuild( ntk, old_to_new );
+      call_with_stopwatch( time, [&]() {
+        rebuild( ntk, old_to_new );
+      } );
+    } );
+
+    /* substitute every 16th gate by a new primary input */
+    run( "substitute_node", benchmark, num_gates / 16u, num_gates, [&]( auto& time ) {
+      auto ntk = cleanup_dangling( aig );
+      std::vector<aig_network::node> targets;
+      ntk.foreach_gate( [&]( auto const& n, auto i ) {
+        if ( i % 16u == 0u )
+        {
+          targets.push_back( n );
+        }
+      } );
+      call_with_stopwatch( time, [&]() {
+        for ( auto const& n : targets )
+        {
+          if ( !ntk.is_dead( n ) )
+          {
+            ntk.substitute_node( n, ntk.create_pi() );
+          }
+        }
+      } );
+    } );
+
+    /* traversal (repeated, since a single pass is too short to measure) */
+    uint32_t const passes{100u};
+    run( "foreach_fanin", benchmark, passes * 2u * num_gates, passes * num_gates, [&]( auto& time ) {
+      uint64_t sum{0u};
+      call_with_stopwatch( time, [&]() {
+        for ( auto p = 0u; p < passes; ++p )
+        {
+          aig.foreach_gate( [&]( auto const& n ) {
+            aig.foreach_fanin( n, [&]( auto const& f ) {
+              sum += aig.get_node( f );
+            } );
+          } );
+        }
+      } );
+      sink = sum;
+    } );
+
+    run( "node_map", benchmark, passes * 3u * num_gates, passes * num_gates, [&]( auto& time ) {
+      node_map<uint32_t, aig_network> levels( aig, 0u );
+      call_with_stopwatch( time, [&]() {
+        for ( auto p = 0u; p < passes; ++p )
+        {
+          aig.foreach_gate( [&]( auto const& n ) {
+            uint32_t level{0u};
+            aig.foreach_fanin( n, [&]( auto const& f ) {
+              level = std::max( level, levels[f] );
+            } );
+            levels[n] = level + 1u;
+          } );
+        }
+      } );
+      sink = levels[aig.index_to_node( aig.size() - 1u )];
+    } );
+
+    /* simulation */
+    run( "simulate_nodes (bool)", benchmark, num_gates, num_gates, [&]( auto& time ) {
+      std::vector<bool> assignments( aig.num_pis() );
+      std::mt19937 rng( 1u );
+      std::generate( assignments.begin(), assignments.end(), [&]() { return rng() & 1; } );
+      default_simulator<bool> sim( assignments );
+      call_with_stopwatch( time, [&]() {
+        simulate_nodes<bool>( aig, sim );
+      } );
+    } );
+
+    run( "simulate_nodes (static 8)", benchmark, num_gates, num_gates, [&]( auto& time ) {
+      random_static_simulator<8u> sim;
+      call_with_stopwatch( time, [&]() {
+        simulate_nodes<kitty::static_truth_table<8u>>( aig, sim );
+      } );
+    } );
+
+    run( "simulate_nodes (partial 1024)", benchmark, num_gates, num_gates, [&]( auto& time ) {
+      partial_simulator sim( aig.num_pis(), 1024u );
+      call_with_stopwatch( time, [&]() {
+        simulate_nodes<kitty::partial_truth_table>( aig, sim );
+      } );
+    } );
+
+    /* cut enumeration */
+    for ( auto k : {4u, 6u} )
+    {
+      run( fmt::format( "cut_enumeration (k = {})", k ), benchmark, aig.size(), num_gates, [&]( auto& time ) {
+        cut_enumeration_params ps;
+        ps.cut_size = k;
+        call_with_stopwatch( time, [&]() {
+          cut_enumeration( aig, ps );
+        } );
+      } );
+    }
+
+    /* technology mapping */
+    run( "map", benchmark, num_gates, num_gates, [&]( auto& time ) {
+      map_params ps;
+      map_stats st;
+      map( aig, tech_lib, ps, &st );
+      time += st.time_total;
+    } );
+  }
+
+  exp.save( version );
+  exp.table();
+  return exp.check_regressions( {"ns/op", "RSS (MB)"}, tolerance, baseline ) ? 0 : 1;
+}
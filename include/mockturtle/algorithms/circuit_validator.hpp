@@ -59,6 +59,12 @@ struct validator_params
 
   /*! \brief Seed for randomized solving. */
   uint32_t random_seed{0};
+
+  /*! \brief Keep one SAT solver and evict the least recently used encoded cones, instead of restarting the solver, when `max_clauses` is exceeded. (Not used with push/pop.) */
+  bool incremental{false};
+
+  /*! \brief Maximum number of deactivated clauses before the solver is restarted. (incremental mode) */
+  uint32_t max_retired_clauses{100000};
 };
 
 template<class Ntk, bill::solvers Solver = bill::solvers::glucose_41, bool use_pushpop = false, bool randomize = false, bool use_odc = false>
@@ -78,7 +84,7 @@ public:
   };
 
   explicit circuit_validator( Ntk const& ntk, validator_params const& ps = {} )
-      : ntk( ntk ), ps( ps ), literals( ntk ), constructed( ntk ), num_invoke( 0u ), cex( ntk.num_pis() )
+      : ntk( ntk ), ps( ps ), incremental( ps.incremental && !use_pushpop ), literals( ntk ), constructed( ntk ), num_invoke( 0u ), cone_ids( ntk ), cex( ntk.num_pis() )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
@@ -121,6 +127,7 @@ public:
     add_event = ntk.events().register_add_event( [&]( node const& n ) {
       (void)n;
       literals.resize();
+      cone_ids.resize();
     } );
 
     /* constants are mapped to var 0 */
@@ -152,30 +159,18 @@ public:
   /*! \brief Validate functional equivalence of signals `f` and `d`. */
   std::optional<bool> validate( signal const& f, signal const& d )
   {
-    if ( !constructed.has( d ) && !ntk.is_pi( ntk.get_node( d ) ) && !ntk.is_constant( ntk.get_node( d ) ) )
-    {
-      construct( ntk.get_node( d ) );
-    }
+    encode( ntk.get_node( d ) );
     auto const res = validate( ntk.get_node( f ), lit_not_cond( literals[d], ntk.is_complemented( f ) ^ ntk.is_complemented( d ) ) );
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    finish_query();
     return res;
   }
 
   /*! \brief Validate functional equivalence of node `root` and signal `d`. */
   std::optional<bool> validate( node const& root, signal const& d )
   {
-    if ( !constructed.has( d ) && !ntk.is_pi( ntk.get_node( d ) ) && !ntk.is_constant( ntk.get_node( d ) ) )
-    {
-      construct( ntk.get_node( d ) );
-    }
+    encode( ntk.get_node( d ) );
     auto const res = validate( root, lit_not_cond( literals[d], ntk.is_complemented( d ) ) );
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    finish_query();
     return res;
   }
 
@@ -213,20 +208,14 @@ public:
     assert( uint64_t( std::distance( divs_begin, divs_end ) ) == id_list.num_pis() && "Size of the provided divisor list does not match number of PIs of the index list" );
     assert( id_list.num_pos() == 1u && "Index list must have exactly one PO" );
 
-    if ( !constructed.has( root ) && !ntk.is_pi( root ) && !ntk.is_constant( root ) )
-    {
-      construct( root );
-    }
+    encode( root );
 
     std::vector<bill::lit_type> lits;
     lits.reserve( id_list.num_pis() + id_list.num_gates() + 1 );
     lits.emplace_back( literals[ntk.get_constant( false )] );
     for ( auto it = divs_begin; it != divs_end; ++it )
     {
-      if ( !constructed.has( *it ) && !ntk.is_pi( *it ) && !ntk.is_constant( *it ) )
-      {
-        construct( *it );
-      }
+      encode( *it );
       lits.emplace_back( literals[*it] );
     }
 
@@ -270,10 +259,7 @@ public:
       pop();
     }
 
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    finish_query();
 
     return res;
   }
@@ -287,10 +273,7 @@ public:
   /*! \brief Validate whether node `root` is a constant of `value`. */
   std::optional<bool> validate( node const& root, bool value )
   {
-    if ( !constructed.has( root ) && !ntk.is_pi( root ) && !ntk.is_constant( root ) )
-    {
-      construct( root );
-    }
+    encode( root );
 
     std::optional<bool> res;
     if constexpr ( use_odc )
@@ -317,10 +300,7 @@ public:
       res = solve( {lit_not_cond( literals[root], value )} );
     }
 
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    finish_query();
     return res;
   }
 
@@ -345,10 +325,7 @@ public:
   template<bool enabled = use_pushpop, typename = std::enable_if_t<enabled>>
   std::vector<std::vector<bool>> generate_pattern( node const& root, bool value, std::vector<std::vector<bool>> const& block_patterns = {}, uint32_t num_patterns = 1u )
   {
-    if ( !constructed.has( root ) && !ntk.is_pi( root ) && !ntk.is_constant( root ) )
-    {
-      construct( root );
-    }
+    encode( root );
 
     push();
 
@@ -384,10 +361,7 @@ public:
     }
 
     pop();
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    finish_query();
     return generated;
   }
 
@@ -413,10 +387,73 @@ private:
 
     constructed.reset();
 
+    cones.clear();
+    live_cones.clear();
+    num_live_clauses = 0u;
+    num_query_clauses = 0u;
+    num_retired_clauses = 0u;
+    query_activation.reset();
+    query_literals.clear();
+    free_literals.clear();
+
     solver.add_variables( ntk.num_pis() + 1 );
     solver.add_clause( {~literals[ntk.get_constant( false )]} );
   }
 
+  void finish_query()
+  {
+    if ( !incremental )
+    {
+      if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
+      {
+        restart();
+      }
+      return;
+    }
+
+    /* the clauses of finished queries are satisfiable by any assignment of
+       the encoded nodes, hence they are deactivated after each query */
+    if ( query_activation )
+    {
+      solver.add_clause( ~*query_activation );
+      free_literals.insert( free_literals.end(), query_literals.begin(), query_literals.end() );
+      num_retired_clauses += num_query_clauses;
+      num_query_clauses = 0u;
+      query_activation.reset();
+      query_literals.clear();
+    }
+    ++num_queries;
+
+    while ( num_live_clauses > ps.max_clauses && live_cones.size() > 1u )
+    {
+      evict_cone( *std::min_element( live_cones.begin(), live_cones.end(), [&]( auto const& a, auto const& b ) {
+        return cones[a].last_use < cones[b].last_use;
+      } ) );
+    }
+
+    if ( num_retired_clauses > ps.max_retired_clauses )
+    {
+      restart();
+    }
+  }
+
+  void encode( node const& n )
+  {
+    if ( ntk.is_pi( n ) || ntk.is_constant( n ) )
+    {
+      return;
+    }
+
+    if ( !constructed.has( n ) )
+    {
+      construct( n );
+    }
+    else if ( incremental )
+    {
+      touch_cone( cone_ids[n] );
+    }
+  }
+
   bill::lit_type construct( node const& n )
   {
     assert( !constructed.has( n ) && !ntk.is_pi( n ) && !ntk.is_constant( n ) );
@@ -430,37 +467,38 @@ private:
 
     std::vector<bill::lit_type> child_lits;
     ntk.foreach_fanin( n, [&]( auto const& f ) {
-      if ( !constructed.has( f ) && !ntk.is_pi( ntk.get_node( f ) ) && !ntk.is_constant( ntk.get_node( f ) ) )
-      {
-        construct( ntk.get_node( f ) );
-      }
+      encode( ntk.get_node( f ) );
       child_lits.push_back( lit_not_cond( literals[f], ntk.is_complemented( f ) ) );
     } );
-    bill::lit_type node_lit = literals[n] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+    bill::lit_type node_lit = literals[n] = add_literal();
     constructed[n] = true;
+    if ( incremental )
+    {
+      add_to_cone( n );
+    }
 
     if ( ntk.is_and( n ) )
     {
       detail::on_and<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], [&]( auto const& clause ) {
-        solver.add_clause( clause );
+        add_node_clause( n, clause );
       } );
     }
     else if ( ntk.is_xor( n ) )
     {
       detail::on_xor<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], [&]( auto const& clause ) {
-        solver.add_clause( clause );
+        add_node_clause( n, clause );
       } );
     }
     else if ( ntk.is_xor3( n ) )
     {
       detail::on_xor3<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], child_lits[2], [&]( auto const& clause ) {
-        solver.add_clause( clause );
+        add_node_clause( n, clause );
       } );
     }
     else if ( ntk.is_maj( n ) )
     {
       detail::on_maj<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], child_lits[2], [&]( auto const& clause ) {
-        solver.add_clause( clause );
+        add_node_clause( n, clause );
       } );
     }
     return node_lit;
@@ -483,21 +521,155 @@ private:
     between_push_pop = false;
   }
 
+#pragma region Incremental mode
+  /* Each encoded node belongs to a cone, i.e., a group of nodes encoded by
+   * consecutive queries, whose clauses are guarded by an activation literal.
+   * A cone depends on the cones of the fanins of its nodes.  Evicting a cone
+   * deactivates its clauses and the ones of its dependent cones, and the
+   * evicted nodes are encoded again when needed.  Clauses added by queries
+   * only define fresh variables and are satisfiable whatever the values of
+   * the encoded nodes, hence the variables of evicted nodes and of retired
+   * queries are reused. */
+  void add_to_cone( node const& n )
+  {
+    if ( live_cones.empty() || live_cones.back() != cones.size() - 1u || cones.back().last_use != num_queries )
+    {
+      auto& cone = cones.emplace_back();
+      cone.activation = add_literal();
+      cone.last_use = num_queries;
+      live_cones.emplace_back( cones.size() - 1u );
+    }
+
+    auto const id = static_cast<uint32_t>( cones.size() - 1u );
+    cone_ids[n] = id;
+    cones[id].nodes.emplace_back( n );
+    touch_cone( id );
+
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      auto const fn = ntk.get_node( f );
+      if ( ntk.is_pi( fn ) || ntk.is_constant( fn ) || cone_ids[fn] == id )
+      {
+        return;
+      }
+
+      auto& fanin_cones = cones[id].fanin_cones;
+      if ( std::find( fanin_cones.begin(), fanin_cones.end(), cone_ids[fn] ) == fanin_cones.end() )
+      {
+        fanin_cones.emplace_back( cone_ids[fn] );
+        cones[cone_ids[fn]].fanout_cones.emplace_back( id );
+      }
+    } );
+  }
+
+  /* a cone is at least as recently used as the cones depending on it */
+  void touch_cone( uint32_t id )
+  {
+    if ( cones[id].last_use == num_queries )
+    {
+      return;
+    }
+
+    cones[id].last_use = num_queries;
+    for ( auto const& c : cones[id].fanin_cones )
+    {
+      touch_cone( c );
+    }
+  }
+
+  void evict_cone( uint32_t id )
+  {
+    auto& cone = cones[id];
+    if ( !cone.alive )
+    {
+      return;
+    }
+    cone.alive = false;
+
+    solver.add_clause( ~cone.activation );
+    for ( auto const& n : cone.nodes )
+    {
+      free_literals.emplace_back( literals[n] );
+      constructed.erase( n );
+    }
+    num_live_clauses -= cone.num_clauses;
+    num_retired_clauses += cone.num_clauses;
+    live_cones.erase( std::find( live_cones.begin(), live_cones.end(), id ) );
+
+    std::vector<uint32_t> fanout_cones;
+    std::swap( fanout_cones, cone.fanout_cones );
+    cone.nodes = {};
+    cone.fanin_cones = {};
+    for ( auto const& c : fanout_cones )
+    {
+      evict_cone( c );
+    }
+  }
+
+  void add_node_clause( node const& n, std::vector<bill::lit_type> clause )
+  {
+    if ( incremental )
+    {
+      auto& cone = cones[cone_ids[n]];
+      clause.emplace_back( ~cone.activation );
+      ++cone.num_clauses;
+      ++num_live_clauses;
+    }
+    solver.add_clause( clause );
+  }
+
+  /* clauses and variables that are only needed by the current query */
+  void add_query_clause( std::vector<bill::lit_type> clause )
+  {
+    if ( incremental )
+    {
+      if ( !query_activation )
+      {
+        query_activation = add_literal();
+      }
+      clause.emplace_back( ~*query_activation );
+      ++num_query_clauses;
+    }
+    solver.add_clause( clause );
+  }
+
+  bill::lit_type add_query_literal()
+  {
+    auto const lit = add_literal();
+    if ( incremental )
+    {
+      query_literals.emplace_back( lit );
+    }
+    return lit;
+  }
+
+  bill::lit_type add_literal()
+  {
+    if ( !free_literals.empty() )
+    {
+      auto const lit = free_literals.back();
+      free_literals.pop_back();
+      return lit;
+    }
+    return bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+  }
+
+#pragma endregion
+
   bill::lit_type add_clauses_for_2input_gate( bill::lit_type a, bill::lit_type b, std::optional<bill::lit_type> c = std::nullopt, gate_type type = AND )
   {
     assert( type == AND || type == XOR );
 
-    auto nlit = c ? *c : bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+    auto nlit = c ? *c : add_query_literal();
     if ( type == AND )
     {
       detail::on_and<add_clause_fn_t>( nlit, a, b, [&]( auto const& clause ) {
-        solver.add_clause( clause );
+        add_query_clause( clause );
       } );
     }
     else if ( type == XOR )
     {
       detail::on_xor<add_clause_fn_t>( nlit, a, b, [&]( auto const& clause ) {
-        solver.add_clause( clause );
+        add_query_clause( clause );
       } );
     }
 
@@ -508,17 +680,17 @@ private:
   {
     assert( type == MAJ || type == XOR );
 
-    auto nlit = d ? *d : bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+    auto nlit = d ? *d : add_query_literal();
     if ( type == MAJ )
     {
       detail::on_maj<add_clause_fn_t>( nlit, a, b, c, [&]( auto const& clause ) {
-        solver.add_clause( clause );
+        add_query_clause( clause );
       } );
     }
     else if ( type == XOR )
     {
       detail::on_xor3<add_clause_fn_t>( nlit, a, b, c, [&]( auto const& clause ) {
-        solver.add_clause( clause );
+        add_query_clause( clause );
       } );
     }
 
@@ -528,6 +700,19 @@ private:
   std::optional<bool> solve( std::vector<bill::lit_type> assumptions )
   {
     ++num_invoke;
+    if ( incremental )
+    {
+      /* only the cones of the current query are activated */
+      for ( auto const& c : live_cones )
+      {
+        assumptions.emplace_back( lit_not_cond( cones[c].activation, cones[c].last_use != num_queries ) );
+      }
+      if ( query_activation )
+      {
+        assumptions.emplace_back( *query_activation );
+      }
+    }
+
     auto const res = solver.solve( assumptions, ps.conflict_limit );
 
     if ( res == bill::result::states::satisfiable )
@@ -548,10 +733,7 @@ private:
 
   std::optional<bool> validate( node const& root, bill::lit_type const& lit )
   {
-    if ( !constructed.has( root ) && !ntk.is_pi( root ) && !ntk.is_constant( root ) )
-    {
-      construct( root );
-    }
+    encode( root );
 
     std::optional<bool> res;
     if constexpr ( use_odc )
@@ -570,17 +752,17 @@ private:
       }
       else
       {
-        auto nlit = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
-        solver.add_clause( {literals[root], lit, nlit} );
-        solver.add_clause( {~( literals[root] ), ~lit, nlit} );
+        auto nlit = add_query_literal();
+        add_query_clause( {literals[root], lit, nlit} );
+        add_query_clause( {~( literals[root] ), ~lit, nlit} );
         res = solve( {~nlit} );
       }
     }
     else
     {
-      auto nlit = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
-      solver.add_clause( {literals[root], lit, nlit} );
-      solver.add_clause( {~( literals[root] ), ~lit, nlit} );
+      auto nlit = add_query_literal();
+      add_query_clause( {literals[root], lit, nlit} );
+      add_query_clause( {~( literals[root] ), ~lit, nlit} );
       res = solve( {~nlit} );
     }
 
@@ -621,9 +803,9 @@ private:
     } );
 
     assert( miter.size() > 0 && "max fanout depth < odc_levels (-1 is infinity) and there is no PO in TFO cone" );
-    auto nlit2 = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+    auto nlit2 = add_query_literal();
     miter.emplace_back( nlit2 );
-    solver.add_clause( miter );
+    add_query_clause( miter );
     return ~nlit2;
   }
 
@@ -637,10 +819,7 @@ private:
 
       std::vector<bill::lit_type> l_fi;
       ntk.foreach_fanin( fo, [&]( auto const& fi ) {
-        if ( !constructed.has( fi ) && !ntk.is_pi( ntk.get_node( fi ) ) && !ntk.is_constant( ntk.get_node( fi ) ) )
-        {
-          construct( ntk.get_node( fi ) );
-        }
+        encode( ntk.get_node( fi ) );
         l_fi.emplace_back( lit_not_cond( lits.has( ntk.get_node( fi ) ) ? lits[fi] : literals[fi], ntk.is_complemented( fi ) ) );
       } );
       if ( l_fi.size() == 2u )
@@ -671,12 +850,9 @@ private:
         return true; /* skip */
       ntk.set_visited( fo, ntk.trav_id() );
 
-      if ( !constructed.has( fo ) )
-      {
-        construct( fo );
-      }
+      encode( fo );
 
-      lits[fo] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+      lits[fo] = add_query_literal();
 
       if ( level == ps.odc_levels )
       {
@@ -697,9 +873,21 @@ private:
   }
 
 private:
+  struct encoded_cone
+  {
+    bill::lit_type activation;
+    std::vector<node> nodes;
+    std::vector<uint32_t> fanin_cones;
+    std::vector<uint32_t> fanout_cones;
+    uint32_t num_clauses{0u};
+    uint64_t last_use{0u};
+    bool alive{true};
+  };
+
   Ntk const& ntk;
 
   validator_params ps;
+  bool const incremental;
 
   node_map<bill::lit_type, Ntk> literals;
   unordered_node_map<bool, Ntk> constructed;
@@ -711,6 +899,17 @@ private:
   bool between_push_pop = false;
   std::vector<node> tmp;
 
+  node_map<uint32_t, Ntk> cone_ids;
+  std::vector<encoded_cone> cones;
+  std::vector<uint32_t> live_cones;
+  uint32_t num_live_clauses{0u};
+  uint32_t num_query_clauses{0u};
+  uint32_t num_retired_clauses{0u};
+  uint64_t num_queries{0u};
+  std::optional<bill::lit_type> query_activation;
+  std::vector<bill::lit_type> query_literals;
+  std::vector<bill::lit_type> free_literals;
+
   std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
 
 public:
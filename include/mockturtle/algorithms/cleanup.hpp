@@ -33,19 +33,98 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <kitty/operations.hpp>
 
 #include "../traits.hpp"
 #include "../utils/node_map.hpp"
-#include "../views/topo_view.hpp"
 
 namespace mockturtle
 {
 
+namespace detail
+{
+
+/* returns the constants, the CIs, and the transitive fan-in of the outputs in
+ * the same topological order as `topo_view`, but without recursion, such that
+ * deep networks do not overflow the stack */
+template<class Ntk>
+std::vector<node<Ntk>> cleanup_topological_order( Ntk const& ntk )
+{
+  std::vector<node<Ntk>> order;
+  order.reserve( ntk.size() );
+
+  if constexpr ( is_topologically_sorted_v<Ntk> )
+  {
+    ntk.foreach_node( [&]( auto const& n ) {
+      order.push_back( n );
+    } );
+    return order;
+  }
+
+  ntk.incr_trav_id();
+  auto const mark = [&]( auto const& n ) {
+    if ( ntk.visited( n ) != ntk.trav_id() )
+    {
+      order.push_back( n );
+      ntk.set_visited( n, ntk.trav_id() );
+    }
+  };
+
+  /* constants and CIs */
+  mark( ntk.get_node( ntk.get_constant( false ) ) );
+  mark( ntk.get_node( ntk.get_constant( true ) ) );
+  ntk.foreach_ci( mark );
+
+  /* post-order DFS from the POs and then the RIs (instead of `foreach_co`,
+   * which a `topo_view` on a single output does not restrict); an entry
+   * (n, true) is pushed below the fanins of n and emits n after all of them */
+  std::vector<std::pair<node<Ntk>, bool>> stack;
+  const auto visit = [&]( auto const& f ) {
+    stack.emplace_back( ntk.get_node( f ), false );
+    while ( !stack.empty() )
+    {
+      auto const [n, expanded] = stack.back();
+      stack.pop_back();
+      if ( ntk.visited( n ) == ntk.trav_id() )
+      {
+        continue;
+      }
+      if ( expanded )
+      {
+        ntk.set_visited( n, ntk.trav_id() );
+        order.push_back( n );
+        continue;
+      }
+
+      stack.emplace_back( n, true );
+      auto const first = stack.size();
+      ntk.foreach_fanin( n, [&]( auto const& fi ) {
+        if ( ntk.visited( ntk.get_node( fi ) ) != ntk.trav_id() )
+        {
+          stack.emplace_back( ntk.get_node( fi ), false );
+        }
+      } );
+      std::reverse( stack.begin() + first, stack.end() );
+    }
+  };
+  ntk.foreach_po( visit );
+  if constexpr ( has_foreach_ri_v<Ntk> )
+  {
+    ntk.foreach_ri( visit );
+  }
+
+  return order;
+}
+
+} // namespace detail
+
 template<typename NtkSource, typename NtkDest, typename LeavesIterator>
 std::vector<signal<NtkDest>> cleanup_dangling( NtkSource const& ntk, NtkDest& dest, LeavesIterator begin, LeavesIterator end )
 {
@@ -66,6 +145,11 @@ std::vector<signal<NtkDest>> cleanup_dangling( NtkSource const& ntk, NtkDest& de
   static_assert( has_create_not_v<NtkDest>, "NtkDest does not implement the create_not method" );
   static_assert( has_clone_node_v<NtkDest>, "NtkDest does not implement the clone_node method" );
 
+  if constexpr ( has_reserve_v<NtkDest> && has_size_v<NtkDest> )
+  {
+    dest.reserve( dest.size() + ntk.size() );
+  }
+
   node_map<signal<NtkDest>, NtkSource> old_to_new( ntk );
   old_to_new[ntk.get_constant( false )] = dest.get_constant( false );
 
@@ -82,13 +166,14 @@ std::vector<signal<NtkDest>> cleanup_dangling( NtkSource const& ntk, NtkDest& de
   assert( it == end );
 
   /* foreach node in topological order */
-  topo_view topo{ntk};
-  topo.foreach_node( [&]( auto node ) {
+  std::vector<signal<NtkDest>> children;
+  for ( auto const& node : detail::cleanup_topological_order( ntk ) )
+  {
     if ( ntk.is_constant( node ) || ntk.is_pi( node ) )
-      return;
+      continue;
 
     /* collect children */
-    std::vector<signal<NtkDest>> children;
+    children.clear();
     ntk.foreach_fanin( node, [&]( auto child, auto ) {
       const auto f = old_to_new[child];
       if ( ntk.is_complemented( child ) )
@@ -198,10 +283,11 @@ std::vector<signal<NtkDest>> cleanup_dangling( NtkSource const& ntk, NtkDest& de
         std::cerr << "[e] something went wrong, could not copy node " << ntk.node_to_index( node ) << "\n";
       } while ( false );
     }
-  } );
+  }
 
   /* create outputs in same order */
   std::vector<signal<NtkDest>> fs;
+  fs.reserve( ntk.num_pos() );
   ntk.foreach_po( [&]( auto po ) {
     const auto f = old_to_new[po];
     if ( ntk.is_complemented( po ) )
@@ -266,6 +352,7 @@ NtkDest cleanup_dangling( NtkSrc const& ntk )
 
   NtkDest dest;
   std::vector<signal<NtkDest>> pis;
+  pis.reserve( ntk.num_pis() );
   ntk.foreach_pi( [&]( auto ) {
     pis.push_back( dest.create_pi() );
   } );
@@ -330,6 +417,10 @@ Ntk cleanup_luts( Ntk const& ntk )
   static_assert( has_node_function_v<Ntk>, "Ntk does not implement the node_function method" );
 
   Ntk dest;
+  if constexpr ( has_reserve_v<Ntk> )
+  {
+    dest.reserve( ntk.size() );
+  }
   node_map<signal<Ntk>, Ntk> old_to_new( ntk );
 
   // PIs and constants
@@ -343,9 +434,10 @@ Ntk cleanup_luts( Ntk const& ntk )
   }
 
   // iterate through nodes
-  topo_view topo{ntk};
-  topo.foreach_node( [&]( auto const& n ) {
-    if ( ntk.is_constant( n ) || ntk.is_pi( n ) ) return true; /* continue */
+  std::vector<signal<Ntk>> children;
+  for ( auto const& n : detail::cleanup_topological_order( ntk ) )
+  {
+    if ( ntk.is_constant( n ) || ntk.is_pi( n ) ) continue;
 
     auto func = ntk.node_function( n );
 
@@ -368,7 +460,7 @@ Ntk cleanup_luts( Ntk const& ntk )
     const auto support = kitty::min_base_inplace( func );
     auto new_func = kitty::shrink_to( func, static_cast<unsigned int>( support.size() ) );
 
-    std::vector<signal<Ntk>> children;
+    children.clear();
     if ( auto var = support.begin(); var != support.end() )
     {
       ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
@@ -397,9 +489,7 @@ Ntk cleanup_luts( Ntk const& ntk )
     {
       old_to_new[n] = dest.create_node( children, new_func );
     }
-
-    return true;
-  } );
+  }
 
   // POs
   ntk.foreach_po( [&]( auto const& f ) {
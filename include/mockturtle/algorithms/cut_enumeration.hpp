@@ -35,11 +35,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <iostream>
+#include <memory>
 #include <optional>
+#include <thread>
 #include <vector>
 
 #include <kitty/constructors.hpp>
@@ -75,6 +79,24 @@ struct cut_enumeration_params
   /*! \brief Prune cuts by removing don't cares. */
   bool minimize_truth_table{false};
 
+  /*! \brief Number of threads.
+   *
+   * If larger than 1, nodes are grouped by logic level and the nodes of one
+   * level are processed in parallel, as they only depend on the cut sets of
+   * lower levels.  The network must support concurrent calls to its const
+   * methods.
+   */
+  uint32_t num_threads{1u};
+
+  /*! \brief Truth table cache for the cut functions.
+   *
+   * If set, the truth tables of cuts are interned in this cache instead of
+   * in a new one.  This allows, e.g., to share the cache of a k-LUT network
+   * (`klut_network::function_cache`) with the cut enumeration from which the
+   * network is derived.  Only used by `cut_enumeration`.
+   */
+  std::shared_ptr<truth_table_cache<kitty::dynamic_truth_table>> truth_tables;
+
   /*! \brief Be verbose. */
   bool verbose{false};
 
@@ -87,7 +109,7 @@ struct cut_enumeration_stats
   /*! \brief Total time. */
   stopwatch<>::duration time_total{0};
 
-  /*! \brief Time for truth table computation. */
+  /*! \brief Time for truth table computation (summed over all threads). */
   stopwatch<>::duration time_truth_table{0};
 
   /*! \brief Prints report. */
@@ -167,13 +189,15 @@ public:
   static constexpr bool compute_truth = ComputeTruth;
 
 private:
-  explicit network_cuts( uint32_t size ) : _cuts( size )
+  explicit network_cuts( uint32_t size, std::shared_ptr<truth_table_cache<kitty::dynamic_truth_table>> truth_tables = nullptr )
+      : _cuts( size ),
+        _truth_tables( truth_tables ? truth_tables : std::make_shared<truth_table_cache<kitty::dynamic_truth_table>>() )
   {
     kitty::dynamic_truth_table zero( 0u ), proj( 1u );
     kitty::create_nth_var( proj, 0u );
 
-    _truth_tables.insert( zero );
-    _truth_tables.insert( proj );
+    _zero_func = _truth_tables->insert( zero );
+    _unit_func = _truth_tables->insert( proj );
   }
 
 public:
@@ -187,7 +211,7 @@ public:
   template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
   auto truth_table( cut_t const& cut ) const
   {
-    return _truth_tables[cut->func_id];
+    return lookup_truth_table( cut->func_id );
   }
 
   /*! \brief Returns the total number of tuples that were tried to be merged */
@@ -239,7 +263,7 @@ public:
    */
   uint32_t insert_truth_table( kitty::dynamic_truth_table const& tt )
   {
-    return _truth_tables.insert( tt );
+    return _truth_tables->insert( tt );
   }
 
 private:
@@ -256,7 +280,7 @@ private:
 
     if constexpr ( ComputeTruth )
     {
-      cut->func_id = 0;
+      cut->func_id = _zero_func;
     }
   }
 
@@ -266,16 +290,23 @@ private:
 
     if constexpr ( ComputeTruth )
     {
-      cut->func_id = 2;
+      cut->func_id = _unit_func;
     }
   }
 
+  auto lookup_truth_table( uint32_t func_id ) const
+  {
+    return ( *_truth_tables )[func_id];
+  }
+
 private:
   /* compressed representation of cuts */
   std::vector<cut_set_t> _cuts;
 
-  /* cut truth tables */
-  truth_table_cache<kitty::dynamic_truth_table> _truth_tables;
+  /* cut truth tables (supports concurrent inserts) */
+  std::shared_ptr<truth_table_cache<kitty::dynamic_truth_table>> _truth_tables;
+  uint32_t _zero_func{0};
+  uint32_t _unit_func{2};
 
   /* statistics */
   uint32_t _total_tuples{};
@@ -286,12 +317,101 @@ private:
 namespace detail
 {
 
+/* per-thread state of cut enumeration */
+template<typename CutSet, uint32_t NumLeafSets>
+struct cut_enumeration_worker
+{
+  std::array<CutSet*, NumLeafSets> lcuts;
+  uint32_t total_tuples{};
+  std::size_t total_cuts{};
+  stopwatch<>::duration time_truth_table{0};
+};
+
+/* Groups the nodes of a network by logic level (constants and PIs are on
+ * level 0).  Nodes in the same group do not depend on each other. */
+template<typename Ntk>
+std::vector<std::vector<node<Ntk>>> nodes_by_level( Ntk const& ntk )
+{
+  std::vector<uint32_t> levels( ntk.size(), 0u );
+  std::vector<std::vector<node<Ntk>>> nodes;
+  ntk.foreach_node( [&]( auto const& n ) {
+    uint32_t level{0u};
+    if ( !ntk.is_constant( n ) && !ntk.is_pi( n ) )
+    {
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        level = std::max( level, levels[ntk.node_to_index( ntk.get_node( f ) )] + 1u );
+      } );
+    }
+    levels[ntk.node_to_index( n )] = level;
+    if ( level >= nodes.size() )
+    {
+      nodes.resize( level + 1u );
+    }
+    nodes[level].push_back( n );
+  } );
+  return nodes;
+}
+
+/* Calls `fn( node, thread_id )` for all nodes in `levels`, level by level.
+ * The nodes of one level are distributed over `num_threads` threads in
+ * small chunks; small levels are processed by the calling thread. */
+template<typename Node, typename Fn>
+void foreach_node_level_parallel( std::vector<std::vector<Node>> const& levels, uint32_t num_threads, Fn&& fn )
+{
+  constexpr std::size_t chunk_size = 32u;
+
+  std::vector<std::thread> threads;
+  for ( auto const& nodes : levels )
+  {
+    if ( num_threads < 2u || nodes.size() < 2u * chunk_size )
+    {
+      for ( auto const& n : nodes )
+      {
+        fn( n, 0u );
+      }
+      continue;
+    }
+
+    std::atomic<std::size_t> next{0u};
+    auto const work = [&]( uint32_t thread_id ) {
+      for ( auto begin = next.fetch_add( chunk_size ); begin < nodes.size(); begin = next.fetch_add( chunk_size ) )
+      {
+        auto const end = std::min( begin + chunk_size, nodes.size() );
+        for ( auto i = begin; i < end; ++i )
+        {
+          fn( nodes[i], thread_id );
+        }
+      }
+    };
+
+    auto const num_workers = static_cast<uint32_t>( std::min<std::size_t>( num_threads, ( nodes.size() + chunk_size - 1u ) / chunk_size ) );
+    for ( auto i = 1u; i < num_workers; ++i )
+    {
+      threads.emplace_back( work, i );
+    }
+    work( 0u );
+    for ( auto& t : threads )
+    {
+      t.join();
+    }
+    threads.clear();
+  }
+}
+
+/* Calls `fn( node, thread_id )` for all nodes of `ntk`, level by level. */
+template<typename Ntk, typename Fn>
+void foreach_node_level_parallel( Ntk const& ntk, uint32_t num_threads, Fn&& fn )
+{
+  foreach_node_level_parallel( nodes_by_level( ntk ), num_threads, fn );
+}
+
 template<typename Ntk, bool ComputeTruth, typename CutData>
 class cut_enumeration_impl
 {
 public:
   using cut_t = typename network_cuts<Ntk, ComputeTruth, CutData>::cut_t;
   using cut_set_t = typename network_cuts<Ntk, ComputeTruth, CutData>::cut_set_t;
+  using worker_t = cut_enumeration_worker<cut_set_t, Ntk::max_fanin_size + 1>;
 
   explicit cut_enumeration_impl( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats& st, network_cuts<Ntk, ComputeTruth, CutData>& cuts )
       : ntk( ntk ),
@@ -307,46 +427,70 @@ public:
   {
     stopwatch t( st.time_total );
 
-    ntk.foreach_node( [this]( auto node ) {
-      const auto index = ntk.node_to_index( node );
+    if ( ps.num_threads > 1u )
+    {
+      workers.resize( ps.num_threads );
+      foreach_node_level_parallel( ntk, ps.num_threads, [this]( auto node, auto thread_id ) {
+        compute_cuts( node, workers[thread_id] );
+      } );
+    }
+    else
+    {
+      workers.resize( 1u );
+      ntk.foreach_node( [this]( auto node ) {
+        compute_cuts( node, workers[0u] );
+      } );
+    }
 
-      if ( ps.very_verbose )
-      {
-        std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
-      }
+    for ( auto const& w : workers )
+    {
+      cuts._total_tuples += w.total_tuples;
+      cuts._total_cuts += w.total_cuts;
+      st.time_truth_table += w.time_truth_table;
+    }
+  }
 
-      if ( ntk.is_constant( node ) )
-      {
-        cuts.add_zero_cut( index );
-      }
-      else if ( ntk.is_pi( node ) )
+private:
+  void compute_cuts( node<Ntk> const& node, worker_t& w )
+  {
+    const auto index = ntk.node_to_index( node );
+
+    if ( ps.very_verbose )
+    {
+      std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
+    }
+
+    if ( ntk.is_constant( node ) )
+    {
+      cuts.add_zero_cut( index );
+    }
+    else if ( ntk.is_pi( node ) )
+    {
+      cuts.add_unit_cut( index );
+    }
+    else
+    {
+      if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
       {
-        cuts.add_unit_cut( index );
+        merge_cuts2( index, w );
       }
       else
       {
-        if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
-        {
-          merge_cuts2( index );
-        }
-        else
-        {
-          merge_cuts( index );
-        }
+        merge_cuts( index, w );
       }
-    } );
+    }
   }
 
 private:
-  uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res )
+  uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res, worker_t& w )
   {
-    stopwatch t( st.time_truth_table );
+    stopwatch t( w.time_truth_table );
 
     std::vector<kitty::dynamic_truth_table> tt( vcuts.size() );
     auto i = 0;
     for ( auto const& cut : vcuts )
     {
-      tt[i] = kitty::extend_to( cuts._truth_tables[( *cut )->func_id], res.size() );
+      tt[i] = kitty::extend_to( cuts.lookup_truth_table( ( *cut )->func_id ), res.size() );
       const auto supp = cuts.compute_truth_table_support( *cut, res );
       kitty::expand_inplace( tt[i], supp );
       ++i;
@@ -370,19 +514,20 @@ private:
           *it_leaves++ = leaves_before[*it_support++];
         }
         res.set_leaves( leaves_after.begin(), leaves_after.end() );
-        return cuts._truth_tables.insert( tt_res_shrink );
+        return cuts.insert_truth_table( tt_res_shrink );
       }
     }
 
-    return cuts._truth_tables.insert( tt_res );
+    return cuts.insert_truth_table( tt_res );
   }
 
-  void merge_cuts2( uint32_t index )
+  void merge_cuts2( uint32_t index, worker_t& w )
   {
     const auto fanin = 2;
+    auto& lcuts = w.lcuts;
 
     uint32_t pairs{1};
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs]( auto child, auto i ) {
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &lcuts, &pairs]( auto child, auto i ) {
       lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
       pairs *= static_cast<uint32_t>( lcuts[i]->size() );
     } );
@@ -394,7 +539,7 @@ private:
 
     std::vector<cut_t const*> vcuts( fanin );
 
-    cuts._total_tuples += pairs;
+    w.total_tuples += pairs;
     for ( auto const& c1 : *lcuts[0] )
     {
       for ( auto const& c2 : *lcuts[1] )
@@ -413,7 +558,7 @@ private:
         {
           vcuts[0] = c1;
           vcuts[1] = c2;
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut, w );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, index );
@@ -425,7 +570,7 @@ private:
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_limit - 1 );
 
-    cuts._total_cuts += rcuts.size();
+    w.total_cuts += rcuts.size();
 
     if ( rcuts.size() > 1 || ( *rcuts.begin() )->size() > 1 )
     {
@@ -433,11 +578,12 @@ private:
     }
   }
 
-  void merge_cuts( uint32_t index )
+  void merge_cuts( uint32_t index, worker_t& w )
   {
+    auto& lcuts = w.lcuts;
     uint32_t pairs{1};
     std::vector<uint32_t> cut_sizes;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes]( auto child, auto i ) {
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &lcuts, &pairs, &cut_sizes]( auto child, auto i ) {
       lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
       cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
       pairs *= cut_sizes.back();
@@ -456,7 +602,7 @@ private:
 
       std::vector<cut_t const*> vcuts( fanin );
 
-      cuts._total_tuples += pairs;
+      w.total_tuples += pairs;
       foreach_mixed_radix_tuple( cut_sizes.begin(), cut_sizes.end(), [&]( auto begin, auto end ) {
         auto it = vcuts.begin();
         auto i = 0u;
@@ -486,7 +632,7 @@ private:
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut, w );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -506,7 +652,7 @@ private:
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, {cut}, new_cut );
+          new_cut->func_id = compute_truth_table( index, {cut}, new_cut, w );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -518,7 +664,7 @@ private:
       rcuts.limit( ps.cut_limit - 1 );
     }
 
-    cuts._total_cuts += static_cast<uint32_t>( rcuts.size() );
+    w.total_cuts += static_cast<uint32_t>( rcuts.size() );
 
     cuts.add_unit_cut( index );
   }
@@ -529,7 +675,7 @@ private:
   cut_enumeration_stats& st;
   network_cuts<Ntk, ComputeTruth, CutData>& cuts;
 
-  std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
+  std::vector<worker_t> workers;
 };
 } /* namespace detail */
 /*! \endcond */
@@ -594,7 +740,7 @@ network_cuts<Ntk, ComputeTruth, CutData> cut_enumeration( Ntk const& ntk, cut_en
   static_assert( !ComputeTruth || has_compute_v<Ntk, kitty::dynamic_truth_table>, "Ntk does not implement the compute method for kitty::dynamic_truth_table" );
 
   cut_enumeration_stats st;
-  network_cuts<Ntk, ComputeTruth, CutData> res( ntk.size() );
+  network_cuts<Ntk, ComputeTruth, CutData> res( ntk.size(), ps.truth_tables );
   detail::cut_enumeration_impl<Ntk, ComputeTruth, CutData> p( ntk, ps, st, res );
   p.run();
 
@@ -667,7 +813,7 @@ public:
   template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
   auto truth_table( cut_t const& cut ) const
   {
-    return _truth_tables[cut->func_id];
+    return lookup_truth_table( cut->func_id );
   }
 
   /*! \brief Returns the total number of tuples that were tried to be merged */
@@ -750,6 +896,11 @@ private:
     }
   }
 
+  auto lookup_truth_table( uint32_t func_id ) const
+  {
+    return _truth_tables[func_id];
+  }
+
 private:
   /* compressed representation of cuts */
   std::vector<cut_set_t> _cuts;
@@ -772,6 +923,7 @@ class fast_cut_enumeration_impl
 public:
   using cut_t = typename fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>::cut_t;
   using cut_set_t = typename fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>::cut_set_t;
+  using worker_t = cut_enumeration_worker<cut_set_t, Ntk::max_fanin_size + 1>;
 
   explicit fast_cut_enumeration_impl( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats& st, fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>& cuts )
       : ntk( ntk ),
@@ -787,46 +939,70 @@ public:
   {
     stopwatch t( st.time_total );
 
-    ntk.foreach_node( [this]( auto node ) {
-      const auto index = ntk.node_to_index( node );
+    if ( ps.num_threads > 1u )
+    {
+      workers.resize( ps.num_threads );
+      foreach_node_level_parallel( ntk, ps.num_threads, [this]( auto node, auto thread_id ) {
+        compute_cuts( node, workers[thread_id] );
+      } );
+    }
+    else
+    {
+      workers.resize( 1u );
+      ntk.foreach_node( [this]( auto node ) {
+        compute_cuts( node, workers[0u] );
+      } );
+    }
+
+    for ( auto const& w : workers )
+    {
+      cuts._total_tuples += w.total_tuples;
+      cuts._total_cuts += w.total_cuts;
+      st.time_truth_table += w.time_truth_table;
+    }
+  }
 
-      if ( ps.very_verbose )
-      {
-        std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
-      }
+private:
+  void compute_cuts( node<Ntk> const& node, worker_t& w )
+  {
+    const auto index = ntk.node_to_index( node );
 
-      if ( ntk.is_constant( node ) )
-      {
-        cuts.add_zero_cut( index );
-      }
-      else if ( ntk.is_pi( node ) )
+    if ( ps.very_verbose )
+    {
+      std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
+    }
+
+    if ( ntk.is_constant( node ) )
+    {
+      cuts.add_zero_cut( index );
+    }
+    else if ( ntk.is_pi( node ) )
+    {
+      cuts.add_unit_cut( index );
+    }
+    else
+    {
+      if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
       {
-        cuts.add_unit_cut( index );
+        merge_cuts2( index, w );
       }
       else
       {
-        if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
-        {
-          merge_cuts2( index );
-        }
-        else
-        {
-          merge_cuts( index );
-        }
+        merge_cuts( index, w );
       }
-    } );
+    }
   }
 
 private:
-  uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res )
+  uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res, worker_t& w )
   {
-    stopwatch t( st.time_truth_table );
+    stopwatch t( w.time_truth_table );
 
     std::vector<kitty::static_truth_table<NumVars>> tt( vcuts.size() );
     auto i = 0;
     for ( auto const& cut : vcuts )
     {
-      tt[i] = cuts._truth_tables[( *cut )->func_id];
+      tt[i] = cuts.lookup_truth_table( ( *cut )->func_id );
       const auto supp = cuts.compute_truth_table_support( *cut, res );
       kitty::expand_inplace( tt[i], supp );
       ++i;
@@ -852,15 +1028,16 @@ private:
       }
     }
 
-    return cuts._truth_tables.insert( tt_res );
+    return cuts.insert_truth_table( tt_res );
   }
 
-  void merge_cuts2( uint32_t index )
+  void merge_cuts2( uint32_t index, worker_t& w )
   {
     const auto fanin = 2;
+    auto& lcuts = w.lcuts;
 
     uint32_t pairs{1};
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs]( auto child, auto i ) {
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &lcuts, &pairs]( auto child, auto i ) {
       lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
       pairs *= static_cast<uint32_t>( lcuts[i]->size() );
     } );
@@ -872,7 +1049,7 @@ private:
 
     std::vector<cut_t const*> vcuts( fanin );
 
-    cuts._total_tuples += pairs;
+    w.total_tuples += pairs;
     for ( auto const& c1 : *lcuts[0] )
     {
       for ( auto const& c2 : *lcuts[1] )
@@ -891,7 +1068,7 @@ private:
         {
           vcuts[0] = c1;
           vcuts[1] = c2;
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut, w );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, index );
@@ -903,7 +1080,7 @@ private:
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_limit - 1 );
 
-    cuts._total_cuts += rcuts.size();
+    w.total_cuts += rcuts.size();
 
     if ( rcuts.size() > 1 || ( *rcuts.begin() )->size() > 1 )
     {
@@ -911,11 +1088,12 @@ private:
     }
   }
 
-  void merge_cuts( uint32_t index )
+  void merge_cuts( uint32_t index, worker_t& w )
   {
+    auto& lcuts = w.lcuts;
     uint32_t pairs{1};
     std::vector<uint32_t> cut_sizes;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes]( auto child, auto i ) {
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &lcuts, &pairs, &cut_sizes]( auto child, auto i ) {
       lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
       cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
       pairs *= cut_sizes.back();
@@ -934,7 +1112,7 @@ private:
 
       std::vector<cut_t const*> vcuts( fanin );
 
-      cuts._total_tuples += pairs;
+      w.total_tuples += pairs;
       foreach_mixed_radix_tuple( cut_sizes.begin(), cut_sizes.end(), [&]( auto begin, auto end ) {
         auto it = vcuts.begin();
         auto i = 0u;
@@ -964,7 +1142,7 @@ private:
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut, w );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -984,7 +1162,7 @@ private:
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, {cut}, new_cut );
+          new_cut->func_id = compute_truth_table( index, {cut}, new_cut, w );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -996,7 +1174,7 @@ private:
       rcuts.limit( ps.cut_limit - 1 );
     }
 
-    cuts._total_cuts += static_cast<uint32_t>( rcuts.size() );
+    w.total_cuts += static_cast<uint32_t>( rcuts.size() );
 
     cuts.add_unit_cut( index );
   }
@@ -1007,7 +1185,7 @@ private:
   cut_enumeration_stats& st;
   fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>& cuts;
 
-  std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
+  std::vector<worker_t> workers;
 };
 } /* namespace detail */
 /*! \endcond */
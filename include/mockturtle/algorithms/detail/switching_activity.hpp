@@ -56,10 +56,9 @@ std::vector<float> switching_activity( Ntk const& ntk, unsigned simulation_size
   std::vector<float> sw_map( ntk.size() );
   partial_simulator sim( ntk.num_pis(), simulation_size );
 
-  auto tts = simulate_nodes<kitty::partial_truth_table, Ntk, partial_simulator>( ntk, sim );
-
-  ntk.foreach_node( [&]( auto const& n ) {
-    float ones = static_cast<float>( kitty::count_ones( tts[n] ) );
+  /* signatures are released as soon as all their fanouts are simulated */
+  simulate_nodes_streaming<kitty::partial_truth_table>( ntk, sim, {}, [&]( auto const& n, auto const& tt ) {
+    float ones = static_cast<float>( kitty::count_ones( tt ) );
     float activity = 2.0 * ones / simulation_size * ( simulation_size - ones ) / simulation_size;
     sw_map[ntk.node_to_index( n )] = activity;
   } );
@@ -40,9 +40,14 @@
 #include "../traits.hpp"
 #include "../utils/include/percy.hpp"
 #include "../utils/stopwatch.hpp"
+#include "cleanup.hpp"
 #include "cnf.hpp"
+#include "functional_reduction.hpp"
+#include "simulation.hpp"
 
 #include <fmt/format.h>
+#include <kitty/bit_operations.hpp>
+#include <kitty/partial_truth_table.hpp>
 
 namespace mockturtle
 {
@@ -61,6 +66,19 @@ struct equivalence_checking_params
    */
   uint32_t conflict_limit{0u};
 
+  /*! \brief Number of random patterns simulated before sweeping.
+   *
+   * Only used by `sweeping_equivalence_checking`.
+   */
+  uint32_t num_patterns{256u};
+
+  /*! \brief Parameters for the internal functional reduction.
+   *
+   * Only used by `sweeping_equivalence_checking`, which always enables
+   * `equivalence_classes`.
+   */
+  functional_reduction_params functional_reduction_ps{};
+
   /* \brief Be verbose. */
   bool verbose{false};
 };
@@ -75,12 +93,27 @@ struct equivalence_checking_stats
   /*! \brief Total runtime. */
   stopwatch<>::duration time_total{};
 
+  /*! \brief Time for random simulation (sweeping only). */
+  stopwatch<>::duration time_sim{};
+
+  /*! \brief Time for merging internal equivalences (sweeping only). */
+  stopwatch<>::duration time_sweep{};
+
+  /*! \brief Time for solving the final miter. */
+  stopwatch<>::duration time_sat{};
+
   /*! \brief Counter-example, in case miter is not equivalent. */
   std::vector<bool> counter_example;
 
+  /*! \brief Statistics of the internal functional reduction (sweeping only). */
+  functional_reduction_stats functional_reduction_st;
+
   void report() const
   {
     std::cout << fmt::format( "[i] total time     = {:>5.2f} secs\n", to_seconds( time_total ) );
+    std::cout << fmt::format( "[i]   simulation   = {:>5.2f} secs\n", to_seconds( time_sim ) );
+    std::cout << fmt::format( "[i]   sweeping     = {:>5.2f} secs\n", to_seconds( time_sweep ) );
+    std::cout << fmt::format( "[i]   final SAT    = {:>5.2f} secs\n", to_seconds( time_sat ) );
   }
 };
 
@@ -100,14 +133,14 @@ public:
 
   std::optional<bool> run()
   {
-    stopwatch<> t( st_.time_total );
+    stopwatch<> t( st_.time_sat );
 
     percy::bsat_wrapper solver;
     int output = generate_cnf( miter_, [&]( auto const& clause ) {
       solver.add_clause( clause );
     } )[0];
 
-    const auto res = solver.solve( &output, &output + 1, 0 );
+    const auto res = solver.solve( &output, &output + 1, ps_.conflict_limit );
 
     switch ( res )
     {
@@ -133,6 +166,73 @@ private:
   equivalence_checking_stats& st_;
 };
 
+template<class Ntk>
+class sweeping_equivalence_checking_impl
+{
+public:
+  sweeping_equivalence_checking_impl( Ntk const& miter, equivalence_checking_params const& ps, equivalence_checking_stats& st )
+      : miter_( miter ),
+        ps_( ps ),
+        st_( st )
+  {
+  }
+
+  std::optional<bool> run()
+  {
+    stopwatch<> t( st_.time_total );
+
+    /* work on a copy, as functional reduction modifies the network */
+    Ntk ntk = cleanup_dangling( miter_ );
+
+    /* random simulation */
+    if ( ntk.num_pis() > 0u && ps_.num_patterns > 0u )
+    {
+      partial_simulator sim( ntk.num_pis(), ps_.num_patterns );
+      const auto tts = call_with_stopwatch( st_.time_sim, [&]() {
+        return simulate<kitty::partial_truth_table>( ntk, sim );
+      } );
+      const auto bit = kitty::find_first_one_bit( tts[0] );
+      if ( bit != -1 && static_cast<uint32_t>( bit ) < sim.num_bits() )
+      {
+        st_.counter_example.clear();
+        for ( auto const& pattern : sim.get_patterns() )
+        {
+          st_.counter_example.push_back( kitty::get_bit( pattern, bit ) );
+        }
+        return false;
+      }
+    }
+
+    /* merge internal equivalences */
+    auto fps = ps_.functional_reduction_ps;
+    fps.equivalence_classes = true;
+    call_with_stopwatch( st_.time_sweep, [&]() {
+      functional_reduction( ntk, fps, &st_.functional_reduction_st );
+      ntk = cleanup_dangling( ntk );
+    } );
+
+    /* output reduced to a constant */
+    const auto po = ntk.po_at( 0 );
+    if ( ntk.is_constant( ntk.get_node( po ) ) )
+    {
+      if ( ntk.constant_value( ntk.get_node( po ) ) == ntk.is_complemented( po ) )
+      {
+        return true;
+      }
+      st_.counter_example.assign( ntk.num_pis(), false );
+      return false;
+    }
+
+    /* solve the remaining miter */
+    return equivalence_checking_impl<Ntk>( ntk, ps_, st_ ).run();
+  }
+
+private:
+  Ntk const& miter_;
+  equivalence_checking_params const& ps_;
+  equivalence_checking_stats& st_;
+};
+
 } // namespace detail
 
 /*! \brief Combinational equivalence checking.
@@ -163,7 +263,58 @@ std::optional<bool> equivalence_checking( Ntk const& miter, equivalence_checking
   }
 
   equivalence_checking_stats st;
-  detail::equivalence_checking_impl<Ntk> impl( miter, ps, st );
+  std::optional<bool> result;
+  {
+    stopwatch<> t( st.time_total );
+    detail::equivalence_checking_impl<Ntk> impl( miter, ps, st );
+    result = impl.run();
+  }
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+
+  return result;
+}
+
+/*! \brief Combinational equivalence checking with SAT sweeping.
+ *
+ * This function has the same interface as `equivalence_checking`, but
+ * instead of encoding the whole miter into a single SAT instance, it first
+ * simulates the miter with random patterns, then merges internal
+ * equivalences in a copy of the miter using `functional_reduction` with
+ * signature-based equivalence classes, and finally solves the (usually
+ * much smaller) remaining miter.  The network type must be supported by
+ * `circuit_validator`.
+ *
+ * \param miter Miter network
+ * \param ps Parameters
+ * \param st Statistics
+ */
+template<class Ntk>
+std::optional<bool> sweeping_equivalence_checking( Ntk const& miter, equivalence_checking_params const& ps = {}, equivalence_checking_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_num_pis_v<Ntk>, "Ntk does not implement the num_pis method" );
+  static_assert( has_num_pos_v<Ntk>, "Ntk does not implement the num_pos method" );
+  static_assert( has_po_at_v<Ntk>, "Ntk does not implement the po_at method" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_constant_value_v<Ntk>, "Ntk does not implement the constant_value method" );
+
+  if ( miter.num_pos() != 1u )
+  {
+    std::cout << "[e] miter network must have a single output\n";
+    return std::nullopt;
+  }
+
+  equivalence_checking_stats st;
+  detail::sweeping_equivalence_checking_impl<Ntk> impl( miter, ps, st );
   const auto result = impl.run();
 
   if ( ps.verbose )
@@ -179,4 +330,4 @@ std::optional<bool> equivalence_checking( Ntk const& miter, equivalence_checking
   return result;
 }
 
-} /* namespace mockturtle */
\ No newline at end of file
+} /* namespace mockturtle */
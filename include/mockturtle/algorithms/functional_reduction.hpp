@@ -36,7 +36,14 @@
 #include "../utils/stopwatch.hpp"
 #include "../views/fanout_view.hpp"
 
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
 #include <bill/sat/interface/abc_bsat2.hpp>
+#include <kitty/bit_operations.hpp>
+#include <kitty/hash.hpp>
 #include <kitty/partial_truth_table.hpp>
 
 #include <mockturtle/algorithms/circuit_validator.hpp>
@@ -65,6 +72,16 @@ struct functional_reduction_params
   /*! \brief Whether to save the appended patterns (with CEXs) into file. */
   std::optional<std::string> save_patterns{};
 
+  /*! \brief Whether to use signature-based equivalence classes.
+   *
+   * If true, all nodes are partitioned once into candidate equivalence
+   * classes by hashing their (phase-normalized) simulation signatures.
+   * Each node is only compared to the representative of its class, and
+   * classes are refined as counter-examples are added.  `max_TFI_nodes`
+   * and `skip_fanout_limit` are not used in this mode.
+   */
+  bool equivalence_classes{false};
+
   /*! \brief Maximum number of nodes in the transitive fanin cone (and their fanouts) to be compared to. */
   uint32_t max_TFI_nodes{1000};
 
@@ -76,6 +93,9 @@ struct functional_reduction_params
 
   /*! \brief Maximum number of clauses of the SAT solver. (incremental CNF construction) */
   uint32_t max_clauses{1000};
+
+  /*! \brief Keep one SAT solver and evict least recently used cones instead of restarting it (see `validator_params::incremental`). */
+  bool incremental_sat{false};
 };
 
 struct functional_reduction_stats
@@ -104,6 +124,9 @@ struct functional_reduction_stats
   /*! \brief Number of SAT solver timeout. */
   uint32_t num_timeout{0};
 
+  /*! \brief Number of initial candidate equivalence classes (with more than one node). */
+  uint32_t num_classes{0};
+
   void report() const
   {
     // clang-format off
@@ -114,6 +137,7 @@ struct functional_reduction_stats
     std::cout << fmt::format( "[i] #SAT      = {:8d}\n", num_cex );
     std::cout << fmt::format( "[i] #UNSAT    = {:8d}\n", num_reduction );
     std::cout << fmt::format( "[i] #TIMEOUT  = {:8d}\n", num_timeout );
+    std::cout << fmt::format( "[i] #classes  = {:8d}\n", num_classes );
     std::cout <<              "[i] ======== Runtime ========\n";
     std::cout << fmt::format( "[i] total        : {:>5.2f} secs\n", to_seconds( time_total ) );
     std::cout << fmt::format( "[i]   simulation : {:>5.2f} secs\n", to_seconds( time_sim ) );
@@ -160,6 +184,13 @@ public:
     /* remove constant nodes. */
     substitute_constants();
 
+    if ( ps.equivalence_classes )
+    {
+      /* substitute functional equivalent nodes by their class representatives. */
+      substitute_equivalence_classes();
+      return;
+    }
+
     /* substitute functional equivalent nodes. */
     auto size_before = ntk.size();
     substitute_equivalent_nodes();
@@ -296,6 +327,150 @@ private:
     } );
   }
 
+  void substitute_equivalence_classes()
+  {
+    progress_bar pbar{ntk.size(), "FR-class |{0}| node = {1:>4}   cand = {2:>4}", ps.progress};
+
+    compute_classes();
+    ntk.foreach_gate( [&]( auto const& n, auto i ) {
+      pbar( i, i, candidates );
+
+      if ( ntk.node_to_index( n ) >= class_of.size() )
+      {
+        return true; /* node created during substitution */
+      }
+
+      while ( true )
+      {
+        auto const c = class_of[ntk.node_to_index( n )];
+        auto const rep = representative( c );
+        if ( rep == n )
+        {
+          return true; /* next */
+        }
+
+        check_tts( n );
+        check_tts( rep );
+        if ( normalized_signature( n ) != normalized_signature( rep ) )
+        {
+          /* signatures became different with the last counter-examples */
+          refine_class( c );
+          continue;
+        }
+        bool const phase = kitty::get_bit( tts[n], 0 ) != kitty::get_bit( tts[rep], 0 );
+        signal const g = phase ? !ntk.make_signal( rep ) : ntk.make_signal( rep );
+
+        /* update progress bar */
+        candidates++;
+
+        const auto res = call_with_stopwatch( st.time_sat, [&]() {
+          return validator.validate( n, g );
+        } );
+        if ( !res ) /* timeout */
+        {
+          ++st.num_timeout;
+          return true;
+        }
+        else if ( !( *res ) ) /* SAT, cex found */
+        {
+          found_cex();
+          refine_class( c );
+        }
+        else /* UNSAT, equivalent node verified */
+        {
+          ++st.num_reduction;
+          ++st.num_equ_accepts;
+          /* update network */
+          ntk.substitute_node( n, g );
+          return true;
+        }
+      }
+    } );
+  }
+
+  /*! \brief Partitions PIs and gates by their phase-normalized signatures. */
+  void compute_classes()
+  {
+    classes.clear();
+    class_of.assign( ntk.size(), no_class );
+
+    std::unordered_map<kitty::partial_truth_table, uint32_t, kitty::hash<kitty::partial_truth_table>> sig_to_class;
+    auto const add_node = [&]( node const& n ) {
+      check_tts( n );
+      auto const [it, inserted] = sig_to_class.emplace( normalized_signature( n ), static_cast<uint32_t>( classes.size() ) );
+      if ( inserted )
+      {
+        classes.emplace_back();
+      }
+      classes[it->second].emplace_back( n );
+      class_of[ntk.node_to_index( n )] = it->second;
+    };
+    ntk.foreach_pi( add_node );
+    ntk.foreach_gate( add_node );
+
+    st.num_classes = static_cast<uint32_t>( std::count_if( classes.begin(), classes.end(), []( auto const& cls ) { return cls.size() > 1u; } ) );
+  }
+
+  /*! \brief Splits class `c` according to the current signatures.
+   *
+   * The members keep their relative order, the first sub-class keeps
+   * the index `c`, and dead nodes are removed.
+   */
+  void refine_class( uint32_t c )
+  {
+    auto members = std::move( classes[c] );
+    classes[c].clear();
+
+    std::unordered_map<kitty::partial_truth_table, uint32_t, kitty::hash<kitty::partial_truth_table>> sig_to_class;
+    for ( auto const& n : members )
+    {
+      if ( is_dead( n ) )
+      {
+        class_of[ntk.node_to_index( n )] = no_class;
+        continue;
+      }
+
+      check_tts( n );
+      auto const [it, inserted] = sig_to_class.emplace( normalized_signature( n ), sig_to_class.empty() ? c : static_cast<uint32_t>( classes.size() ) );
+      if ( inserted && it->second != c )
+      {
+        classes.emplace_back();
+      }
+      classes[it->second].emplace_back( n );
+      class_of[ntk.node_to_index( n )] = it->second;
+    }
+  }
+
+  /*! \brief Returns the first alive node in class `c`. */
+  node representative( uint32_t c ) const
+  {
+    assert( c != no_class );
+    auto const it = std::find_if( classes[c].begin(), classes[c].end(), [&]( node const& n ) { return !is_dead( n ); } );
+    assert( it != classes[c].end() );
+    return *it;
+  }
+
+  /*! \brief Signature of `n`, complemented such that the first bit is 0. */
+  kitty::partial_truth_table normalized_signature( node const& n )
+  {
+    auto tt = tts[n];
+    tt.mask_bits();
+    return kitty::get_bit( tt, 0 ) ? ~tt : tt;
+  }
+
+  bool is_dead( node const& n ) const
+  {
+    if constexpr ( has_is_dead_v<Ntk> )
+    {
+      return ntk.is_dead( n );
+    }
+    else
+    {
+      (void)n;
+      return false;
+    }
+  }
+
   bool try_node( kitty::partial_truth_table& tt, kitty::partial_truth_table& ntt, node const& root, node const& n )
   {
     signal g;
@@ -407,6 +582,11 @@ private:
   validator_t validator;
 
   uint32_t candidates{0};
+
+  /* candidate equivalence classes (`equivalence_classes` mode) */
+  static constexpr uint32_t no_class = std::numeric_limits<uint32_t>::max();
+  std::vector<std::vector<node>> classes;
+  std::vector<uint32_t> class_of;
 }; /* functional_reduction_impl */
 
 } /* namespace detail */
@@ -435,6 +615,7 @@ void functional_reduction( Ntk& ntk, functional_reduction_params const& ps = {},
   validator_params vps;
   vps.max_clauses = ps.max_clauses;
   vps.conflict_limit = ps.conflict_limit;
+  vps.incremental = ps.incremental_sat;
 
   using fanout_view_t = fanout_view<Ntk>;
   fanout_view_t fanout_view{ntk};
@@ -0,0 +1,802 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file gate_sizing.hpp
+  \brief Timing-driven gate sizing and buffering of mapped networks
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operators.hpp>
+
+#include "../io/genlib_reader.hpp"
+#include "../networks/klut.hpp"
+#include "../utils/stopwatch.hpp"
+#include "../views/binding_view.hpp"
+#include "../views/topo_view.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for gate_sizing.
+ *
+ * The data structure `gate_sizing_params` holds configurable parameters with
+ * default arguments for `gate_sizing`.
+ */
+struct gate_sizing_params
+{
+  /*! \brief Load of each primary output. */
+  double output_load{ 0.0 };
+
+  /*! \brief Number of passes over the critical paths. */
+  uint32_t rounds{ 3u };
+
+  /*! \brief Replace critical gates by gates of the same function. */
+  bool resize_gates{ true };
+
+  /*! \brief Drive the non-critical fanouts of critical gates through buffers. */
+  bool insert_buffers{ true };
+
+  /*! \brief Maximum number of fanouts of a node, enforced with buffers (0 for no limit). */
+  uint32_t max_fanout{ 0u };
+
+  /*! \brief Be verbose. */
+  bool verbose{ false };
+};
+
+/*! \brief Statistics for gate_sizing.
+ *
+ * The data structure `gate_sizing_stats` provides data collected by running
+ * `gate_sizing`.
+ */
+struct gate_sizing_stats
+{
+  /*! \brief Worst delay before and after sizing. */
+  double delay_before{ 0 };
+  double delay_after{ 0 };
+
+  /*! \brief Area before and after sizing. */
+  double area_before{ 0 };
+  double area_after{ 0 };
+
+  /*! \brief Number of resized gates and inserted buffers. */
+  uint32_t resized_gates{ 0 };
+  uint32_t inserted_buffers{ 0 };
+
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{ 0 };
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] Delay = {:>8.2f} -> {:>8.2f}; Area = {:>10.2f} -> {:>10.2f}\n", delay_before, delay_after, area_before, area_after );
+    std::cout << fmt::format( "[i] Resized gates = {:>6d}; Inserted buffers = {:>6d}\n", resized_gates, inserted_buffers );
+    std::cout << fmt::format( "[i] Total runtime = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+namespace detail
+{
+
+class gate_sizing_impl
+{
+public:
+  using bound_network = binding_view<klut_network>;
+  using sink_t = std::pair<uint32_t, uint32_t>; /* fanout node and its pin */
+
+  static constexpr uint32_t unbound = bound_network::unbound;
+
+  gate_sizing_impl( bound_network const& ntk, gate_sizing_params const& ps, gate_sizing_stats& st )
+      : ntk( ntk ),
+        gates( ntk.get_library() ),
+        ps( ps ),
+        st( st )
+  {
+  }
+
+  bound_network run()
+  {
+    stopwatch t( st.time_total );
+
+    init_library();
+    init_graph();
+    compute_timing();
+
+    st.delay_before = worst_delay();
+    st.area_before = total_area();
+
+    fix_fanouts();
+
+    for ( auto i = 0u; i < ps.rounds; ++i )
+    {
+      auto const delay = worst_delay();
+
+      compute_required();
+      if ( ps.resize_gates )
+      {
+        resize_critical_gates();
+      }
+      if ( ps.insert_buffers )
+      {
+        buffer_critical_nets();
+      }
+      fix_fanouts();
+
+      if ( ps.verbose )
+      {
+        std::cout << fmt::format( "[i] Round {}: Delay = {:>8.2f}  Area = {:>10.2f}\n", i + 1, worst_delay(), total_area() );
+      }
+      if ( worst_delay() > delay - epsilon )
+      {
+        break;
+      }
+    }
+
+    st.delay_after = worst_delay();
+    st.area_after = total_area();
+
+    return rebuild();
+  }
+
+private:
+  struct pin_timing
+  {
+    double input_load{ 0 };
+    double block_delay{ 0 };
+    double fanout_delay{ 0 };
+  };
+
+  void init_library()
+  {
+    kitty::dynamic_truth_table buffer( 1u );
+    kitty::create_nth_var( buffer, 0u );
+
+    pins.resize( gates.size() );
+    max_load.resize( gates.size(), std::numeric_limits<double>::max() );
+    equivalents.resize( gates.size() );
+    is_buffer.resize( gates.size(), false );
+    for ( auto i = 0u; i < gates.size(); ++i )
+    {
+      auto const& g = gates[i];
+      for ( auto j = 0u; j < g.num_vars; ++j )
+      {
+        auto const pin = g.get_pin( j );
+        if ( pin == nullptr )
+        {
+          pins[i].emplace_back();
+          continue;
+        }
+        pins[i].push_back( { pin->input_load, std::max( pin->rise_block_delay, pin->fall_block_delay ), std::max( pin->rise_fanout_delay, pin->fall_fanout_delay ) } );
+        max_load[i] = std::min( max_load[i], pin->max_load );
+      }
+
+      if ( g.num_vars == 0u )
+        continue;
+
+      for ( auto k = 0u; k < gates.size(); ++k )
+      {
+        if ( gates[k].num_vars == g.num_vars && gates[k].function == g.function )
+          equivalents[i].push_back( k );
+      }
+      if ( g.function == buffer )
+      {
+        is_buffer[i] = true;
+        buffers.push_back( i );
+      }
+    }
+
+    /* the strongest buffer first */
+    std::sort( buffers.begin(), buffers.end(), [&]( auto a, auto b ) {
+      return std::make_pair( pins[a][0].fanout_delay, gates[a].area ) < std::make_pair( pins[b][0].fanout_delay, gates[b].area );
+    } );
+  }
+
+  void init_graph()
+  {
+    auto const size = ntk.size();
+    cell.resize( size, unbound );
+    fanins.resize( size );
+    fanouts.resize( size );
+    po_refs.resize( size, 0u );
+    rank.resize( size, 0.0 );
+    load.resize( size, 0.0 );
+    arrival.resize( size, 0.0 );
+    required.resize( size, 0.0 );
+    removed.resize( size, true );
+    in_queue.resize( size, false );
+
+    /* nodes outside the transitive fanin of the outputs are removed */
+    auto position = 0u;
+    topo_view<klut_network>{ ntk }.foreach_node( [&]( auto const& n ) {
+      auto const index = ntk.node_to_index( n );
+      removed[index] = false;
+      rank[index] = position++;
+
+      if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+        return;
+
+      cell[index] = ntk.get_binding_index( n );
+      ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+        auto const fanin = ntk.node_to_index( ntk.get_node( f ) );
+        fanins[index].push_back( fanin );
+        fanouts[fanin].emplace_back( index, i );
+      } );
+    } );
+
+    ntk.foreach_po( [&]( auto const& f ) {
+      auto const index = ntk.node_to_index( ntk.get_node( f ) );
+      outputs.push_back( index );
+      ++po_refs[index];
+    } );
+  }
+
+  uint32_t add_node( uint32_t gate, double node_rank )
+  {
+    cell.push_back( gate );
+    fanins.emplace_back();
+    fanouts.emplace_back();
+    po_refs.push_back( 0u );
+    rank.push_back( node_rank );
+    load.push_back( 0.0 );
+    arrival.push_back( 0.0 );
+    required.push_back( std::numeric_limits<double>::max() );
+    removed.push_back( false );
+    in_queue.push_back( false );
+    return static_cast<uint32_t>( cell.size() - 1u );
+  }
+
+  std::vector<uint32_t> topological_order() const
+  {
+    std::vector<uint32_t> order;
+    for ( auto i = 0u; i < cell.size(); ++i )
+    {
+      if ( !removed[i] )
+        order.push_back( i );
+    }
+    std::sort( order.begin(), order.end(), [&]( auto a, auto b ) { return rank[a] < rank[b]; } );
+    return order;
+  }
+
+#pragma region Timing
+  double pin_delay( uint32_t n, uint32_t pin ) const
+  {
+    if ( cell[n] == unbound )
+      return 0.0;
+    auto const& p = pins[cell[n]][pin];
+    return p.block_delay + p.fanout_delay * load[n];
+  }
+
+  double compute_load( uint32_t n ) const
+  {
+    double l = po_refs[n] * ps.output_load;
+    for ( auto const& [s, pin] : fanouts[n] )
+    {
+      if ( cell[s] != unbound )
+        l += pins[cell[s]][pin].input_load;
+    }
+    return l;
+  }
+
+  double compute_arrival( uint32_t n ) const
+  {
+    double a = 0.0;
+    for ( auto i = 0u; i < fanins[n].size(); ++i )
+    {
+      a = std::max( a, arrival[fanins[n][i]] + pin_delay( n, i ) );
+    }
+    return a;
+  }
+
+  void compute_timing()
+  {
+    auto const order = topological_order();
+    for ( auto n : order )
+    {
+      load[n] = compute_load( n );
+    }
+    for ( auto n : order )
+    {
+      arrival[n] = compute_arrival( n );
+    }
+  }
+
+  void compute_required()
+  {
+    auto const order = topological_order();
+    std::fill( required.begin(), required.end(), std::numeric_limits<double>::max() );
+
+    auto const delay = worst_delay();
+    for ( auto n : outputs )
+    {
+      required[n] = delay;
+    }
+    for ( auto it = order.rbegin(); it != order.rend(); ++it )
+    {
+      for ( auto i = 0u; i < fanins[*it].size(); ++i )
+      {
+        auto const f = fanins[*it][i];
+        required[f] = std::min( required[f], required[*it] - pin_delay( *it, i ) );
+      }
+    }
+  }
+
+  /* propagates the arrival times from `seeds` to the outputs in topological order */
+  void retime( std::vector<uint32_t> const& seeds )
+  {
+    using entry_t = std::pair<double, uint32_t>;
+    std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t>> queue;
+
+    for ( auto n : seeds )
+    {
+      if ( !in_queue[n] )
+      {
+        in_queue[n] = true;
+        queue.emplace( rank[n], n );
+      }
+    }
+
+    while ( !queue.empty() )
+    {
+      auto const n = queue.top().second;
+      queue.pop();
+      in_queue[n] = false;
+
+      auto const a = compute_arrival( n );
+      if ( a == arrival[n] )
+        continue;
+
+      arrival[n] = a;
+      for ( auto const& [s, pin] : fanouts[n] )
+      {
+        (void)pin;
+        if ( !in_queue[s] )
+        {
+          in_queue[s] = true;
+          queue.emplace( rank[s], s );
+        }
+      }
+    }
+  }
+
+  double worst_delay() const
+  {
+    double delay = 0.0;
+    for ( auto n : outputs )
+    {
+      delay = std::max( delay, arrival[n] );
+    }
+    return delay;
+  }
+
+  double total_area() const
+  {
+    double area = 0.0;
+    for ( auto i = 0u; i < cell.size(); ++i )
+    {
+      if ( !removed[i] && cell[i] != unbound )
+        area += gates[cell[i]].area;
+    }
+    return area;
+  }
+
+  /* worst delay, sum of output arrival times, and area */
+  std::tuple<double, double, double> cost() const
+  {
+    double sum = 0.0;
+    for ( auto n : outputs )
+    {
+      sum += arrival[n];
+    }
+    return { worst_delay(), sum, total_area() };
+  }
+
+  bool improves( std::tuple<double, double, double> const& c, std::tuple<double, double, double> const& best ) const
+  {
+    if ( std::get<0>( c ) < std::get<0>( best ) - epsilon )
+      return true;
+    if ( std::get<0>( c ) > std::get<0>( best ) + epsilon )
+      return false;
+    if ( std::get<1>( c ) < std::get<1>( best ) - epsilon )
+      return true;
+    if ( std::get<1>( c ) > std::get<1>( best ) + epsilon )
+      return false;
+    return std::get<2>( c ) < std::get<2>( best ) - epsilon;
+  }
+#pragma endregion
+
+#pragma region Sizing
+  void set_cell( uint32_t n, uint32_t gate )
+  {
+    for ( auto i = 0u; i < fanins[n].size(); ++i )
+    {
+      load[fanins[n][i]] += pins[gate][i].input_load - pins[cell[n]][i].input_load;
+    }
+    cell[n] = gate;
+
+    auto seeds = fanins[n];
+    seeds.push_back( n );
+    retime( seeds );
+  }
+
+  void resize_critical_gates()
+  {
+    auto const order = topological_order();
+    for ( auto it = order.rbegin(); it != order.rend(); ++it )
+    {
+      auto const n = *it;
+      if ( cell[n] == unbound || equivalents[cell[n]].size() < 2u || required[n] - arrival[n] > epsilon )
+        continue;
+
+      auto const original = cell[n];
+      auto best = original;
+      auto best_cost = cost();
+      for ( auto gate : equivalents[original] )
+      {
+        if ( gate == original )
+          continue;
+
+        set_cell( n, gate );
+        if ( auto const c = cost(); improves( c, best_cost ) )
+        {
+          best = gate;
+          best_cost = c;
+        }
+      }
+
+      if ( cell[n] != best )
+      {
+        set_cell( n, best );
+      }
+      if ( best != original )
+      {
+        ++st.resized_gates;
+      }
+    }
+  }
+#pragma endregion
+
+#pragma region Buffering
+  /* returns a buffer driven by `n`, or `unbound` */
+  uint32_t find_buffer( uint32_t n ) const
+  {
+    for ( auto const& [s, pin] : fanouts[n] )
+    {
+      (void)pin;
+      if ( cell[s] != unbound && is_buffer[cell[s]] )
+        return s;
+    }
+    return unbound;
+  }
+
+  /* drives `sinks` of `n` by `buffer`, which is driven by `n` */
+  void move_sinks( uint32_t n, uint32_t buffer, std::vector<sink_t> const& sinks )
+  {
+    for ( auto const& sink : sinks )
+    {
+      /* the buffer precedes its sinks in the topological order */
+      rank[buffer] = std::min( rank[buffer], ( rank[n] + rank[sink.first] ) / 2 );
+      fanins[sink.first][sink.second] = buffer;
+      fanouts[n].erase( std::find( fanouts[n].begin(), fanouts[n].end(), sink ) );
+      fanouts[buffer].push_back( sink );
+    }
+    load[n] = compute_load( n );
+    load[buffer] = compute_load( buffer );
+
+    std::vector<uint32_t> seeds = { n, buffer };
+    for ( auto const& sink : sinks )
+    {
+      seeds.push_back( sink.first );
+    }
+    retime( seeds );
+  }
+
+  uint32_t create_buffer( uint32_t n, uint32_t gate )
+  {
+    auto const buffer = add_node( gate, std::numeric_limits<double>::max() );
+    fanins[buffer].push_back( n );
+    fanouts[n].emplace_back( buffer, 0u );
+    ++st.inserted_buffers;
+    return buffer;
+  }
+
+  void remove_buffer( uint32_t n, uint32_t buffer )
+  {
+    assert( fanouts[buffer].empty() );
+    fanouts[n].erase( std::find( fanouts[n].begin(), fanouts[n].end(), sink_t{ buffer, 0u } ) );
+    removed[buffer] = true;
+    --st.inserted_buffers;
+
+    load[n] = compute_load( n );
+    retime( { n } );
+  }
+
+  /* moves `sinks` of `n` behind its buffer or a new one */
+  uint32_t buffer_sinks( uint32_t n, std::vector<sink_t> const& sinks )
+  {
+    /* a second buffer would be merged with the first one in the network */
+    auto buffer = find_buffer( n );
+    if ( buffer == unbound )
+    {
+      buffer = create_buffer( n, buffers.front() );
+    }
+    move_sinks( n, buffer, sinks );
+    return buffer;
+  }
+
+  void unbuffer_sinks( uint32_t n, uint32_t buffer, std::vector<sink_t> const& sinks )
+  {
+    for ( auto const& sink : sinks )
+    {
+      fanins[sink.first][sink.second] = n;
+      fanouts[buffer].erase( std::find( fanouts[buffer].begin(), fanouts[buffer].end(), sink ) );
+      fanouts[n].push_back( sink );
+    }
+    if ( fanouts[buffer].empty() )
+    {
+      remove_buffer( n, buffer );
+    }
+
+    load[n] = compute_load( n );
+    load[buffer] = compute_load( buffer );
+
+    std::vector<uint32_t> seeds = { n, buffer };
+    for ( auto const& sink : sinks )
+    {
+      seeds.push_back( sink.first );
+    }
+    retime( seeds );
+  }
+
+  /* the fanouts of `n` from the most to the least critical one */
+  std::vector<sink_t> sorted_sinks( uint32_t n ) const
+  {
+    auto sinks = fanouts[n];
+    std::stable_sort( sinks.begin(), sinks.end(), [&]( auto const& a, auto const& b ) {
+      return required[a.first] - arrival[a.first] < required[b.first] - arrival[b.first];
+    } );
+    return sinks;
+  }
+
+  /* drives the fanouts with positive slack of critical nodes through a buffer */
+  void buffer_critical_nets()
+  {
+    if ( buffers.empty() )
+      return;
+
+    auto const& buffer_pin = pins[buffers.front()][0];
+    auto const order = topological_order();
+    for ( auto it = order.rbegin(); it != order.rend(); ++it )
+    {
+      auto const n = *it;
+      if ( cell[n] == unbound || is_buffer[cell[n]] || fanouts[n].size() + po_refs[n] < 2u || required[n] - arrival[n] > epsilon )
+        continue;
+
+      std::vector<sink_t> sinks;
+      double moved_load = 0.0;
+      for ( auto const& sink : fanouts[n] )
+      {
+        if ( cell[sink.first] == unbound || is_buffer[cell[sink.first]] )
+          continue;
+        moved_load += pins[cell[sink.first]][sink.second].input_load;
+        sinks.push_back( sink );
+      }
+
+      /* keep the sinks that cannot afford the delay of the buffer */
+      sinks.erase( std::remove_if( sinks.begin(), sinks.end(), [&]( auto const& sink ) {
+                     return required[sink.first] - arrival[sink.first] < buffer_pin.block_delay + buffer_pin.fanout_delay * moved_load;
+                   } ),
+                   sinks.end() );
+      if ( sinks.empty() || sinks.size() == fanouts[n].size() )
+        continue;
+
+      auto const before = cost();
+      auto const buffer = buffer_sinks( n, sinks );
+      if ( !improves( cost(), before ) )
+      {
+        unbuffer_sinks( n, buffer, sinks );
+      }
+    }
+  }
+
+  /* inserts buffers at nodes with too many fanouts or a too large load */
+  void fix_fanouts()
+  {
+    if ( buffers.empty() )
+      return;
+
+    auto const buffer_load = pins[buffers.front()][0].input_load;
+
+    std::vector<uint32_t> stack;
+    for ( auto i = 0u; i < cell.size(); ++i )
+    {
+      if ( !removed[i] && ( i >= ntk.size() || !ntk.is_constant( ntk.index_to_node( i ) ) ) )
+        stack.push_back( i );
+    }
+
+    while ( !stack.empty() )
+    {
+      auto const n = stack.back();
+      stack.pop_back();
+
+      auto const limit_load = cell[n] == unbound ? std::numeric_limits<double>::max() : max_load[cell[n]];
+      auto const limit_fanout = ps.max_fanout == 0u ? std::numeric_limits<uint32_t>::max() : ps.max_fanout;
+      if ( fanouts[n].size() + po_refs[n] <= limit_fanout && load[n] <= limit_load + epsilon )
+        continue;
+
+      /* keep the buffer and the most critical sinks that fit next to it */
+      auto const existing = find_buffer( n );
+      auto sinks = sorted_sinks( n );
+      sinks.erase( std::remove( sinks.begin(), sinks.end(), sink_t{ existing, 0u } ), sinks.end() );
+      auto kept = 0u;
+      double kept_load = po_refs[n] * ps.output_load + buffer_load;
+      while ( kept < sinks.size() )
+      {
+        auto const sink_load = cell[sinks[kept].first] == unbound ? 0.0 : pins[cell[sinks[kept].first]][sinks[kept].second].input_load;
+        if ( kept + po_refs[n] + 1u >= limit_fanout || kept_load + sink_load > limit_load + epsilon )
+          break;
+        kept_load += sink_load;
+        ++kept;
+      }
+      kept = std::max( kept, 1u );
+      if ( kept >= sinks.size() )
+        continue;
+
+      stack.push_back( buffer_sinks( n, std::vector<sink_t>( sinks.begin() + kept, sinks.end() ) ) );
+    }
+  }
+#pragma endregion
+
+  bound_network rebuild() const
+  {
+    bound_network res( gates );
+    std::vector<klut_network::signal> old2new( cell.size() );
+
+    ntk.foreach_node( [&]( auto const& n ) {
+      if ( ntk.is_constant( n ) )
+        old2new[ntk.node_to_index( n )] = res.get_constant( ntk.constant_value( n ) );
+    } );
+    ntk.foreach_pi( [&]( auto const& n ) {
+      old2new[ntk.node_to_index( n )] = res.create_pi();
+    } );
+
+    std::vector<klut_network::signal> children;
+    for ( auto n : topological_order() )
+    {
+      if ( fanins[n].empty() )
+        continue;
+
+      children.clear();
+      for ( auto f : fanins[n] )
+      {
+        children.push_back( old2new[f] );
+      }
+
+      if ( cell[n] == unbound )
+      {
+        old2new[n] = res.create_node( children, ntk.node_function( ntk.index_to_node( n ) ) );
+        continue;
+      }
+      old2new[n] = res.create_node( children, gates[cell[n]].function );
+      if ( !res.is_constant( res.get_node( old2new[n] ) ) )
+        res.add_binding( res.get_node( old2new[n] ), cell[n] );
+    }
+
+    for ( auto n : outputs )
+    {
+      res.create_po( old2new[n] );
+    }
+    return res;
+  }
+
+private:
+  bound_network const& ntk;
+  std::vector<gate> const& gates;
+  gate_sizing_params const& ps;
+  gate_sizing_stats& st;
+
+  static constexpr double epsilon{ 1e-6 };
+
+  /* library */
+  std::vector<std::vector<pin_timing>> pins;
+  std::vector<double> max_load;
+  std::vector<std::vector<uint32_t>> equivalents;
+  std::vector<bool> is_buffer;
+  std::vector<uint32_t> buffers;
+
+  /* timing graph, buffers are appended to the nodes of the network */
+  std::vector<uint32_t> cell;
+  std::vector<std::vector<uint32_t>> fanins;
+  std::vector<std::vector<sink_t>> fanouts;
+  std::vector<uint32_t> po_refs;
+  std::vector<uint32_t> outputs;
+  std::vector<double> rank;
+  std::vector<double> load;
+  std::vector<double> arrival;
+  std::vector<double> required;
+  std::vector<bool> removed;
+  std::vector<bool> in_queue;
+};
+
+} /* namespace detail */
+
+/*! \brief Timing-driven gate sizing and buffering.
+ *
+ * This function reduces the worst delay of a network mapped with `map` under
+ * the load-dependent delay model of `binding_view`, where the delay of a pin
+ * grows with the input loads of the pins driven by its gate.  In each round,
+ * it computes the required times and
+ *
+ * - replaces each critical gate by the gate of the same function that gives
+ *   the best timing (e.g., a stronger or weaker inverter),
+ * - drives the fanouts with enough slack of each critical gate through a
+ *   buffer, which reduces the load on the critical path.
+ *
+ * A change is kept only if it improves the worst delay, or the sum of the
+ * arrival times at the outputs for the same worst delay.  After each change,
+ * the arrival times are updated incrementally in the transitive fanout of the
+ * changed nodes.  Besides, buffers are inserted at nodes with more than
+ * `max_fanout` fanouts or with a load larger than the maximum load of their
+ * gate.  The function returns a new bound network.
+ *
+ * The network must be combinational.  Unbound nodes have no delay.
+ *
+ * \param ntk Mapped network
+ * \param ps Parameters
+ * \param pst Statistics
+ */
+inline binding_view<klut_network> gate_sizing( binding_view<klut_network> const& ntk, gate_sizing_params const& ps = {}, gate_sizing_stats* pst = nullptr )
+{
+  assert( ntk.is_combinational() && "network has to be combinational" );
+
+  gate_sizing_stats st;
+  detail::gate_sizing_impl p( ntk, ps, st );
+  auto res = p.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return res;
+}
+
+} /* namespace mockturtle */
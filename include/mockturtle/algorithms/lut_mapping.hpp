@@ -33,9 +33,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
 
 #include <fmt/format.h>
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
 
 #include "../utils/stopwatch.hpp"
 #include "../views/topo_view.hpp"
@@ -73,6 +80,17 @@ struct lut_mapping_params
   /*! \brief Number of rounds for exact area optimization. */
   uint32_t rounds_ela{1u};
 
+  /*! \brief Compute priority cuts on the fly.
+   *
+   * Instead of enumerating the cuts of all nodes up front, every round
+   * recomputes the cuts of each node from the cuts of its fanins and keeps
+   * only the `cut_enumeration_ps.cut_limit - 1` best ones with respect to
+   * the cost function of the round.  Memory then scales with the number of
+   * priority cuts, which are stored in a compact array.  The `CutData`
+   * argument of `lut_mapping` is not used in this mode.
+   */
+  bool priority_cuts{false};
+
   /*! \brief Be verbose. */
   bool verbose{false};
 };
@@ -469,6 +487,565 @@ private:
   std::vector<uint32_t> tmp_area; /* temporary vector to compute exact area */
 };
 
+template<class Ntk, bool StoreFunction>
+class lut_mapping_priority_impl
+{
+  static constexpr uint32_t max_cut_size = 16u;
+
+public:
+  lut_mapping_priority_impl( Ntk& ntk, lut_mapping_params const& ps, lut_mapping_stats& st )
+      : ntk( ntk ),
+        ps( ps ),
+        st( st ),
+        cut_size( std::min( ps.cut_enumeration_ps.cut_size, max_cut_size ) ),
+        cut_limit( std::max( ps.cut_enumeration_ps.cut_limit, 2u ) - 1u ),
+        flow_refs( ntk.size() ),
+        map_refs( ntk.size(), 0 ),
+        flows( ntk.size() ),
+        delays( ntk.size() ),
+        leaves( static_cast<std::size_t>( ntk.size() ) * cut_limit * cut_size ),
+        sizes( static_cast<std::size_t>( ntk.size() ) * cut_limit ),
+        num_cuts( ntk.size(), 0 )
+  {
+  }
+
+  void run()
+  {
+    stopwatch t( st.time_total );
+
+    /* compute and save topological order */
+    top_order.reserve( ntk.size() );
+    topo_view<Ntk>( ntk ).foreach_node( [this]( auto n ) {
+      top_order.push_back( n );
+    } );
+
+    init_nodes();
+    set_mapping_refs<false>();
+
+    while ( iteration < ps.rounds )
+    {
+      compute_mapping<false>();
+    }
+
+    while ( iteration < ps.rounds + ps.rounds_ela )
+    {
+      compute_mapping<true>();
+    }
+
+    derive_mapping();
+  }
+
+private:
+  struct candidate
+  {
+    std::array<uint32_t, max_cut_size> leaves;
+    uint32_t size{0};
+    uint64_t signature{0};
+    float flow{0};
+    uint32_t delay{0};
+  };
+
+  /* leaves of the i-th priority cut of a node */
+  struct cut_leaves
+  {
+    uint32_t const* first;
+    uint32_t const* last;
+
+    uint32_t const* begin() const { return first; }
+    uint32_t const* end() const { return last; }
+  };
+
+  cut_leaves best_cut( uint32_t index ) const
+  {
+    return get_cut( index, 0u );
+  }
+
+  cut_leaves get_cut( uint32_t index, uint32_t i ) const
+  {
+    auto const* first = &leaves[( static_cast<std::size_t>( index ) * cut_limit + i ) * cut_size];
+    return {first, first + sizes[static_cast<std::size_t>( index ) * cut_limit + i]};
+  }
+
+  void init_nodes()
+  {
+    for ( auto const& n : top_order )
+    {
+      const auto index = ntk.node_to_index( n );
+
+      if ( ntk.is_constant( n ) )
+      {
+        /* the constant has the empty cut */
+        num_cuts[index] = 1u;
+        sizes[static_cast<std::size_t>( index ) * cut_limit] = 0u;
+        flow_refs[index] = 1.0f;
+        continue;
+      }
+      if ( ntk.is_pi( n ) )
+      {
+        flow_refs[index] = 1.0f;
+        continue;
+      }
+      flow_refs[index] = static_cast<float>( ntk.fanout_size( n ) );
+
+      /* area flow as in `cut_enumeration_mf_cut` */
+      compute_candidates( n, index );
+      for ( auto& c : candidates )
+      {
+        c.flow = c.size < 2u ? 0.0f : 1.0f;
+        c.delay = 0u;
+        for ( auto i = 0u; i < c.size; ++i )
+        {
+          c.flow += flows[c.leaves[i]];
+          c.delay = std::max( c.delay, delays[c.leaves[i]] );
+        }
+        c.flow /= std::max( 1u, static_cast<uint32_t>( ntk.fanout_size( n ) ) );
+        c.delay += 1u;
+      }
+      keep_best_candidates( index, [&]( candidate const& c1, candidate const& c2 ) {
+        constexpr auto eps{0.005f};
+        if ( c1.flow < c2.flow - eps )
+          return true;
+        if ( c1.flow > c2.flow + eps )
+          return false;
+        if ( c1.delay < c2.delay )
+          return true;
+        if ( c1.delay > c2.delay )
+          return false;
+        return c1.size < c2.size;
+      } );
+
+      if ( num_cuts[index] > 0u )
+      {
+        flows[index] = candidates.front().flow;
+        delays[index] = candidates.front().delay;
+      }
+    }
+  }
+
+  template<bool ELA>
+  void compute_mapping()
+  {
+    for ( auto const& n : top_order )
+    {
+      if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+        continue;
+      compute_best_cut<ELA>( n, ntk.node_to_index( n ) );
+    }
+    set_mapping_refs<ELA>();
+  }
+
+  template<bool ELA>
+  void set_mapping_refs()
+  {
+    const auto coef = 1.0f / ( 1.0f + ( iteration + 1 ) * ( iteration + 1 ) );
+
+    /* compute current delay and update mapping refs */
+    delay = 0;
+    ntk.foreach_po( [this]( auto s ) {
+      const auto index = ntk.node_to_index( ntk.get_node( s ) );
+      delay = std::max( delay, delays[index] );
+
+      if constexpr ( !ELA )
+      {
+        map_refs[index]++;
+      }
+    } );
+
+    /* compute current area and update mapping refs */
+    area = 0;
+    for ( auto it = top_order.rbegin(); it != top_order.rend(); ++it )
+    {
+      if ( ntk.is_constant( *it ) || ntk.is_pi( *it ) )
+        continue;
+
+      const auto index = ntk.node_to_index( *it );
+      if ( map_refs[index] == 0 )
+        continue;
+
+      if constexpr ( !ELA )
+      {
+        for ( auto leaf : best_cut( index ) )
+        {
+          map_refs[leaf]++;
+        }
+      }
+      area++;
+    }
+
+    /* blend flow referenes */
+    for ( auto i = 0u; i < ntk.size(); ++i )
+    {
+      flow_refs[i] = coef * flow_refs[i] + ( 1.0f - coef ) * std::max( 1.0f, static_cast<float>( map_refs[i] ) );
+    }
+
+    ++iteration;
+  }
+
+  bool is_terminal( uint32_t index ) const
+  {
+    return ntk.is_constant( ntk.index_to_node( index ) ) || ntk.is_pi( ntk.index_to_node( index ) );
+  }
+
+  uint32_t cut_ref( cut_leaves const& cut )
+  {
+    uint32_t count = 1u;
+    for ( auto leaf : cut )
+    {
+      if ( is_terminal( leaf ) )
+        continue;
+
+      if ( map_refs[leaf]++ == 0 )
+      {
+        count += cut_ref( best_cut( leaf ) );
+      }
+    }
+    return count;
+  }
+
+  uint32_t cut_deref( cut_leaves const& cut )
+  {
+    uint32_t count = 1u;
+    for ( auto leaf : cut )
+    {
+      if ( is_terminal( leaf ) )
+        continue;
+
+      if ( --map_refs[leaf] == 0 )
+      {
+        count += cut_deref( best_cut( leaf ) );
+      }
+    }
+    return count;
+  }
+
+  template<typename Leaves>
+  uint32_t cut_ref_limit_save( Leaves const& cut, uint32_t limit )
+  {
+    uint32_t count = 1u;
+    if ( limit == 0 )
+      return count;
+
+    for ( auto leaf : cut )
+    {
+      if ( is_terminal( leaf ) )
+        continue;
+
+      tmp_area.push_back( leaf );
+      if ( map_refs[leaf]++ == 0 )
+      {
+        count += cut_ref_limit_save( best_cut( leaf ), limit - 1 );
+      }
+    }
+    return count;
+  }
+
+  uint32_t cut_area_estimation( candidate const& c )
+  {
+    tmp_area.clear();
+    const auto count = cut_ref_limit_save( cut_leaves{c.leaves.data(), c.leaves.data() + c.size}, 8 );
+    for ( auto const& n : tmp_area )
+    {
+      map_refs[n]--;
+    }
+    return count;
+  }
+
+  template<bool ELA>
+  void compute_best_cut( node<Ntk> const& n, uint32_t index )
+  {
+    if constexpr ( ELA )
+    {
+      if ( map_refs[index] > 0 && num_cuts[index] > 0u )
+      {
+        cut_deref( best_cut( index ) );
+      }
+    }
+
+    compute_candidates( n, index );
+    for ( auto& c : candidates )
+    {
+      c.delay = 0u;
+      c.flow = 0.0f;
+      for ( auto i = 0u; i < c.size; ++i )
+      {
+        c.delay = std::max( c.delay, delays[c.leaves[i]] );
+        c.flow += flows[c.leaves[i]];
+      }
+      c.delay += 1u;
+      if constexpr ( ELA )
+      {
+        c.flow = static_cast<float>( cut_area_estimation( c ) );
+      }
+      else
+      {
+        c.flow += 1.0f;
+      }
+    }
+
+    keep_best_candidates( index, []( candidate const& c1, candidate const& c2 ) {
+      constexpr auto mf_eps{0.005f};
+      return c2.flow > c1.flow + mf_eps || ( c2.flow > c1.flow - mf_eps && c2.delay > c1.delay );
+    } );
+
+    if ( num_cuts[index] == 0u )
+      return;
+
+    if constexpr ( ELA )
+    {
+      if ( map_refs[index] > 0 )
+      {
+        cut_ref( best_cut( index ) );
+      }
+    }
+    else
+    {
+      map_refs[index] = 0;
+    }
+    delays[index] = candidates.front().delay;
+    flows[index] = candidates.front().flow / flow_refs[index];
+  }
+
+  /* merges two sorted leaf sets into `m`; stops and returns false as soon as
+   * the union has more than `cut_size` leaves, such that `m.leaves` is never
+   * written out of bounds */
+  bool merge_leaves( uint32_t const* first1, uint32_t const* last1, uint32_t const* first2, uint32_t const* last2, candidate& m ) const
+  {
+    m.size = 0u;
+    while ( first1 != last1 || first2 != last2 )
+    {
+      if ( m.size == cut_size )
+      {
+        return false;
+      }
+
+      if ( first2 == last2 || ( first1 != last1 && *first1 < *first2 ) )
+      {
+        m.leaves[m.size++] = *first1++;
+      }
+      else if ( first1 == last1 || *first2 < *first1 )
+      {
+        m.leaves[m.size++] = *first2++;
+      }
+      else
+      {
+        m.leaves[m.size++] = *first1++;
+        ++first2;
+      }
+    }
+    return true;
+  }
+
+  /* merges the priority cuts of the fanins (and the current priority cuts of
+   * the node) into `candidates`, removing duplicated and dominated cuts */
+  void compute_candidates( node<Ntk> const& n, uint32_t index )
+  {
+    candidates.clear();
+    candidates.emplace_back();
+
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      auto const fanin = ntk.node_to_index( ntk.get_node( f ) );
+
+      merged.clear();
+      auto const merge_with = [&]( uint32_t const* first, uint32_t const* last, uint64_t signature ) {
+        for ( auto const& c : candidates )
+        {
+          auto& m = merged.emplace_back();
+          if ( !merge_leaves( c.leaves.data(), c.leaves.data() + c.size, first, last, m ) )
+          {
+            merged.pop_back();
+            continue;
+          }
+          m.signature = c.signature | signature;
+        }
+      };
+
+      /* the trivial cut of the fanin and its priority cuts */
+      if ( !ntk.is_constant( ntk.get_node( f ) ) )
+      {
+        merge_with( &fanin, &fanin + 1, uint64_t( 1 ) << ( fanin % 64u ) );
+      }
+      for ( auto i = 0u; i < num_cuts[fanin]; ++i )
+      {
+        auto const cut = get_cut( fanin, i );
+        merge_with( cut.begin(), cut.end(), compute_signature( cut ) );
+      }
+
+      std::swap( candidates, merged );
+    } );
+
+    /* keep the current cuts of the node */
+    for ( auto i = 0u; i < num_cuts[index]; ++i )
+    {
+      auto const cut = get_cut( index, i );
+      auto& c = candidates.emplace_back();
+      std::copy( cut.begin(), cut.end(), c.leaves.begin() );
+      c.size = static_cast<uint32_t>( std::distance( cut.begin(), cut.end() ) );
+      c.signature = compute_signature( cut );
+    }
+
+    /* remove duplicated and dominated cuts */
+    std::vector<bool> removed( candidates.size(), false );
+    for ( auto i = 0u; i < candidates.size(); ++i )
+    {
+      for ( auto j = 0u; j < candidates.size() && !removed[i]; ++j )
+      {
+        if ( i == j || removed[j] )
+          continue;
+
+        auto const& ci = candidates[i];
+        auto const& cj = candidates[j];
+        if ( cj.size > ci.size || ( cj.signature & ci.signature ) != cj.signature )
+          continue;
+        /* cj is a subset of ci; of two equal cuts, the first one is kept */
+        if ( std::includes( ci.leaves.begin(), ci.leaves.begin() + ci.size, cj.leaves.begin(), cj.leaves.begin() + cj.size ) && ( cj.size < ci.size || j < i ) )
+        {
+          removed[i] = true;
+        }
+      }
+    }
+
+    auto k = 0u;
+    for ( auto i = 0u; i < candidates.size(); ++i )
+    {
+      if ( !removed[i] )
+      {
+        candidates[k++] = candidates[i];
+      }
+    }
+    candidates.resize( k );
+  }
+
+  template<typename Leaves>
+  uint64_t compute_signature( Leaves const& cut ) const
+  {
+    uint64_t signature{0};
+    for ( auto leaf : cut )
+    {
+      signature |= uint64_t( 1 ) << ( leaf % 64u );
+    }
+    return signature;
+  }
+
+  /* moves the best `cut_limit` candidates (according to `less`) to the front
+   * of `candidates` and stores them as priority cuts of the node; cuts with
+   * a single leaf are only used if there are no other cuts */
+  template<typename Less>
+  void keep_best_candidates( uint32_t index, Less&& less )
+  {
+    auto const num_small = static_cast<uint32_t>( std::count_if( candidates.begin(), candidates.end(), []( auto const& c ) { return c.size == 1u; } ) );
+    if ( num_small < candidates.size() )
+    {
+      candidates.erase( std::remove_if( candidates.begin(), candidates.end(), []( auto const& c ) { return c.size == 1u; } ), candidates.end() );
+    }
+
+    auto const num = std::min<uint32_t>( cut_limit, static_cast<uint32_t>( candidates.size() ) );
+    for ( auto i = 0u; i < num; ++i )
+    {
+      auto best = i;
+      for ( auto j = i + 1u; j < candidates.size(); ++j )
+      {
+        if ( less( candidates[j], candidates[best] ) )
+        {
+          best = j;
+        }
+      }
+      std::swap( candidates[i], candidates[best] );
+
+      auto const slot = static_cast<std::size_t>( index ) * cut_limit + i;
+      std::copy( candidates[i].leaves.begin(), candidates[i].leaves.begin() + candidates[i].size, &leaves[slot * cut_size] );
+      sizes[slot] = static_cast<uint8_t>( candidates[i].size );
+    }
+    num_cuts[index] = static_cast<uint8_t>( num );
+  }
+
+  kitty::dynamic_truth_table cut_function( node<Ntk> const& n, cut_leaves const& cut )
+  {
+    std::unordered_map<uint32_t, kitty::dynamic_truth_table> values;
+    auto const num_vars = static_cast<uint32_t>( std::distance( cut.begin(), cut.end() ) );
+    auto i = 0u;
+    for ( auto leaf : cut )
+    {
+      kitty::dynamic_truth_table tt( num_vars );
+      kitty::create_nth_var( tt, i++ );
+      values.emplace( leaf, tt );
+    }
+
+    std::function<kitty::dynamic_truth_table const&( node<Ntk> const& )> compute = [&]( node<Ntk> const& v ) -> kitty::dynamic_truth_table const& {
+      auto const index = ntk.node_to_index( v );
+      if ( auto const it = values.find( index ); it != values.end() )
+      {
+        return it->second;
+      }
+      if ( ntk.is_constant( v ) )
+      {
+        return values.emplace( index, kitty::dynamic_truth_table( num_vars ) ).first->second;
+      }
+
+      std::vector<kitty::dynamic_truth_table> fanin_values;
+      ntk.foreach_fanin( v, [&]( auto const& f ) {
+        fanin_values.push_back( compute( ntk.get_node( f ) ) );
+      } );
+      return values.emplace( index, ntk.compute( v, fanin_values.begin(), fanin_values.end() ) ).first->second;
+    };
+
+    return compute( n );
+  }
+
+  void derive_mapping()
+  {
+    ntk.clear_mapping();
+
+    for ( auto const& n : top_order )
+    {
+      if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+        continue;
+
+      const auto index = ntk.node_to_index( n );
+      if ( map_refs[index] == 0 )
+        continue;
+
+      std::vector<node<Ntk>> nodes;
+      for ( auto const& l : best_cut( index ) )
+      {
+        nodes.push_back( ntk.index_to_node( l ) );
+      }
+      ntk.add_to_mapping( n, nodes.begin(), nodes.end() );
+
+      if constexpr ( StoreFunction )
+      {
+        ntk.set_cell_function( n, cut_function( n, best_cut( index ) ) );
+      }
+    }
+  }
+
+private:
+  Ntk& ntk;
+  lut_mapping_params const& ps;
+  lut_mapping_stats& st;
+
+  uint32_t const cut_size;  /* maximum number of leaves */
+  uint32_t const cut_limit; /* number of priority cuts per node */
+
+  uint32_t iteration{0}; /* current mapping iteration */
+  uint32_t delay{0};     /* current delay of the mapping */
+  uint32_t area{0};      /* current area of the mapping */
+
+  std::vector<node<Ntk>> top_order;
+  std::vector<float> flow_refs;
+  std::vector<uint32_t> map_refs;
+  std::vector<float> flows;
+  std::vector<uint32_t> delays;
+
+  /* priority cuts: `cut_limit` slots of `cut_size` leaves per node, best cut first */
+  std::vector<uint32_t> leaves;
+  std::vector<uint8_t> sizes;
+  std::vector<uint8_t> num_cuts;
+
+  std::vector<candidate> candidates; /* temporary vectors to merge cuts */
+  std::vector<candidate> merged;
+  std::vector<uint32_t> tmp_area;    /* temporary vector to compute exact area */
+};
+
 }; /* namespace detail */
 
 /*! \brief LUT mapping.
@@ -531,8 +1108,16 @@ void lut_mapping( Ntk& ntk, lut_mapping_params const& ps = {}, lut_mapping_stats
   static_assert( !StoreFunction || has_set_cell_function_v<Ntk>, "Ntk does not implement the set_cell_function method" );
 
   lut_mapping_stats st;
-  detail::lut_mapping_impl<Ntk, StoreFunction, CutData> p( ntk, ps, st );
-  p.run();
+  if ( ps.priority_cuts )
+  {
+    detail::lut_mapping_priority_impl<Ntk, StoreFunction> p( ntk, ps, st );
+    p.run();
+  }
+  else
+  {
+    detail::lut_mapping_impl<Ntk, StoreFunction, CutData> p( ntk, ps, st );
+    p.run();
+  }
   if ( ps.verbose )
   {
     st.report();
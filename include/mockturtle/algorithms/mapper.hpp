@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 
@@ -39,8 +40,10 @@
 
 #include "../networks/klut.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/npn4_table.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../utils/tech_library.hpp"
+#include "../views/binding_view.hpp"
 #include "../views/depth_view.hpp"
 #include "../views/topo_view.hpp"
 #include "cut_enumeration.hpp"
@@ -95,6 +98,28 @@ struct map_params
   /*! \brief Maximum number of cuts evaluated for logic sharing. */
   uint32_t logic_sharing_cut_limit{ 8u };
 
+  /*! \brief Use a load-dependent delay model.
+   *
+   * The delay of a gate grows with its output load by the fanout delays of
+   * its pins (see `binding_view`).  The load of each node is estimated from
+   * the input loads of the pins it drives in the previous round, and from its
+   * fanout size in the first round.
+   */
+  bool load_dependent_delay{ false };
+
+  /*! \brief Load of each primary output for the load-dependent delay model. */
+  double output_load{ 0.0 };
+
+  /*! \brief Number of threads.
+   *
+   * If larger than 1, technology mapping (`map`) runs cut enumeration, cut
+   * matching, and the delay and area flow rounds level by level in parallel.
+   * Exact area and switching power rounds remain sequential.  The result is
+   * identical to the sequential run.  The network must support concurrent
+   * calls to its const methods.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 };
@@ -167,6 +192,8 @@ struct node_match_tech
   double required[2];
   /* area of the best matches */
   float area[2];
+  /* estimated output load of both phases */
+  float load[2] = { 0.0f, 0.0f };
 
   /* number of references in the cover 0: pos, 1: neg, 2: pos+neg */
   uint32_t map_refs[3];
@@ -182,7 +209,7 @@ class tech_map_impl
 public:
   using network_cuts_t = fast_network_cuts<Ntk, CutSize, true, CutData>;
   using cut_t = typename network_cuts_t::cut_t;
-  using supergate_t = std::array<std::vector<supergate<NInputs>> const*, 2>;
+  using supergate_t = std::array<supergate_list<NInputs> const*, 2>;
   using klut_map = std::unordered_map<uint32_t, std::array<signal<klut_network>, 2>>;
 
 public:
@@ -192,11 +219,12 @@ public:
         ps( ps ),
         st( st ),
         node_match( ntk.size() ),
-        matches(),
+        matches( ntk.size() ),
         switch_activity( ps.eswp_rounds ? switching_activity( ntk, ps.switching_activity_patterns ) : std::vector<float>( 0 ) ),
-        cuts( fast_cut_enumeration<Ntk, CutSize, true, CutData>( ntk, ps.cut_enumeration_ps, &st.cut_enumeration_st ) )
+        cuts( fast_cut_enumeration<Ntk, CutSize, true, CutData>( ntk, cut_enumeration_ps( ps ), &st.cut_enumeration_st ) )
   {
     std::tie( lib_inv_area, lib_inv_delay, lib_inv_id ) = library.get_inverter_info();
+    std::tie( lib_inv_input_load, lib_inv_fanout_delay ) = library.get_inverter_load_info();
   }
 
   explicit tech_map_impl( Ntk const& ntk, tech_library<NInputs> const& library, std::vector<float> const& switch_activity, map_params const& ps, map_stats& st )
@@ -205,14 +233,15 @@ public:
         ps( ps ),
         st( st ),
         node_match( ntk.size() ),
-        matches(),
+        matches( ntk.size() ),
         switch_activity( switch_activity ),
-        cuts( fast_cut_enumeration<Ntk, NInputs, true, CutData>( ntk, ps.cut_enumeration_ps, &st.cut_enumeration_st ) )
+        cuts( fast_cut_enumeration<Ntk, NInputs, true, CutData>( ntk, cut_enumeration_ps( ps ), &st.cut_enumeration_st ) )
   {
     std::tie( lib_inv_area, lib_inv_delay, lib_inv_id ) = library.get_inverter_info();
+    std::tie( lib_inv_input_load, lib_inv_fanout_delay ) = library.get_inverter_load_info();
   }
 
-  klut_network run()
+  binding_view<klut_network> run()
   {
     stopwatch t( st.time_mapping );
 
@@ -224,6 +253,12 @@ public:
       top_order.push_back( n );
     } );
 
+    /* group nodes by level for parallel matching */
+    if ( ps.num_threads > 1u )
+    {
+      levels = nodes_by_level( ntk );
+    }
+
     /* match cuts with gates */
     compute_matches();
 
@@ -269,6 +304,12 @@ public:
       }
     }
 
+    /* update the arrival times with the loads of the final cover */
+    if ( ps.load_dependent_delay )
+    {
+      compute_cover_arrival();
+    }
+
     /* generate the output network */
     finalize_cover( res, old2new );
 
@@ -283,6 +324,7 @@ private:
       auto& node_data = node_match[index];
 
       node_data.est_refs[0] = node_data.est_refs[1] = node_data.est_refs[2] = static_cast<float>( ntk.fanout_size( n ) );
+      node_data.load[0] = node_data.load[1] = static_cast<float>( ntk.fanout_size( n ) ) * lib_inv_input_load;
 
       if ( ntk.is_constant( n ) )
       {
@@ -297,15 +339,47 @@ private:
         node_data.flows[0] = node_data.flows[1] = node_data.flows[2] = 0.0f;
         node_data.arrival[0] = 0.0f;
         /* PIs have the negative phase implemented with an inverter */
-        node_data.arrival[1] = lib_inv_delay;
+        node_data.arrival[1] = inv_delay( node_data.load[1] );
       }
     } );
   }
 
+  static cut_enumeration_params cut_enumeration_ps( map_params const& ps )
+  {
+    auto cps = ps.cut_enumeration_ps;
+    cps.num_threads = std::max( cps.num_threads, ps.num_threads );
+    return cps;
+  }
+
+  /* Calls `fn( n )` for all gates in topological order, or level by level
+   * in parallel if multiple threads are used. */
+  template<typename Fn>
+  void foreach_gate_ordered( Fn&& fn )
+  {
+    if ( ps.num_threads > 1u )
+    {
+      foreach_node_level_parallel( levels, ps.num_threads, [&]( auto const& n, auto ) {
+        if ( !ntk.is_constant( n ) && !ntk.is_pi( n ) )
+        {
+          fn( n );
+        }
+      } );
+      return;
+    }
+
+    for ( auto const& n : top_order )
+    {
+      if ( !ntk.is_constant( n ) && !ntk.is_pi( n ) )
+      {
+        fn( n );
+      }
+    }
+  }
+
   void compute_matches()
   {
-    /* match gates */
-    ntk.foreach_gate( [&]( auto const& n ) {
+    /* match gates (matches of different gates are independent) */
+    foreach_gate_ordered( [&]( auto const& n ) {
       const auto index = ntk.node_to_index( n );
 
       std::vector<supergate_t> node_matches;
@@ -350,13 +424,8 @@ private:
   template<bool DO_AREA>
   bool compute_mapping()
   {
-    for ( auto const& n : top_order )
-    {
-      if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
-      {
-        continue;
-      }
-
+    /* a match only depends on the matches of its cut leaves */
+    foreach_gate_ordered( [&]( auto const& n ) {
       /* match positive phase */
       match_phase<DO_AREA>( n, 0u );
 
@@ -365,7 +434,7 @@ private:
 
       /* try to drop one phase */
       match_drop_phase<DO_AREA, false>( n, 0 );
-    }
+    } );
 
     double area_old = area;
     bool success = set_mapping_refs<false>();
@@ -575,10 +644,131 @@ private:
       node_match[i].est_refs[0] = coef * node_match[i].est_refs[0] + ( 1.0f - coef ) * std::max( 1.0f, static_cast<float>( node_match[i].map_refs[0] ) );
     }
 
+    if ( ps.load_dependent_delay )
+    {
+      compute_loads();
+    }
+
     ++iteration;
     return true;
   }
 
+  /* sets the output loads of the nodes to the input loads of the pins they drive in the cover */
+  void compute_loads()
+  {
+    for ( auto& node_data : node_match )
+    {
+      node_data.load[0] = node_data.load[1] = 0.0f;
+    }
+
+    ntk.foreach_po( [&]( auto const& s ) {
+      node_match[ntk.node_to_index( ntk.get_node( s ) )].load[ntk.is_complemented( s ) ? 1 : 0] += static_cast<float>( ps.output_load );
+    } );
+
+    ntk.foreach_node( [&]( auto const& n ) {
+      auto& node_data = node_match[ntk.node_to_index( n )];
+
+      if ( ntk.is_constant( n ) )
+        return;
+
+      /* PIs drive the inverter of the negative phase */
+      if ( ntk.is_pi( n ) )
+      {
+        if ( node_data.map_refs[1] > 0u )
+          node_data.load[0] += lib_inv_input_load;
+        return;
+      }
+
+      if ( node_data.map_refs[2] == 0u )
+        return;
+
+      unsigned use_phase = node_data.best_supergate[0] == nullptr ? 1u : 0u;
+      if ( node_data.same_match || node_data.map_refs[use_phase] > 0u )
+      {
+        add_leaf_loads( n, use_phase );
+        if ( node_data.same_match && node_data.map_refs[use_phase ^ 1] > 0u )
+          node_data.load[use_phase] += lib_inv_input_load;
+      }
+      if ( !node_data.same_match && node_data.map_refs[use_phase ^ 1] > 0u )
+      {
+        add_leaf_loads( n, use_phase ^ 1 );
+      }
+    } );
+
+    ntk.foreach_pi( [&]( auto const& n ) {
+      auto& node_data = node_match[ntk.node_to_index( n )];
+      node_data.arrival[1] = inv_delay( node_data.load[1] );
+    } );
+  }
+
+  void add_leaf_loads( node<Ntk> const& n, unsigned phase )
+  {
+    auto const index = ntk.node_to_index( n );
+    auto const& node_data = node_match[index];
+    auto const& supergate = *node_data.best_supergate[phase];
+
+    auto ctr = 0u;
+    for ( auto leaf : cuts.cuts( index )[node_data.best_cut[phase]] )
+    {
+      node_match[leaf].load[( node_data.phase[phase] >> ctr ) & 1] += supergate.input_load[ctr];
+      ++ctr;
+    }
+  }
+
+  /* recomputes the arrival times and the delay of the cover */
+  void compute_cover_arrival()
+  {
+    for ( auto const& n : top_order )
+    {
+      auto const index = ntk.node_to_index( n );
+      auto& node_data = node_match[index];
+
+      if ( ntk.is_constant( n ) || ntk.is_pi( n ) || node_data.map_refs[2] == 0u )
+        continue;
+
+      unsigned use_phase = node_data.best_supergate[0] == nullptr ? 1u : 0u;
+      for ( auto phase : { use_phase, use_phase ^ 1 } )
+      {
+        if ( node_data.same_match && phase != use_phase )
+        {
+          node_data.arrival[phase] = node_data.arrival[use_phase] + inv_delay( node_data.load[phase] );
+          continue;
+        }
+
+        auto const& supergate = *node_data.best_supergate[phase];
+        double arrival = 0.0f;
+        auto ctr = 0u;
+        for ( auto leaf : cuts.cuts( index )[node_data.best_cut[phase]] )
+        {
+          arrival = std::max( arrival, node_match[leaf].arrival[( node_data.phase[phase] >> ctr ) & 1] + pin_delay( supergate, ctr, node_data.load[phase] ) );
+          ++ctr;
+        }
+        node_data.arrival[phase] = arrival;
+      }
+    }
+
+    delay = 0.0f;
+    ntk.foreach_po( [&]( auto const& s ) {
+      delay = std::max( delay, node_match[ntk.node_to_index( ntk.get_node( s ) )].arrival[ntk.is_complemented( s ) ? 1 : 0] );
+    } );
+  }
+
+  /* delay from pin `pin` of a match to its output driving `load` */
+  inline double pin_delay( supergate<NInputs> const& gate, uint32_t pin, float load ) const
+  {
+    if ( ps.load_dependent_delay )
+      return gate.tdelay_loaded[pin] + gate.fanout_delay * load;
+    return gate.tdelay[pin];
+  }
+
+  /* delay of the inverter driving `load` */
+  inline double inv_delay( float load ) const
+  {
+    if ( ps.load_dependent_delay )
+      return lib_inv_delay + lib_inv_fanout_delay * load;
+    return lib_inv_delay;
+  }
+
   void compute_required_time()
   {
     for ( auto i = 0u; i < node_match.size(); ++i )
@@ -637,7 +827,7 @@ private:
       /* propagate required time over the output inverter if present */
       if ( node_data.same_match && node_data.map_refs[other_phase] > 0 )
       {
-        node_data.required[use_phase] = std::min( node_data.required[use_phase], node_data.required[other_phase] - lib_inv_delay );
+        node_data.required[use_phase] = std::min( node_data.required[use_phase], node_data.required[other_phase] - inv_delay( node_data.load[other_phase] ) );
       }
 
       if ( node_data.same_match || node_data.map_refs[use_phase] > 0 )
@@ -648,7 +838,7 @@ private:
         for ( auto leaf : best_cut )
         {
           auto phase = ( node_data.phase[use_phase] >> ctr ) & 1;
-          node_match[leaf].required[phase] = std::min( node_match[leaf].required[phase], node_data.required[use_phase] - supergate->tdelay[ctr] );
+          node_match[leaf].required[phase] = std::min( node_match[leaf].required[phase], node_data.required[use_phase] - pin_delay( *supergate, ctr, node_data.load[use_phase] ) );
           ++ctr;
         }
       }
@@ -661,7 +851,7 @@ private:
         for ( auto leaf : best_cut )
         {
           auto phase = ( node_data.phase[other_phase] >> ctr ) & 1;
-          node_match[leaf].required[phase] = std::min( node_match[leaf].required[phase], node_data.required[other_phase] - supergate->tdelay[ctr] );
+          node_match[leaf].required[phase] = std::min( node_match[leaf].required[phase], node_data.required[other_phase] - pin_delay( *supergate, ctr, node_data.load[other_phase] ) );
           ++ctr;
         }
       }
@@ -699,7 +889,7 @@ private:
       auto ctr = 0u;
       for ( auto l : cut )
       {
-        double arrival_pin = node_match[l].arrival[( best_phase >> ctr ) & 1] + best_supergate->tdelay[ctr];
+        double arrival_pin = node_match[l].arrival[( best_phase >> ctr ) & 1] + pin_delay( *best_supergate, ctr, node_data.load[phase] );
         best_arrival = std::max( best_arrival, arrival_pin );
         ++ctr;
       }
@@ -733,7 +923,7 @@ private:
         auto ctr = 0u;
         for ( auto l : *cut )
         {
-          double arrival_pin = node_match[l].arrival[( gate.polarity >> ctr ) & 1] + gate.tdelay[ctr];
+          double arrival_pin = node_match[l].arrival[( gate.polarity >> ctr ) & 1] + pin_delay( gate, ctr, node_data.load[phase] );
           worst_arrival = std::max( worst_arrival, arrival_pin );
           ++ctr;
         }
@@ -797,7 +987,7 @@ private:
       auto ctr = 0u;
       for ( auto l : cut )
       {
-        double arrival_pin = node_match[l].arrival[( best_phase >> ctr ) & 1] + best_supergate->tdelay[ctr];
+        double arrival_pin = node_match[l].arrival[( best_phase >> ctr ) & 1] + pin_delay( *best_supergate, ctr, node_data.load[phase] );
         best_arrival = std::max( best_arrival, arrival_pin );
         ++ctr;
       }
@@ -844,7 +1034,7 @@ private:
         auto ctr = 0u;
         for ( auto l : *cut )
         {
-          double arrival_pin = node_match[l].arrival[( gate.polarity >> ctr ) & 1] + gate.tdelay[ctr];
+          double arrival_pin = node_match[l].arrival[( gate.polarity >> ctr ) & 1] + pin_delay( gate, ctr, node_data.load[phase] );
           worst_arrival = std::max( worst_arrival, arrival_pin );
           ++ctr;
         }
@@ -887,8 +1077,8 @@ private:
     auto& node_data = node_match[index];
 
     /* compute arrival adding an inverter to the other match phase */
-    double worst_arrival_npos = node_data.arrival[1] + lib_inv_delay;
-    double worst_arrival_nneg = node_data.arrival[0] + lib_inv_delay;
+    double worst_arrival_npos = node_data.arrival[1] + inv_delay( node_data.load[0] );
+    double worst_arrival_nneg = node_data.arrival[0] + inv_delay( node_data.load[1] );
     bool use_zero = false;
     bool use_one = false;
 
@@ -957,12 +1147,12 @@ private:
             use_zero = true;
           }
           /* select the not used match instead if it leads to area improvement and doesn't violate the required time */
-          if ( node_data.arrival[nphase] + lib_inv_delay < node_data.required[phase] + epsilon )
+          if ( node_data.arrival[nphase] + inv_delay( node_data.load[phase] ) < node_data.required[phase] + epsilon )
           {
             auto size_phase = cuts.cuts( index )[node_data.best_cut[phase]].size();
             auto size_nphase = cuts.cuts( index )[node_data.best_cut[nphase]].size();
 
-            if ( compare_map<DO_AREA>( node_data.arrival[nphase] + lib_inv_delay, node_data.arrival[phase], node_data.flows[nphase] + lib_inv_area, node_data.flows[phase], size_nphase, size_phase ) )
+            if ( compare_map<DO_AREA>( node_data.arrival[nphase] + inv_delay( node_data.load[phase] ), node_data.arrival[phase], node_data.flows[nphase] + lib_inv_area, node_data.flows[phase], size_nphase, size_phase ) )
             {
               /* invert the choice */
               use_zero = !use_zero;
@@ -1246,9 +1436,9 @@ private:
     return count;
   }
 
-  std::pair<klut_network, klut_map> initialize_map_network()
+  std::pair<binding_view<klut_network>, klut_map> initialize_map_network()
   {
-    klut_network dest;
+    binding_view<klut_network> dest( library.get_gates() );
     klut_map old2new;
 
     old2new[ntk.node_to_index( ntk.get_node( ntk.get_constant( false ) ) )][0] = dest.get_constant( false );
@@ -1260,7 +1450,7 @@ private:
     return { dest, old2new };
   }
 
-  void finalize_cover( klut_network& res, klut_map& old2new )
+  void finalize_cover( binding_view<klut_network>& res, klut_map& old2new )
   {
     ntk.foreach_node( [&]( auto const& n ) {
       if ( ntk.is_constant( n ) )
@@ -1272,7 +1462,7 @@ private:
       if ( ntk.is_pi( n ) )
       {
         if ( node_match[index].map_refs[1] > 0 )
-          old2new[index][1] = res.create_not( old2new[n][0] );
+          old2new[index][1] = create_inverter( res, old2new[n][0] );
         return true;
       }
 
@@ -1290,7 +1480,7 @@ private:
 
         /* add inverted version if used */
         if ( node_data.same_match && node_data.map_refs[phase ^ 1] > 0 )
-          old2new[index][phase ^ 1] = res.create_not( old2new[index][phase] );
+          old2new[index][phase ^ 1] = create_inverter( res, old2new[index][phase] );
       }
 
       phase = phase ^ 1;
@@ -1323,11 +1513,10 @@ private:
     compute_gates_usage();
   }
 
-  void create_lut_for_gate( klut_network& res, klut_map& old2new, uint32_t index, unsigned phase )
+  void create_lut_for_gate( binding_view<klut_network>& res, klut_map& old2new, uint32_t index, unsigned phase )
   {
     auto const& node_data = node_match[index];
     auto& best_cut = cuts.cuts( index )[node_data.best_cut[phase]];
-    auto const gate = node_data.best_supergate[phase]->root;
     // auto tt = cuts.truth_table( best_cut );
 
     /* check correctness */
@@ -1351,13 +1540,54 @@ private:
       children[node_data.best_supergate[phase]->permutation[ctr]] = old2new[l][( node_data.phase[phase] >> ctr ) & 1];
       ++ctr;
     }
-    /* create the node */
-    auto f = res.create_node( children, gate->function );
+    /* create the gates of the supergate */
+    auto leaf = 0u;
+    auto f = create_composed_gate( res, *node_data.best_supergate[phase]->tree, children, leaf );
 
     /* add the node in the data structure */
     old2new[index][phase] = f;
   }
 
+  signal<klut_network> create_inverter( binding_view<klut_network>& res, signal<klut_network> const& f )
+  {
+    auto const inv = res.create_not( f );
+    if ( lib_inv_id != UINT32_MAX )
+      res.add_binding( res.get_node( inv ), lib_inv_id );
+    return inv;
+  }
+
+  signal<klut_network> create_composed_gate( binding_view<klut_network>& res, composed_gate<NInputs> const& g, std::vector<signal<klut_network>> const& leaves, uint32_t& leaf )
+  {
+    std::vector<signal<klut_network>> children( g.root->num_vars );
+    for ( auto i = 0u; i < g.root->num_vars; ++i )
+    {
+      if ( g.fanin[i] == composed_gate<NInputs>::leaf )
+      {
+        children[i] = leaves[leaf++];
+      }
+      else
+      {
+        children[i] = create_composed_gate( res, library.get_composed_gates()[g.fanin[i]], leaves, leaf );
+      }
+    }
+    auto const f = res.create_node( children, g.root->function );
+    if ( !res.is_constant( res.get_node( f ) ) )
+      res.add_binding( res.get_node( f ), g.root->id );
+    return f;
+  }
+
+  void count_composed_gate( composed_gate<NInputs> const& g, std::vector<uint32_t>& gates_profile )
+  {
+    ++gates_profile[g.root->id];
+    for ( auto i = 0u; i < g.root->num_vars; ++i )
+    {
+      if ( g.fanin[i] != composed_gate<NInputs>::leaf )
+      {
+        count_composed_gate( library.get_composed_gates()[g.fanin[i]], gates_profile );
+      }
+    }
+  }
+
   template<bool DO_AREA>
   inline bool compare_map( double arrival, double best_arrival, double area_flow, double best_area_flow, uint32_t size, uint32_t best_size )
   {
@@ -1437,7 +1667,7 @@ private:
 
       if ( node_data.same_match || node_data.map_refs[phase] > 0 )
       {
-        ++gates_profile[node_data.best_supergate[phase]->root->id];
+        count_composed_gate( *node_data.best_supergate[phase]->tree, gates_profile );
 
         if ( !ignore_inv && node_data.same_match && node_data.map_refs[phase ^ 1] > 0 )
           ++gates_profile[lib_inv_id];
@@ -1446,7 +1676,7 @@ private:
       phase = phase ^ 1;
       if ( !node_data.same_match && node_data.map_refs[phase] > 0 )
       {
-        ++gates_profile[node_data.best_supergate[phase]->root->id];
+        count_composed_gate( *node_data.best_supergate[phase]->tree, gates_profile );
       }
 
       return true;
@@ -1539,10 +1769,13 @@ private:
   float lib_inv_area;
   float lib_inv_delay;
   uint32_t lib_inv_id;
+  float lib_inv_input_load;
+  float lib_inv_fanout_delay;
 
   std::vector<node<Ntk>> top_order;
+  std::vector<std::vector<node<Ntk>>> levels;
   std::vector<node_match_tech<NInputs>> node_match;
-  std::unordered_map<uint32_t, std::vector<supergate_t>> matches;
+  std::vector<std::vector<supergate_t>> matches;
   std::vector<float> switch_activity;
   network_cuts_t cuts;
 };
@@ -1568,7 +1801,8 @@ private:
  * for one example of a CutData type that implements the cost function that is used in
  * the technology mapper.
  *
- * The function returns a k-LUT network. Each LUT abstacts a gate of the technology library.
+ * The function returns a k-LUT network. Each LUT abstacts a gate of the technology library
+ * and is bound to it (see `binding_view`).
  *
  * **Required network functions:**
  * - `size`
@@ -1590,7 +1824,7 @@ private:
  * mapping command ``map`` in ABC.
  */
 template<class Ntk, unsigned CutSize = 5u, typename CutData = cut_enumeration_tech_map_cut, unsigned NInputs>
-klut_network map( Ntk const& ntk, tech_library<NInputs> const& library, map_params const& ps = {}, map_stats* pst = nullptr )
+binding_view<klut_network> map( Ntk const& ntk, tech_library<NInputs> const& library, map_params const& ps = {}, map_stats* pst = nullptr )
 {
   static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
   static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
@@ -1758,6 +1992,18 @@ private:
     } );
   }
 
+  static auto npn_canonization( kitty::static_truth_table<NInputs> const& tt )
+  {
+    if constexpr ( NInputs == 4u )
+    {
+      return npn4_table::get().canonization( tt );
+    }
+    else
+    {
+      return kitty::exact_npn_canonization( tt );
+    }
+  }
+
   void compute_matches()
   {
     /* match gates */
@@ -1786,7 +2032,7 @@ private:
         /* match the cut using canonization and get the gates */
         const auto tt = cuts.truth_table( *cut );
         const auto fe = kitty::shrink_to<NInputs>( tt );
-        const auto config = kitty::exact_npn_canonization( fe );
+        const auto config = npn_canonization( fe );
         auto const supergates_npn = library.get_supergates( std::get<0>( config ) );
         auto const supergates_npn_neg = library.get_supergates( ~std::get<0>( config ) );
 
@@ -36,22 +36,60 @@
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/hash.hpp>
+#include <kitty/npn.hpp>
+#include <kitty/operations.hpp>
 #include <kitty/print.hpp>
 #include <kitty/traits.hpp>
 
 #include "../../networks/aig.hpp"
 #include "../../networks/xmg.hpp"
 #include "../../networks/klut.hpp"
+#include "../../utils/exact_synthesis_cache.hpp"
 #include "../../utils/include/percy.hpp"
 
 namespace mockturtle
 {
 
+namespace detail
+{
+
+/* chain of a function from the chain of its NPN representative, by mapping
+ * the inputs and folding their complementations into the operators */
+inline percy::chain npn_transform_lut_chain( percy::chain const& c, npn_inputs const& m )
+{
+  auto t = c;
+  for ( auto i = 0; i < c.get_nr_steps(); ++i )
+  {
+    auto step = c.get_step( i );
+    auto op = c.get_operator( i );
+    for ( auto j = 0u; j < step.size(); ++j )
+    {
+      if ( step[j] < c.get_nr_inputs() )
+      {
+        if ( ( m.neg >> step[j] ) & 1 )
+        {
+          kitty::flip_inplace( op, j );
+        }
+        step[j] = m.var[step[j]];
+      }
+    }
+    if ( m.output_neg && i + 1 == c.get_nr_steps() )
+    {
+      op = ~op;
+    }
+    t.set_step( i, step, op );
+  }
+  return t;
+}
+
+} // namespace detail
+
 struct exact_resynthesis_params
 {
   using cache_map_t = std::unordered_map<kitty::dynamic_truth_table, percy::chain, kitty::hash<kitty::dynamic_truth_table>>;
@@ -63,6 +101,10 @@ struct exact_resynthesis_params
   cache_t cache;
   blacklist_cache_t blacklist_cache;
 
+  /*! \brief Persistent cache of NPN representatives (used for functions
+   *         with at most 6 variables and without don't cares). */
+  std::shared_ptr<exact_synthesis_cache> disk_cache;
+
   bool add_alonce_clauses{true};
   bool add_colex_clauses{true};
   bool add_lex_clauses{false};
@@ -185,6 +227,25 @@ public:
         }
       }
 
+      /* chains in the disk cache are stored for the NPN representative */
+      std::optional<detail::npn_inputs> npn;
+      std::string const domain = "exact_klut_" + std::to_string( _fanin_size );
+      if ( !with_dont_cares && _ps.disk_cache && function.num_vars() <= 6u )
+      {
+        const auto [repr, phase, perm] = kitty::exact_npn_canonization( function );
+        npn = detail::npn_input_mapping( function.num_vars(), phase, perm );
+        if ( const auto chains = _ps.disk_cache->find( domain, repr ); chains && !chains->empty() )
+        {
+          auto const c = detail::npn_transform_lut_chain( chains->front(), *npn );
+          if ( _ps.cache )
+          {
+            ( *_ps.cache )[function] = c;
+          }
+          return c;
+        }
+        spec[0] = repr;
+      }
+
       percy::chain c;
       if ( const auto result = percy::synthesize( spec, c, _ps.solver_type,
                                              _ps.encoder_type,
@@ -198,6 +259,11 @@ public:
         return std::nullopt;
       }
       c.denormalize();
+      if ( npn )
+      {
+        _ps.disk_cache->insert( domain, spec[0], {c} );
+        c = detail::npn_transform_lut_chain( c, *npn );
+      }
       if ( !with_dont_cares && _ps.cache )
       {
         ( *_ps.cache )[function] = c;
@@ -338,6 +404,7 @@ public:
       spec.add_function( f.second );
     }
 
+    std::optional<detail::npn_inputs> npn;
     auto c = [&]() -> std::optional<percy::chain> {
       if ( !with_dont_cares && _ps.cache )
       {
@@ -356,6 +423,19 @@ public:
         }
       }
 
+      /* chains in the disk cache are stored for the NPN representative */
+      std::string const domain = _allow_xor ? "exact_xag" : "exact_aig";
+      if ( !with_dont_cares && _ps.disk_cache && existing_functions.empty() && function.num_vars() <= 6u )
+      {
+        const auto [repr, phase, perm] = kitty::exact_npn_canonization( function );
+        npn = detail::npn_input_mapping( function.num_vars(), phase, perm );
+        if ( const auto chains = _ps.disk_cache->find( domain, repr ); chains && !chains->empty() )
+        {
+          return chains->front();
+        }
+        spec[0] = repr;
+      }
+
       percy::chain c;
       if ( const auto result = percy::synthesize( spec, c, _ps.solver_type,
                                                   _ps.encoder_type,
@@ -369,9 +449,13 @@ public:
         return std::nullopt;
       }
 
-      assert( kitty::to_hex( c.simulate()[0u] ) == kitty::to_hex( function ) );
+      assert( kitty::to_hex( c.simulate()[0u] ) == kitty::to_hex( spec[0] ) );
 
-      if ( !with_dont_cares && _ps.cache )
+      if ( npn )
+      {
+        _ps.disk_cache->insert( domain, spec[0], {c} );
+      }
+      else if ( !with_dont_cares && _ps.cache )
       {
         ( *_ps.cache )[function] = c;
       }
@@ -388,6 +472,14 @@ public:
     {
       signals.emplace_back( f.first );
     }
+    if ( npn )
+    {
+      std::vector<signal> const leaves( begin, end );
+      for ( auto i = 0u; i < npn->var.size(); ++i )
+      {
+        signals[i] = ( ( npn->neg >> i ) & 1 ) ? !leaves[npn->var[i]] : leaves[npn->var[i]];
+      }
+    }
 
     for ( auto i = 0; i < c->get_nr_steps(); ++i )
     {
@@ -418,7 +510,7 @@ public:
       }
     }
 
-    fn( c->is_output_inverted( 0 ) ? !signals.back() : signals.back() );
+    fn( c->is_output_inverted( 0 ) != ( npn && npn->output_neg ) ? !signals.back() : signals.back() );
   }
 
   void set_bounds( std::optional<uint32_t> const& lower_bound, std::optional<uint32_t> const& upper_bound )
@@ -443,6 +535,10 @@ struct exact_xmg_resynthesis_params
   bool use_only_self_dual_gates{false};
   bool use_xor3{true};
   int conflict_limit{0};
+
+  /*! \brief Persistent cache of NPN representatives (used for functions
+   *         with at most 6 variables). */
+  std::shared_ptr<exact_synthesis_cache> disk_cache;
 };
 
 /*! \brief Resynthesis function based on exact synthesis for XMGs.
@@ -486,6 +582,59 @@ public:
 
     using signal = mockturtle::signal<Ntk>;
     auto const tt = function.num_vars() < 3u ? kitty::extend_to( function, 3u ) : function;
+
+    std::vector<signal> signals( tt.num_vars(), ntk.get_constant( false ) );
+    std::copy( begin, end, signals.begin() );
+
+    if ( ps.disk_cache && tt.num_vars() <= 6u )
+    {
+      /* chains in the disk cache are stored for the NPN representative */
+      const auto [repr, phase, perm] = kitty::exact_npn_canonization( tt );
+      auto const npn = detail::npn_input_mapping( tt.num_vars(), phase, perm );
+      auto const domain = "exact_xmg_" + std::to_string( ps.num_candidates ) + ( ps.use_only_self_dual_gates ? "_sd" : "" ) + ( ps.use_xor3 ? "_xor3" : "" );
+
+      auto chains = ps.disk_cache->find( domain, repr );
+      if ( !chains )
+      {
+        chains.emplace();
+        foreach_chain( repr, [&]( percy::chain const& chain ) {
+          chains->push_back( chain );
+          return true;
+        } );
+        if ( !chains->empty() )
+        {
+          ps.disk_cache->insert( domain, repr, *chains );
+        }
+      }
+
+      std::vector<signal> inputs( tt.num_vars() );
+      for ( auto i = 0u; i < inputs.size(); ++i )
+      {
+        inputs[i] = ( ( npn.neg >> i ) & 1 ) ? !signals[npn.var[i]] : signals[npn.var[i]];
+      }
+      bool const normal = kitty::is_normal( repr );
+      for ( auto const& chain : *chains )
+      {
+        auto const output_signal = build( ntk, chain, inputs, normal );
+        if ( !fn( npn.output_neg ? !output_signal : output_signal ) )
+        {
+          return; /* quit */
+        }
+      }
+      return;
+    }
+
+    bool const normal = kitty::is_normal( tt );
+    foreach_chain( tt, [&]( percy::chain const& chain ) {
+      return fn( build( ntk, chain, signals, normal ) );
+    } );
+  }
+
+private:
+  /* calls `fn` on up to `num_candidates` optimum chains of `tt` (of its complement if `tt` is not normal) */
+  template<typename TT, typename Fn>
+  void foreach_chain( TT const& tt, Fn&& fn ) const
+  {
     bool const normal = kitty::is_normal( tt );
 
     percy::chain chain;
@@ -550,99 +699,100 @@ public:
         break;
 
       assert( result == percy::success );
-
-      auto const sim = chain.simulate();
       assert( chain.simulate()[0] == spec[0] );
 
-      std::vector<signal> signals( tt.num_vars(), ntk.get_constant( false ) );
-      std::copy( begin, end, signals.begin() );
-
-      for ( auto i = 0; i < chain.get_nr_steps(); ++i )
+      if ( !fn( chain ) )
       {
-        auto const c1 = signals[chain.get_step( i )[0]];
-        auto const c2 = signals[chain.get_step( i )[1]];
-        auto const c3 = signals[chain.get_step( i )[2]];
-
-        switch( chain.get_operator( i )._bits[0] )
-        {
-        case 0x00:
-          signals.emplace_back( ntk.get_constant( false ) );
-          break;
-        case 0xe8:
-          signals.emplace_back( ntk.create_maj( c1,  c2,  c3 ) );
-          break;
-        case 0xd4:
-          signals.emplace_back( ntk.create_maj( !c1,  c2,  c3 ) );
-          break;
-        case 0xb2:
-          signals.emplace_back( ntk.create_maj( c1,  !c2,  c3 ) );
-          break;
-        case 0x8e:
-          signals.emplace_back( ntk.create_maj( c1,  c2,  !c3 ) );
-          break;
-        case 0x96:
-          signals.emplace_back( ntk.create_xor3( c1,  c2,  c3 ) );
-          break;
-        case 0xc0:
-          signals.emplace_back( ntk.create_maj(  ntk.get_constant( false ),  c2,  c3 ) ); // c0
-          break;
-        case 0xfc:
-          signals.emplace_back( ntk.create_maj( !ntk.get_constant( false ),  c2,  c3 ) ); // fc
-          break;
-        case 0x30:
-          signals.emplace_back( ntk.create_maj(  ntk.get_constant( false ), !c2,  c3 ) ); // 30
-          break;
-        case 0x0c:
-          signals.emplace_back( ntk.create_maj(  ntk.get_constant( false ),  c2, !c3 ) ); // 0c
-          break;
-        case 0xa0:
-          signals.emplace_back( ntk.create_maj(   c1,  ntk.get_constant( false ),  c3 ) ); // 0a
-          break;
-        case 0x50:
-          signals.emplace_back( ntk.create_maj(  !c1,  ntk.get_constant( false ),  c3 ) ); // 50
-          break;
-        case 0xfa:
-          signals.emplace_back( ntk.create_maj(   c1, !ntk.get_constant( false ),  c3 ) ); // fa
-          break;
-        case 0x0a:
-          signals.emplace_back( ntk.create_maj(   c1,  ntk.get_constant( false ), !c3 ) ); // 0a
-          break;
-        case 0x88:
-          signals.emplace_back( ntk.create_maj(   c1,  c2,  ntk.get_constant( false ) ) ); // 88
-          break;
-        case 0xee:
-          signals.emplace_back( ntk.create_maj(   c1,  c2, !ntk.get_constant( false ) ) ); // ee
-          break;
-        case 0x44:
-          signals.emplace_back( ntk.create_maj(  !c1,  c2,  ntk.get_constant( false ) ) ); // 44
-          break;
-        case 0x22:
-          signals.emplace_back( ntk.create_maj(   c1, !c2,  ntk.get_constant( false ) ) ); // 22
-          break;
-        case 0x66:
-          signals.emplace_back( ntk.create_xor( c1, c2 ) );
-          break;
-        case 0x3c:
-          signals.emplace_back( ntk.create_xor( c2, c3 ) );
-          break;
-        case 0x5a:
-          signals.emplace_back( ntk.create_xor( c1, c3 ) );
-          break;
-        default:
-          std::cerr << "[e] unsupported operation " << kitty::to_hex( chain.get_operator( i ) ) << "\n";
-          assert( false );
-          break;
-        }
+        return; /* quit */
       }
+    }
+  }
+
+  signal<Ntk> build( Ntk& ntk, percy::chain const& chain, std::vector<signal<Ntk>> signals, bool normal ) const
+  {
+    for ( auto i = 0; i < chain.get_nr_steps(); ++i )
+    {
+      auto const c1 = signals[chain.get_step( i )[0]];
+      auto const c2 = signals[chain.get_step( i )[1]];
+      auto const c3 = signals[chain.get_step( i )[2]];
 
-      assert( chain.get_outputs().size() > 0u );
-      uint32_t const output_index = ( chain.get_outputs()[0u] >> 1u );
-      auto const output_signal = output_index == 0u ? ntk.get_constant( false ) : signals[output_index - 1];
-      if ( !fn( chain.is_output_inverted( 0 ) ^ normal ? output_signal : !output_signal ) )
+      switch( chain.get_operator( i )._bits[0] )
       {
-        return; /* quit */
+      case 0x00:
+        signals.emplace_back( ntk.get_constant( false ) );
+        break;
+      case 0xe8:
+        signals.emplace_back( ntk.create_maj( c1,  c2,  c3 ) );
+        break;
+      case 0xd4:
+        signals.emplace_back( ntk.create_maj( !c1,  c2,  c3 ) );
+        break;
+      case 0xb2:
+        signals.emplace_back( ntk.create_maj( c1,  !c2,  c3 ) );
+        break;
+      case 0x8e:
+        signals.emplace_back( ntk.create_maj( c1,  c2,  !c3 ) );
+        break;
+      case 0x96:
+        signals.emplace_back( ntk.create_xor3( c1,  c2,  c3 ) );
+        break;
+      case 0xc0:
+        signals.emplace_back( ntk.create_maj(  ntk.get_constant( false ),  c2,  c3 ) ); // c0
+        break;
+      case 0xfc:
+        signals.emplace_back( ntk.create_maj( !ntk.get_constant( false ),  c2,  c3 ) ); // fc
+        break;
+      case 0x30:
+        signals.emplace_back( ntk.create_maj(  ntk.get_constant( false ), !c2,  c3 ) ); // 30
+        break;
+      case 0x0c:
+        signals.emplace_back( ntk.create_maj(  ntk.get_constant( false ),  c2, !c3 ) ); // 0c
+        break;
+      case 0xa0:
+        signals.emplace_back( ntk.create_maj(   c1,  ntk.get_constant( false ),  c3 ) ); // 0a
+        break;
+      case 0x50:
+        signals.emplace_back( ntk.create_maj(  !c1,  ntk.get_constant( false ),  c3 ) ); // 50
+        break;
+      case 0xfa:
+        signals.emplace_back( ntk.create_maj(   c1, !ntk.get_constant( false ),  c3 ) ); // fa
+        break;
+      case 0x0a:
+        signals.emplace_back( ntk.create_maj(   c1,  ntk.get_constant( false ), !c3 ) ); // 0a
+        break;
+      case 0x88:
+        signals.emplace_back( ntk.create_maj(   c1,  c2,  ntk.get_constant( false ) ) ); // 88
+        break;
+      case 0xee:
+        signals.emplace_back( ntk.create_maj(   c1,  c2, !ntk.get_constant( false ) ) ); // ee
+        break;
+      case 0x44:
+        signals.emplace_back( ntk.create_maj(  !c1,  c2,  ntk.get_constant( false ) ) ); // 44
+        break;
+      case 0x22:
+        signals.emplace_back( ntk.create_maj(   c1, !c2,  ntk.get_constant( false ) ) ); // 22
+        break;
+      case 0x66:
+        signals.emplace_back( ntk.create_xor( c1, c2 ) );
+        break;
+      case 0x3c:
+        signals.emplace_back( ntk.create_xor( c2, c3 ) );
+        break;
+      case 0x5a:
+        signals.emplace_back( ntk.create_xor( c1, c3 ) );
+        break;
+      default:
+        std::cerr << "[e] unsupported operation " << kitty::to_hex( chain.get_operator( i ) ) << "\n";
+        assert( false );
+        break;
       }
     }
+
+
+    assert( chain.get_outputs().size() > 0u );
+    uint32_t const output_index = ( chain.get_outputs()[0u] >> 1u );
+    auto const output_signal = output_index == 0u ? ntk.get_constant( false ) : signals[output_index - 1];
+    return ( chain.get_outputs()[0u] & 1 ) ^ normal ? output_signal : !output_signal;
   }
 
 protected:
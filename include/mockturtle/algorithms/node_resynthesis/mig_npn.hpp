@@ -45,6 +45,7 @@
 #include "../../algorithms/cleanup.hpp"
 #include "../../networks/mig.hpp"
 #include "../../traits.hpp"
+#include "../../utils/npn4_table.hpp"
 #include "../../views/topo_view.hpp"
 
 namespace mockturtle
@@ -93,10 +94,10 @@ public:
   void operator()( mig_network& mig, kitty::dynamic_truth_table const& function, LeavesIterator begin, LeavesIterator end, Fn&& fn ) const
   {
     assert( function.num_vars() <= 4 );
-    const auto fe = kitty::extend_to( function, 4 );
-    const auto config = kitty::exact_npn_canonization( fe );
+    const auto fe = kitty::extend_to<4u>( function );
+    const auto config = npn4_table::get().canonization( fe );
 
-    const auto it = class2signal.find( static_cast<uint16_t>( std::get<0>( config )._bits[0] ) );
+    const auto it = class2signal.find( static_cast<uint16_t>( *std::get<0>( config ).cbegin() ) );
 
     std::vector<mig_network::signal> pis( 4, mig.get_constant( false ) );
     std::copy( begin, end, pis.begin() );
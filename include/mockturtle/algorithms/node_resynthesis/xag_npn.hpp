@@ -49,6 +49,7 @@
 #include "../../networks/xag.hpp"
 #include "../../utils/index_list.hpp"
 #include "../../utils/node_map.hpp"
+#include "../../utils/npn4_table.hpp"
 #include "../../utils/stopwatch.hpp"
 
 namespace mockturtle
@@ -82,6 +83,52 @@ enum class xag_npn_db_kind : uint32_t
   aig_complete = 2,
 };
 
+namespace detail
+{
+
+/* decoded database of `xag_npn_resynthesis`, shared by all instances */
+template<class DatabaseNtk, xag_npn_db_kind DBKind>
+struct xag_npn_database
+{
+  using repr_map_t = std::unordered_map<kitty::static_truth_table<4u>, std::vector<signal<DatabaseNtk>>, kitty::hash<kitty::static_truth_table<4u>>>;
+
+  xag_npn_database( uint32_t const* begin, uint32_t const* end )
+  {
+    decode( db, xag_index_list{std::vector<uint32_t>{begin, end}} );
+
+    auto const& npn4 = npn4_table::get();
+    const auto sim_res = simulate_nodes<kitty::static_truth_table<4u>>( db );
+
+    db.foreach_node( [&]( auto n ) {
+      if ( npn4.representative( sim_res[n] ) == sim_res[n] )
+      {
+        repr_to_signal[sim_res[n]].push_back( db.make_signal( n ) );
+      }
+      else
+      {
+        const auto f = ~sim_res[n];
+        if ( npn4.representative( f ) == f )
+        {
+          repr_to_signal[f].push_back( !db.make_signal( n ) );
+        }
+      }
+    } );
+  }
+
+  /* Returns the database, which is decoded from the index list in [begin, end)
+   * on the first call.  All calls must pass the same index list. */
+  static xag_npn_database const& get( uint32_t const* begin, uint32_t const* end )
+  {
+    static const xag_npn_database database( begin, end );
+    return database;
+  }
+
+  DatabaseNtk db;
+  repr_map_t repr_to_signal;
+};
+
+} /* namespace detail */
+
 /*! \brief Resynthesis function based on pre-computed AIGs.
  *
  * This resynthesis function can be passed to ``cut_rewriting``.  It will
@@ -112,7 +159,10 @@ public:
   xag_npn_resynthesis( xag_npn_resynthesis_params const& ps = {}, xag_npn_resynthesis_stats* pst = nullptr )
       : ps( ps ),
         pst( pst ),
-        _repr( 1u << 16u )
+        _npn4( call_with_stopwatch( st.time_classes, []() -> npn4_table const& { return npn4_table::get(); } ) ),
+        _database( call_with_stopwatch( st.time_db, []() -> auto const& { return database(); } ) ),
+        _repr_to_signal( _database.repr_to_signal ),
+        _db( _database.db )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
@@ -132,8 +182,8 @@ public:
     static_assert( has_foreach_node_v<DatabaseNtk>, "DatabaseNtk does not implement the foreach_node method" );
     static_assert( has_make_signal_v<DatabaseNtk>, "DatabaseNtk does not implement the make_signal method" );
 
-    build_classes();
-    build_db();
+    st.db_size = _db.size();
+    st.covered_classes = static_cast<uint32_t>( _repr_to_signal.size() );
   }
 
   virtual ~xag_npn_resynthesis()
@@ -155,7 +205,7 @@ public:
     kitty::static_truth_table<4u> tt = kitty::extend_to<4u>( function );
 
     /* get representative of function */
-    const auto [repr, phase, perm] = _repr[*tt.cbegin()];
+    const auto [repr, phase, perm] = _npn4.canonization( tt );
 
     /* check if representative has circuits */
     const auto it = _repr_to_signal.find( repr );
@@ -204,76 +254,30 @@ private:
     return f;
   }
 
-  void build_classes()
-  {
-    stopwatch t( st.time_classes );
-
-    kitty::static_truth_table<4u> tt;
-    do {
-      _repr[*tt.cbegin()] = kitty::exact_npn_canonization( tt );
-      kitty::next_inplace( tt );
-    } while ( !kitty::is_const0( tt ) );
-  }
-
-  void build_db()
+  static detail::xag_npn_database<DatabaseNtk, DBKind> const& database()
   {
-    stopwatch t( st.time_db );
-
     if constexpr ( DBKind == xag_npn_db_kind::xag_incomplete )
     {
-      decode( _db, xag_index_list{std::vector<uint32_t>{subgraphs, subgraphs + sizeof subgraphs / sizeof subgraphs[0]}} );
+      return detail::xag_npn_database<DatabaseNtk, DBKind>::get( subgraphs, subgraphs + sizeof subgraphs / sizeof subgraphs[0] );
     }
     else if constexpr ( DBKind == xag_npn_db_kind::xag_complete )
     {
-      decode( _db, xag_index_list{std::vector<uint32_t>{subgraphs_xag, subgraphs_xag + sizeof subgraphs_xag / sizeof subgraphs_xag[0]}} );
+      return detail::xag_npn_database<DatabaseNtk, DBKind>::get( subgraphs_xag, subgraphs_xag + sizeof subgraphs_xag / sizeof subgraphs_xag[0] );
     }
-    else if constexpr ( DBKind == xag_npn_db_kind::aig_complete )
+    else
     {
-      decode( _db, xag_index_list{std::vector<uint32_t>{subgraphs_aig, subgraphs_aig + sizeof subgraphs_aig / sizeof subgraphs_aig[0]}} );
+      return detail::xag_npn_database<DatabaseNtk, DBKind>::get( subgraphs_aig, subgraphs_aig + sizeof subgraphs_aig / sizeof subgraphs_aig[0] );
     }
-    const auto sim_res = simulate_nodes<kitty::static_truth_table<4u>>( _db );
-
-    _db.foreach_node( [&]( auto n ) {
-      if ( std::get<0>( _repr[*sim_res[n].cbegin()] ) == sim_res[n] )
-      {
-        if ( _repr_to_signal.count( sim_res[n] ) == 0 )
-        {
-          _repr_to_signal.insert( {sim_res[n], {_db.make_signal( n )}} );
-        }
-        else
-        {
-          _repr_to_signal[sim_res[n]].push_back( _db.make_signal( n ) );
-        }
-      }
-      else
-      {
-        const auto f = ~sim_res[n];
-        if ( std::get<0>( _repr[*f.cbegin()] ) == f )
-        {
-          if ( _repr_to_signal.count( f ) == 0 )
-          {
-            _repr_to_signal.insert( {f, {!_db.make_signal( n )}} );
-          }
-          else
-          {
-            _repr_to_signal[f].push_back( !_db.make_signal( n ) );
-          }
-        }
-      }
-    } );
-
-    st.db_size = _db.size();
-    st.covered_classes = static_cast<uint32_t>( _repr_to_signal.size() );
   }
 
   xag_npn_resynthesis_params ps;
   xag_npn_resynthesis_stats st;
   xag_npn_resynthesis_stats* pst{nullptr};
 
-  std::vector<std::tuple<kitty::static_truth_table<4u>, uint32_t, std::vector<uint8_t>>> _repr;
-  std::unordered_map<kitty::static_truth_table<4u>, std::vector<signal<DatabaseNtk>>, kitty::hash<kitty::static_truth_table<4u>>> _repr_to_signal;
-
-  DatabaseNtk _db;
+  npn4_table const& _npn4;
+  detail::xag_npn_database<DatabaseNtk, DBKind> const& _database;
+  typename detail::xag_npn_database<DatabaseNtk, DBKind>::repr_map_t const& _repr_to_signal;
+  DatabaseNtk const& _db;
 
   // clang-format off
   /* complete XAG database */
@@ -50,6 +50,7 @@
 #include "../../io/write_bench.hpp"
 #include "../../networks/xmg.hpp"
 #include "../../utils/node_map.hpp"
+#include "../../utils/npn4_table.hpp"
 #include "../../utils/stopwatch.hpp"
 #include "../../views/topo_view.hpp"
 
@@ -77,6 +78,84 @@ struct xmg3_npn_resynthesis_stats
   }
 };
 
+namespace detail
+{
+
+/* decoded database of `xmg3_npn_resynthesis`, shared by all instances */
+template<class DatabaseNtk>
+struct xmg3_npn_database
+{
+  using repr_map_t = std::unordered_map<kitty::static_truth_table<4u>, std::vector<signal<DatabaseNtk>>, kitty::hash<kitty::static_truth_table<4u>>>;
+
+  explicit xmg3_npn_database( uint16_t const* subgraphs )
+  {
+    db.get_constant( false );
+    /* four primary inputs */
+    db.create_pi();
+    db.create_pi();
+    db.create_pi();
+    db.create_pi();
+
+    auto* p = subgraphs;
+    while ( true )
+    {
+      auto entry0 = *p++;
+      auto entry1 = *p++;
+      auto entry2 = *p++;
+
+      if ( entry0 == 0 && entry1 == 0 && entry2 == 0 )
+        break;
+
+      auto is_xor = entry0 & 1;
+      entry0 >>= 1;
+
+      const auto child0 = db.make_signal( entry0 >> 1 ) ^ ( entry0 & 1 );
+      const auto child1 = db.make_signal( entry1 >> 1 ) ^ ( entry1 & 1 );
+      const auto child2 = db.make_signal( entry2 >> 1 ) ^ ( entry2 & 1 );
+
+      if ( is_xor )
+      {
+        db.create_xor3( child0, child1, child2 );
+      }
+      else
+      {
+        db.create_maj( child0, child1, child2 );
+      }
+    }
+
+    auto const& npn4 = npn4_table::get();
+    const auto sim_res = simulate_nodes<kitty::static_truth_table<4u>>( db );
+
+    db.foreach_node( [&]( auto n ) {
+      if ( npn4.representative( sim_res[n] ) == sim_res[n] )
+      {
+        repr_to_signal[sim_res[n]].push_back( db.make_signal( n ) );
+      }
+      else
+      {
+        const auto f = ~sim_res[n];
+        if ( npn4.representative( f ) == f )
+        {
+          repr_to_signal[f].push_back( !db.make_signal( n ) );
+        }
+      }
+    } );
+  }
+
+  /* Returns the database, which is decoded from `subgraphs` on the first
+   * call. */
+  static xmg3_npn_database const& get( uint16_t const* subgraphs )
+  {
+    static const xmg3_npn_database database( subgraphs );
+    return database;
+  }
+
+  DatabaseNtk db;
+  repr_map_t repr_to_signal;
+};
+
+} /* namespace detail */
+
 /*! \brief Resynthesis function based on pre-computed AIGs.
  *
  * This resynthesis function can be passed to ``cut_rewriting``.  It will
@@ -107,7 +186,10 @@ public:
   xmg3_npn_resynthesis( xmg3_npn_resynthesis_params const& ps = {}, xmg3_npn_resynthesis_stats* pst = nullptr )
       : ps( ps ),
         pst( pst ),
-        _classes( 1 << 16 )
+        _npn4( call_with_stopwatch( st.time_classes, []() -> npn4_table const& { return npn4_table::get(); } ) ),
+        _database( call_with_stopwatch( st.time_db, []() -> auto const& { return detail::xmg3_npn_database<DatabaseNtk>::get( subgraphs ); } ) ),
+        _repr_to_signal( _database.repr_to_signal ),
+        _db( _database.db )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
@@ -127,9 +209,8 @@ public:
     static_assert( has_foreach_node_v<DatabaseNtk>, "DatabaseNtk does not implement the foreach_node method" );
     static_assert( has_make_signal_v<DatabaseNtk>, "DatabaseNtk does not implement the make_signal method" );
 
-    _repr.reserve( 222u );
-    build_classes();
-    build_db();
+    st.db_size = _db.size();
+    st.covered_classes = static_cast<uint32_t>( _repr_to_signal.size() );
   }
 
   virtual ~xmg3_npn_resynthesis()
@@ -151,7 +232,8 @@ public:
     kitty::static_truth_table<4u> tt = kitty::extend_to<4u>( function );
 
     /* get representative of function */
-    const auto repr = _repr[_classes[*tt.cbegin()]];
+    const auto config = _npn4.canonization( tt );
+    const auto& repr = std::get<0>( config );
 
     /* check if representative has circuits */
     const auto it = _repr_to_signal.find( repr );
@@ -160,10 +242,6 @@ public:
       return;
     }
 
-    const auto config = kitty::exact_npn_canonization( tt );
-
-    assert( repr == std::get<0>( config ) );
-
     std::vector<signal<Ntk>> pis( 4, ntk.get_constant( false ) );
     std::copy( begin, end, pis.begin() );
 
@@ -229,111 +307,14 @@ private:
     return f;
   }
 
-  void build_classes()
-  {
-    stopwatch t( st.time_classes );
-
-    kitty::dynamic_truth_table map( 16u );
-    std::transform( map.cbegin(), map.cend(), map.begin(), []( auto word ) { return ~word; } );
-
-    int64_t index = 0;
-    kitty::static_truth_table<4u> tt;
-    while ( index != -1 )
-    {
-      kitty::create_from_words( tt, &index, &index + 1 );
-      const auto res = kitty::exact_npn_canonization( tt, [&]( const auto& tt ) {
-        _classes[*tt.cbegin()] = _repr.size();
-        kitty::clear_bit( map, *tt.cbegin() );
-      } );
-      _repr.push_back( std::get<0>( res ) );
-
-      /* find next non-classified truth table */
-      index = find_first_one_bit( map );
-    }
-  }
-
-  void build_db()
-  {
-    stopwatch t( st.time_db );
-
-    _db.get_constant( false );
-    /* four primary inputs */
-    _db.create_pi();
-    _db.create_pi();
-    _db.create_pi();
-    _db.create_pi();
-
-    auto* p = subgraphs;
-    while ( true )
-    {
-      auto entry0 = *p++;
-      auto entry1 = *p++;
-      auto entry2 = *p++;
-
-      if ( entry0 == 0 && entry1 == 0 && entry2 == 0 )
-        break;
-
-      auto is_xor = entry0 & 1;
-      entry0 >>= 1;
-
-      const auto child0 = _db.make_signal( entry0 >> 1 ) ^ ( entry0 & 1 );
-      const auto child1 = _db.make_signal( entry1 >> 1 ) ^ ( entry1 & 1 );
-      const auto child2 = _db.make_signal( entry2 >> 1 ) ^ ( entry2 & 1 );
-
-      if ( is_xor )
-      {
-        _db.create_xor3( child0, child1, child2 );
-      }
-      else
-      {
-        _db.create_maj( child0, child1, child2 );
-      }
-    }
-
-    const auto sim_res = simulate_nodes<kitty::static_truth_table<4u>>( _db );
-
-    _db.foreach_node( [&]( auto n ) {
-      if ( _repr[_classes[*sim_res[n].cbegin()]] == sim_res[n] )
-      {
-        if ( _repr_to_signal.count( sim_res[n] ) == 0 )
-        {
-          _repr_to_signal.insert( {sim_res[n], {_db.make_signal( n )}} );
-        }
-        else
-        {
-          _repr_to_signal[sim_res[n]].push_back( _db.make_signal( n ) );
-        }
-      }
-      else
-      {
-        const auto f = ~sim_res[n];
-        if ( _repr[_classes[*f.cbegin()]] == f )
-        {
-          if ( _repr_to_signal.count( f ) == 0 )
-          {
-            _repr_to_signal.insert( {f, {!_db.make_signal( n )}} );
-          }
-          else
-          {
-            _repr_to_signal[f].push_back( !_db.make_signal( n ) );
-          }
-        }
-      }
-    } );
-
-    st.db_size = _db.size();
-    st.covered_classes = static_cast<uint32_t>( _repr_to_signal.size() );
-  }
-
   xmg3_npn_resynthesis_params ps;
   xmg3_npn_resynthesis_stats st;
   xmg3_npn_resynthesis_stats* pst{nullptr};
 
-  std::vector<kitty::static_truth_table<4u>> _repr;
-  std::vector<uint32_t> _classes;
-  std::unordered_map<kitty::static_truth_table<4u>, std::vector<signal<DatabaseNtk>>, kitty::hash<kitty::static_truth_table<4u>>> _repr_to_signal;
-
-  DatabaseNtk _db;
+  npn4_table const& _npn4;
+  detail::xmg3_npn_database<DatabaseNtk> const& _database;
+  typename detail::xmg3_npn_database<DatabaseNtk>::repr_map_t const& _repr_to_signal;
+  DatabaseNtk const& _db;
 
   // clang-format off
   inline static const uint16_t subgraphs[]
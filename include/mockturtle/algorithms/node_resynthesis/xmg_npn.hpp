@@ -49,6 +49,7 @@
 #include "../../io/write_bench.hpp"
 #include "../../networks/xmg.hpp"
 #include "../../traits.hpp"
+#include "../../utils/npn4_table.hpp"
 #include "../../views/topo_view.hpp"
 
 namespace mockturtle
@@ -88,8 +89,8 @@ public:
   void operator()( xmg_network& xmg, kitty::dynamic_truth_table const& function, LeavesIterator begin, LeavesIterator end, Fn&& fn ) const
   {
     assert( function.num_vars() <= 4 );
-    const auto fe = kitty::extend_to( function, 4 );
-    const auto config = kitty::exact_npn_canonization( fe );
+    const auto fe = kitty::extend_to<4u>( function );
+    const auto config = npn4_table::get().canonization( fe );
 
     auto func_str = "0x" + kitty::to_hex( std::get<0>( config ) );
     const auto it = class2signal.find( func_str );
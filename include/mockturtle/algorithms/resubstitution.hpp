@@ -46,6 +46,10 @@
 #include "dont_cares.hpp"
 #include "reconv_cut.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace mockturtle
@@ -79,6 +83,23 @@ struct resubstitution_params
   /*! \brief Be verbose. */
   bool verbose{false};
 
+  /*! \brief Number of threads.
+   *
+   * With more than one thread, candidates are computed concurrently on
+   * private copies of the network and committed afterwards in topological
+   * order.  Only used with the window-based resub engine on networks of
+   * type `fanout_view<depth_view<Ntk>>`; otherwise, resubstitution runs
+   * serially.
+   *
+   * The gates are processed in at most 8 rounds, and in each round every
+   * thread copies the whole storage and recomputes the levels and fanouts
+   * of its copy.  This costs O(`num_threads` * N) time per round and up to
+   * `num_threads` additional copies of the network in memory, for a network
+   * with N nodes.  It pays off only if computing the candidates dominates,
+   * e.g., with large windows or don't cares.
+   */
+  uint32_t num_threads{1u};
+
   /****** window-based resub engine ******/
 
   /*! \brief Use don't cares for optimization. Only used by window-based resub engine. */
@@ -103,6 +124,9 @@ struct resubstitution_params
   /*! \brief Maximum number of clauses of the SAT solver. Only used by simulation-based resub engine. */
   uint32_t max_clauses{1000};
 
+  /*! \brief Keep one SAT solver and evict least recently used cones instead of restarting it (see `validator_params::incremental`). Only used by simulation-based resub engine. */
+  bool incremental_sat{false};
+
   /*! \brief Conflict limit for the SAT solver. Only used by simulation-based resub engine. */
   uint32_t conflict_limit{1000};
 
@@ -148,6 +172,9 @@ struct resubstitution_stats
   /*! \brief Initial network size (before resubstitution). */
   uint64_t initial_size{0};
 
+  /*! \brief Number of candidates recomputed serially because their window changed (parallel mode). */
+  uint64_t num_conflicts{0};
+
   void report() const
   {
     // clang-format off
@@ -155,6 +182,10 @@ struct resubstitution_stats
     fmt::print( "[i]     ========  Stats  ========\n" );
     fmt::print( "[i]     #divisors = {:8d}\n", num_total_divisors );
     fmt::print( "[i]     est. gain = {:8d} ({:>5.2f}%)\n", estimated_gain, ( 100.0 * estimated_gain ) / initial_size );
+    if ( num_conflicts > 0u )
+    {
+      fmt::print( "[i]     conflicts = {:8d}\n", num_conflicts );
+    }
     fmt::print( "[i]     ======== Runtime ========\n" );
     fmt::print( "[i]     total         : {:>5.2f} secs\n", to_seconds( time_total ) );
     fmt::print( "[i]       DivCollector: {:>5.2f} secs\n", to_seconds( time_divs ) );
@@ -587,6 +618,64 @@ private:
   window_simulator<Ntk, TTsim> sim;
 }; /* window_based_resub_engine */
 
+/*! \brief Private copy of a network used by the parallel resubstitution.
+ *
+ * The copy has its own storage and its own views, such that candidates can
+ * be computed on it (including the creation of new nodes) without touching
+ * the original network.  Only `fanout_view<depth_view<Ntk>>` is supported.
+ *
+ * Constructing a snapshot copies all nodes and recomputes all levels and
+ * fanouts, which takes time and memory linear in the size of the network.
+ * The node values and traversal IDs written by the divisor collector and the
+ * engine live in the node array, so the copy cannot be shared between
+ * threads.
+ */
+template<class Ntk, class = void>
+struct resub_snapshot
+{
+  static constexpr bool is_supported = false;
+};
+
+template<class Ntk, class NodeCostFn, bool has_depth_interface, bool has_fanout_interface>
+struct resub_snapshot<fanout_view<depth_view<Ntk, NodeCostFn, has_depth_interface>, has_fanout_interface>,
+                      std::enable_if_t<std::is_constructible_v<Ntk, typename Ntk::storage> && has_clone_node_v<Ntk> && has_is_dead_v<Ntk>>>
+{
+  static constexpr bool is_supported = true;
+
+  using depth_view_t = depth_view<Ntk, NodeCostFn, has_depth_interface>;
+  using view_t = fanout_view<depth_view_t, has_fanout_interface>;
+
+  explicit resub_snapshot( view_t const& ntk )
+      : base( std::make_shared<typename Ntk::storage::element_type>( *ntk._storage ) ),
+        depth( make_depth_view( base, ntk ) ),
+        view( depth )
+  {
+  }
+
+  /* the views register events with `this`, so the snapshot must not move */
+  resub_snapshot( resub_snapshot const& ) = delete;
+  resub_snapshot& operator=( resub_snapshot const& ) = delete;
+
+  Ntk base;
+  depth_view_t depth;
+  view_t view;
+
+private:
+  /* levels are computed with the cost function and parameters of the original */
+  static depth_view_t make_depth_view( Ntk const& base, view_t const& ntk )
+  {
+    if constexpr ( has_depth_interface )
+    {
+      (void)ntk;
+      return depth_view_t( base );
+    }
+    else
+    {
+      return depth_view_t( base, ntk.cost_fn(), ntk.depth_params() );
+    }
+  }
+};
+
 /*! \brief The top-level resubstitution framework.
  *
  * \param ResubEngine The engine that computes the resubtitution for a given root
@@ -602,6 +691,10 @@ private:
  * three public data members: `leaves`, `divs`, and `mffc` (see documentation
  * of `default_divisor_collector` for details). When using `simulation_based_resub_engine`,
  * only `divs` is needed.
+ *
+ * With the window-based engine and `resubstitution_params::num_threads`
+ * larger than one, candidates are computed on several threads on copies of
+ * the network (see `resub_snapshot`) and committed afterwards.
  */
 template<class Ntk, class ResubEngine = window_based_resub_engine<Ntk, kitty::dynamic_truth_table>, class DivCollector = default_divisor_collector<Ntk>>
 class resubstitution_impl
@@ -642,6 +735,15 @@ public:
 
   void run( resub_callback_t const& callback = substitute_fn<Ntk> )
   {
+    if constexpr ( ResubEngine::require_leaves_and_mffc && resub_snapshot<Ntk>::is_supported )
+    {
+      if ( ps.num_threads > 1u )
+      {
+        run_parallel( callback );
+        return;
+      }
+    }
+
     stopwatch t( st.time_total );
 
     /* start the managers */
@@ -662,31 +764,7 @@ public:
 
       pbar( i, i, candidates, st.estimated_gain );
 
-      /* compute cut, collect divisors, compute MFFC */
-      mffc_result_t potential_gain;
-      const auto collector_success = call_with_stopwatch( st.time_divs, [&]() {
-        return collector.run( n, potential_gain );
-      });
-      if ( !collector_success )
-      {
-        return true; /* next */
-      }
-
-      /* update statistics */
-      last_gain = 0;
-      st.num_total_divisors += collector.divs.size();
-
-      /* try to find a resubstitution with the divisors */
-      auto g = call_with_stopwatch( st.time_resub, [&]() {
-        if constexpr ( ResubEngine::require_leaves_and_mffc ) /* window-based */
-        {
-          return resub_engine.run( n, collector.leaves, collector.divs, collector.mffc, potential_gain, last_gain );
-        }
-        else /* simulation-based */
-        {
-          return resub_engine.run( n, collector.divs, potential_gain, last_gain );
-        }
-      });
+      auto const g = compute_candidate( collector, resub_engine, n, st, last_gain );
       if ( !g )
       {
         return true; /* next */
@@ -705,6 +783,285 @@ public:
     } );
   }
 
+private:
+  /* computes cut, divisors, and MFFC of `n` and tries to find a resubstitution */
+  template<class Collector, class Engine>
+  std::optional<signal> compute_candidate( Collector& collector, Engine& resub_engine, node const& n, resubstitution_stats& rst, uint32_t& gain )
+  {
+    /* compute cut, collect divisors, compute MFFC */
+    mffc_result_t potential_gain;
+    const auto collector_success = call_with_stopwatch( rst.time_divs, [&]() {
+      return collector.run( n, potential_gain );
+    });
+    if ( !collector_success )
+    {
+      return std::nullopt;
+    }
+
+    /* update statistics */
+    gain = 0;
+    rst.num_total_divisors += collector.divs.size();
+
+    /* try to find a resubstitution with the divisors */
+    return call_with_stopwatch( rst.time_resub, [&]() {
+      if constexpr ( Engine::require_leaves_and_mffc ) /* window-based */
+      {
+        return resub_engine.run( n, collector.leaves, collector.divs, collector.mffc, potential_gain, gain );
+      }
+      else /* simulation-based */
+      {
+        return resub_engine.run( n, collector.divs, potential_gain, gain );
+      }
+    });
+  }
+
+  /* a resubstitution computed on a snapshot */
+  struct parallel_candidate
+  {
+    node root;
+    signal replacement;
+    uint32_t gain;
+
+    /* leaves, divisors, and MFFC of the window */
+    std::vector<node> window;
+  };
+
+  struct parallel_worker
+  {
+    std::unique_ptr<resub_snapshot<Ntk>> snapshot;
+    std::vector<parallel_candidate> candidates;
+    resubstitution_stats st;
+    engine_st_t engine_st;
+    collector_st_t collector_st;
+  };
+
+  /*! \brief Parallel mode.
+   *
+   * The gates are processed in a few rounds.  In each round, every thread
+   * copies the network and computes candidates for a contiguous range of
+   * gates on its copy, without changing the existing nodes.  The candidates
+   * are then committed in topological order.  A candidate whose window
+   * (leaves, divisors, and MFFC) overlaps with the window of an earlier
+   * commit of the same round is dropped and its root is recomputed serially
+   * on the current network.  Since committed windows are disjoint, no
+   * substitution can create a cycle, and the result only depends on the
+   * number of threads.
+   *
+   * The copies of a round are released after its commits, such that the
+   * peak memory is that of `ps.num_threads` snapshots next to the network.
+   * The rounds have at least `min_chunk_size` gates per thread, so a small
+   * network is processed in a single round.
+   *
+   * The statistics of the collector and the engine are only collected for
+   * the first thread and for the serial recomputations.
+   */
+  void run_parallel( resub_callback_t const& callback )
+  {
+    stopwatch t( st.time_total );
+
+    std::vector<node> roots;
+    auto const size = ntk.num_gates();
+    ntk.foreach_gate( [&]( auto const& n, auto i ) {
+      if ( i >= size )
+      {
+        return false;
+      }
+      roots.emplace_back( n );
+      return true;
+    } );
+
+    DivCollector collector( ntk, ps, collector_st );
+    ResubEngine resub_engine( ntk, ps, engine_st );
+    call_with_stopwatch( st.time_resub, [&]() {
+      resub_engine.init();
+    });
+
+    progress_bar pbar{static_cast<uint32_t>( roots.size() ), "resub |{0}| node = {1:>4}   cand = {2:>4}   est. gain = {3:>5}", ps.progress};
+
+    /* a round is large enough to amortize the copies of the network */
+    constexpr uint32_t num_rounds = 8u;
+    constexpr std::size_t min_chunk_size = 256u;
+    auto const chunk_size = std::max<std::size_t>( min_chunk_size, ( roots.size() + ps.num_threads * num_rounds - 1u ) / ( ps.num_threads * num_rounds ) );
+
+    std::vector<parallel_worker> workers( ps.num_threads );
+    std::vector<uint32_t> stamps;
+    std::vector<std::thread> threads;
+    uint32_t round = 0u;
+
+    for ( std::size_t begin = 0u; begin < roots.size(); begin += chunk_size * ps.num_threads )
+    {
+      pbar( begin, begin, candidates, st.estimated_gain );
+
+      auto const base_size = ntk.size();
+      auto const work = [&]( uint32_t thread_id ) {
+        auto& w = workers[thread_id];
+        w.candidates.clear();
+        w.snapshot = std::make_unique<resub_snapshot<Ntk>>( ntk );
+
+        auto& snap = w.snapshot->view;
+        DivCollector w_collector( snap, ps, thread_id == 0u ? collector_st : w.collector_st );
+        ResubEngine w_engine( snap, ps, thread_id == 0u ? engine_st : w.engine_st );
+        call_with_stopwatch( w.st.time_resub, [&]() {
+          w_engine.init();
+        });
+
+        auto const first = std::min( begin + thread_id * chunk_size, roots.size() );
+        auto const last = std::min( first + chunk_size, roots.size() );
+        for ( auto i = first; i < last; ++i )
+        {
+          if ( snap.is_dead( roots[i] ) )
+          {
+            continue;
+          }
+
+          uint32_t gain{0};
+          auto const g = compute_candidate( w_collector, w_engine, roots[i], w.st, gain );
+          if ( g )
+          {
+            auto& cand = w.candidates.emplace_back( parallel_candidate{roots[i], *g, gain, {}} );
+            cand.window.insert( cand.window.end(), w_collector.divs.begin(), w_collector.divs.end() );
+            cand.window.insert( cand.window.end(), w_collector.mffc.begin(), w_collector.mffc.end() );
+          }
+        }
+      };
+
+      /* compute candidates */
+      for ( auto i = 1u; i < ps.num_threads; ++i )
+      {
+        threads.emplace_back( work, i );
+      }
+      work( 0u );
+      for ( auto& thread : threads )
+      {
+        thread.join();
+      }
+      threads.clear();
+
+      /* commit candidates in topological order */
+      ++round;
+      stamps.resize( base_size, 0u );
+      std::vector<node> conflicts;
+      for ( auto& w : workers )
+      {
+        for ( auto const& cand : w.candidates )
+        {
+          if ( ntk.is_dead( cand.root ) )
+          {
+            continue;
+          }
+
+          auto const overlaps = std::any_of( cand.window.begin(), cand.window.end(), [&]( auto const& d ) {
+            return d < base_size && ( stamps[d] == round || ntk.is_dead( d ) );
+          } );
+          if ( overlaps )
+          {
+            conflicts.emplace_back( cand.root );
+            continue;
+          }
+
+          std::unordered_map<node, signal> copies;
+          auto const g = copy_replacement( w.snapshot->view, base_size, cand.replacement, copies );
+          if ( !g )
+          {
+            conflicts.emplace_back( cand.root );
+            continue;
+          }
+          if ( ntk.get_node( *g ) == cand.root )
+          {
+            continue;
+          }
+
+          for ( auto const& d : cand.window )
+          {
+            if ( d < base_size )
+            {
+              stamps[d] = round;
+            }
+          }
+
+          candidates++;
+          st.estimated_gain += cand.gain;
+          call_with_stopwatch( st.time_callback, [&]() {
+            return callback( ntk, cand.root, *g );
+          } );
+        }
+        w.snapshot.reset();
+      }
+
+      /* recompute dropped candidates on the current network */
+      st.num_conflicts += conflicts.size();
+      for ( auto const& n : conflicts )
+      {
+        if ( ntk.is_dead( n ) )
+        {
+          continue;
+        }
+
+        auto const g = compute_candidate( collector, resub_engine, n, st, last_gain );
+        if ( !g )
+        {
+          continue;
+        }
+
+        candidates++;
+        st.estimated_gain += last_gain;
+        call_with_stopwatch( st.time_callback, [&]() {
+          return callback( ntk, n, *g );
+        } );
+      }
+    }
+
+    for ( auto const& w : workers )
+    {
+      st.num_total_divisors += w.st.num_total_divisors;
+      st.time_divs += w.st.time_divs;
+      st.time_resub += w.st.time_resub;
+    }
+  }
+
+  /* rebuilds the nodes that the candidate added to the snapshot in the network */
+  std::optional<signal> copy_replacement( Ntk const& snap, uint32_t base_size, signal const& f, std::unordered_map<node, signal>& copies )
+  {
+    auto const n = snap.get_node( f );
+
+    std::optional<signal> s;
+    if ( n < base_size )
+    {
+      if ( ntk.is_dead( n ) )
+      {
+        return std::nullopt;
+      }
+      s = ntk.make_signal( n );
+    }
+    else if ( auto const it = copies.find( n ); it != copies.end() )
+    {
+      s = it->second;
+    }
+    else
+    {
+      std::vector<signal> children;
+      bool valid = true;
+      snap.foreach_fanin( n, [&]( auto const& fi ) {
+        auto const c = copy_replacement( snap, base_size, fi, copies );
+        if ( !c )
+        {
+          valid = false;
+          return false;
+        }
+        children.emplace_back( *c );
+        return true;
+      } );
+      if ( !valid )
+      {
+        return std::nullopt;
+      }
+      s = ntk.clone_node( snap, n, children );
+      copies.emplace( n, *s );
+    }
+
+    return snap.is_complemented( f ) ? ntk.create_not( *s ) : *s;
+  }
+
 private:
   void register_events()
   {
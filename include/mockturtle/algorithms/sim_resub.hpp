@@ -163,7 +163,7 @@ public:
   using TT = kitty::partial_truth_table;
 
   explicit simulation_based_resub_engine( Ntk& ntk, resubstitution_params const& ps, stats& st )
-      : ntk( ntk ), ps( ps ), st( st ), tts( ntk ), validator( ntk, {ps.max_clauses, ps.odc_levels, ps.conflict_limit, ps.random_seed} )
+      : ntk( ntk ), ps( ps ), st( st ), tts( ntk ), validator( ntk, {ps.max_clauses, ps.odc_levels, ps.conflict_limit, ps.random_seed, ps.incremental_sat} )
   {
     if constexpr ( !validator_t::use_odc_ )
     {
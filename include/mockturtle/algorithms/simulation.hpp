@@ -34,10 +34,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <vector>
 #include <fstream>
 #include <random>
+#include <thread>
 
 #include "../traits.hpp"
 #include "../utils/node_map.hpp"
@@ -664,6 +668,261 @@ void update_const_pi( Ntk const& ntk, unordered_node_map<kitty::partial_truth_ta
   } );
 }
 
+/* AIGs, XAGs, MIGs, and XMGs (and views on them) can be simulated word by
+ * word with `simulate_nodes_bit_parallel` */
+template<class Ntk>
+inline constexpr bool is_bit_parallel_simulatable_v =
+    Ntk::min_fanin_size == Ntk::max_fanin_size && ( Ntk::max_fanin_size == 2u || Ntk::max_fanin_size == 3u ) &&
+    has_is_and_v<Ntk> && has_is_xor_v<Ntk> && has_is_maj_v<Ntk> && has_is_xor3_v<Ntk> && !has_is_buf_v<Ntk>;
+
+/* Returns the gates in topological order.  The index order is used if it is
+ * topological, which is not the case anymore after `substitute_node`;
+ * otherwise, the gates are sorted by a depth-first search over the fanins. */
+template<class Ntk>
+std::vector<typename Ntk::node> topological_gates( Ntk const& ntk )
+{
+  using node = typename Ntk::node;
+
+  /* 0: no gate, 1: gate, 2: gate on the stack, 3: gate in `order` */
+  std::vector<uint8_t> state( ntk.size(), 0u );
+  std::vector<node> order;
+  bool sorted = true;
+  ntk.foreach_gate( [&]( auto const& n ) {
+    if ( sorted )
+    {
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        sorted = ntk.node_to_index( ntk.get_node( f ) ) < ntk.node_to_index( n );
+        return sorted;
+      } );
+    }
+    state[ntk.node_to_index( n )] = 1u;
+    order.push_back( n );
+  } );
+
+  if ( sorted )
+  {
+    return order;
+  }
+
+  std::vector<node> gates;
+  std::swap( gates, order );
+  order.reserve( gates.size() );
+
+  std::vector<node> stack;
+  for ( auto const& g : gates )
+  {
+    if ( state[ntk.node_to_index( g )] != 1u )
+    {
+      continue;
+    }
+
+    stack.push_back( g );
+    state[ntk.node_to_index( g )] = 2u;
+    while ( !stack.empty() )
+    {
+      auto const n = stack.back();
+      bool ready = true;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        auto const index = ntk.node_to_index( ntk.get_node( f ) );
+        if ( state[index] == 1u )
+        {
+          state[index] = 2u;
+          stack.push_back( ntk.get_node( f ) );
+          ready = false;
+        }
+        return ready;
+      } );
+
+      if ( ready )
+      {
+        stack.pop_back();
+        state[ntk.node_to_index( n )] = 3u;
+        order.push_back( n );
+      }
+    }
+  }
+
+  return order;
+}
+
+/* Computes `num_words` words of gate `n` into `out`, where `words( fanin )`
+ * points to the words of a fanin */
+template<class Ntk, class WordsFn>
+void compute_gate_words( Ntk const& ntk, typename Ntk::node const& n, WordsFn&& words, uint64_t* out, uint32_t num_words )
+{
+  std::array<uint64_t const*, Ntk::max_fanin_size> in{};
+  std::array<uint64_t, Ntk::max_fanin_size> mask{};
+  ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+    in[i] = words( ntk.get_node( f ) );
+    mask[i] = ntk.is_complemented( f ) ? ~uint64_t( 0 ) : uint64_t( 0 );
+  } );
+
+  if constexpr ( Ntk::max_fanin_size == 2u )
+  {
+    if ( ntk.is_xor( n ) )
+    {
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        out[w] = ( in[0][w] ^ mask[0] ) ^ ( in[1][w] ^ mask[1] );
+      }
+    }
+    else
+    {
+      assert( ntk.is_and( n ) );
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        out[w] = ( in[0][w] ^ mask[0] ) & ( in[1][w] ^ mask[1] );
+      }
+    }
+  }
+  else
+  {
+    if ( ntk.is_xor3( n ) )
+    {
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        out[w] = ( in[0][w] ^ mask[0] ) ^ ( in[1][w] ^ mask[1] ) ^ ( in[2][w] ^ mask[2] );
+      }
+    }
+    else
+    {
+      assert( ntk.is_maj( n ) );
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        const auto a = in[0][w] ^ mask[0];
+        const auto b = in[1][w] ^ mask[1];
+        const auto c = in[2][w] ^ mask[2];
+        out[w] = ( a & b ) | ( c & ( a | b ) );
+      }
+    }
+  }
+}
+
+/* Splits `num_words` words into chunks of at most `chunk_size` words and
+ * calls `fn( begin, end, thread_id )` for each chunk, on `num_threads`
+ * threads that take the next chunk when they are done with one */
+template<class Fn>
+void foreach_word_chunk_parallel( uint32_t num_words, uint32_t num_threads, uint32_t chunk_size, Fn&& fn )
+{
+  const auto num_chunks = ( num_words + chunk_size - 1u ) / chunk_size;
+  num_threads = std::max( 1u, std::min( num_threads, num_chunks ) );
+
+  std::atomic<uint32_t> next{0u};
+  const auto worker = [&]( uint32_t thread_id ) {
+    for ( auto c = next++; c < num_chunks; c = next++ )
+    {
+      fn( c * chunk_size, std::min( num_words, ( c + 1u ) * chunk_size ), thread_id );
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for ( auto t = 1u; t < num_threads; ++t )
+  {
+    threads.emplace_back( worker, t );
+  }
+  worker( 0u );
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+}
+
+/* number of words (64 patterns each) that a thread simulates at once */
+static constexpr uint32_t simulation_chunk_size = 64u;
+
+/* Simulates all gates of an AIG, XAG, MIG, or XMG on `num_threads` threads.
+ * `words[i]` points to `num_words` words of the node with index `i`, which
+ * must be computed for constants and PIs.  Each thread computes all gates for
+ * one chunk of words at a time, in the topological order `gates`, and writes
+ * into the words of the gates. */
+template<class Ntk>
+void simulate_gate_words_parallel( Ntk const& ntk, std::vector<typename Ntk::node> const& gates, std::vector<uint64_t*> const& words, uint32_t num_words, uint32_t num_threads )
+{
+  foreach_word_chunk_parallel( num_words, num_threads, simulation_chunk_size, [&]( uint32_t begin, uint32_t end, uint32_t ) {
+    for ( auto const& n : gates )
+    {
+      const auto fanin_words = [&]( auto const& f ) -> uint64_t const* {
+        return words[ntk.node_to_index( f )] + begin;
+      };
+      compute_gate_words( ntk, n, fanin_words, words[ntk.node_to_index( n )] + begin, end - begin );
+    }
+  } );
+}
+
+/* Simulates all gates in one contiguous arena of 64-bit words, one slice of
+ * `num_words` words per node, without allocating intermediate truth tables.
+ *
+ * If `last_block_only` is true, only the last block is computed for gates
+ * whose value does not have `sim.num_bits()` bits yet; otherwise, all blocks
+ * are computed for all gates, on `num_threads` threads if larger than 1.
+ * Constants and PIs must be up-to-date in `node_to_value`. */
+template<class Ntk, class Simulator>
+void simulate_nodes_bit_parallel( Ntk const& ntk, unordered_node_map<kitty::partial_truth_table, Ntk>& node_to_value, Simulator const& sim, bool last_block_only, uint32_t num_threads = 1u )
+{
+  const auto num_bits = sim.num_bits();
+
+  if ( !last_block_only && num_threads > 1u )
+  {
+    /* allocate all values and let the threads write into them */
+    std::vector<uint64_t*> words( ntk.size(), nullptr );
+    const auto collect = [&]( auto const& n ) {
+      auto& tt = node_to_value[n];
+      tt.resize( num_bits );
+      words[ntk.node_to_index( n )] = tt._bits.data();
+    };
+    collect( ntk.get_node( ntk.get_constant( false ) ) );
+    collect( ntk.get_node( ntk.get_constant( true ) ) );
+    ntk.foreach_pi( collect );
+    ntk.foreach_gate( collect );
+
+    simulate_gate_words_parallel( ntk, topological_gates( ntk ), words, ( num_bits + 63u ) >> 6, num_threads );
+
+    ntk.foreach_gate( [&]( auto const& n ) {
+      node_to_value[n].mask_bits();
+    } );
+    return;
+  }
+
+  const auto num_blocks = ( num_bits + 63u ) >> 6;
+  const auto num_words = last_block_only ? std::min( 1u, num_blocks ) : num_blocks;
+  const auto first_word = num_blocks - num_words;
+
+  std::vector<uint64_t> arena( static_cast<std::size_t>( ntk.size() ) * num_words );
+  const auto words = [&]( auto const& n ) {
+    return arena.data() + static_cast<std::size_t>( ntk.node_to_index( n ) ) * num_words;
+  };
+  const auto load = [&]( auto const& n ) {
+    auto const& tt = node_to_value[n];
+    std::copy( tt._bits.begin() + first_word, tt._bits.begin() + first_word + num_words, words( n ) );
+  };
+
+  load( ntk.get_node( ntk.get_constant( false ) ) );
+  if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
+  {
+    load( ntk.get_node( ntk.get_constant( true ) ) );
+  }
+  ntk.foreach_pi( [&]( auto const& n ) {
+    load( n );
+  } );
+
+  for ( auto const& n : topological_gates( ntk ) )
+  {
+    if ( last_block_only && node_to_value[n].num_bits() == num_bits )
+    {
+      load( n );
+      continue;
+    }
+
+    uint64_t* out = words( n );
+    compute_gate_words( ntk, n, words, out, num_words );
+
+    auto& tt = node_to_value[n];
+    tt.resize( num_bits );
+    std::copy( out, out + num_words, tt._bits.begin() + first_word );
+    tt.mask_bits();
+  }
+}
+
 } // namespace detail
 
 /*! \brief (Re-)simulate `n` and its transitive fanin cone.
@@ -710,9 +969,11 @@ void simulate_node( Ntk const& ntk, typename Ntk::node const& n, unordered_node_
  * \param simulate_whole_tt When this parameter is true, it is assumed that `node_to_value.has( n )` is false for every node.
  * In contrast, when this parameter is false, only the last block of `partial_truth_table` will be re-computed,
  * and it is assumed that `node_to_value.has( n )` is true for every node.
+ * \param num_threads Number of threads to simulate the whole truth tables of AIGs, XAGs, MIGs, and XMGs
+ * (see `simulate_nodes_parallel`).
  */
 template<class Ntk, class Simulator = partial_simulator>
-void simulate_nodes( Ntk const& ntk, unordered_node_map<kitty::partial_truth_table, Ntk>& node_to_value, Simulator const& sim, bool simulate_whole_tt )
+void simulate_nodes( Ntk const& ntk, unordered_node_map<kitty::partial_truth_table, Ntk>& node_to_value, Simulator const& sim, bool simulate_whole_tt, uint32_t num_threads = 1u )
 {
   static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
   static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
@@ -727,6 +988,25 @@ void simulate_nodes( Ntk const& ntk, unordered_node_map<kitty::partial_truth_tab
 
   detail::update_const_pi( ntk, node_to_value, sim );
 
+  if constexpr ( detail::is_bit_parallel_simulatable_v<Ntk> )
+  {
+    /* simulate all gates at once, unless some of them are already simulated */
+    bool bit_parallel = true;
+    if ( simulate_whole_tt )
+    {
+      ntk.foreach_gate( [&]( auto const& n ) {
+        bit_parallel = !node_to_value.has( n );
+        return bit_parallel;
+      } );
+    }
+
+    if ( bit_parallel )
+    {
+      detail::simulate_nodes_bit_parallel( ntk, node_to_value, sim, !simulate_whole_tt, num_threads );
+      return;
+    }
+  }
+
   /* gates */
   if ( simulate_whole_tt )
   {
@@ -749,6 +1029,263 @@ void simulate_nodes( Ntk const& ntk, unordered_node_map<kitty::partial_truth_tab
   }
 }
 
+/*! \brief Simulates a network with `partial_simulator` on several threads.
+ *
+ * The simulation patterns are split into chunks of 64-bit words, which are
+ * independent of each other.  Each of the `num_threads` threads simulates
+ * all nodes for one chunk at a time.  The partial truth tables of all nodes
+ * are allocated before, and the threads write their chunks directly into
+ * them.  Gates are simulated in topological order, which is not necessarily
+ * the index order.  AIGs, XAGs, MIGs, and XMGs are simulated word by word;
+ * other networks are simulated with `compute` on partial truth tables of the
+ * size of a chunk, which each thread keeps for all nodes.
+ *
+ * This method returns a map that maps each node to its simulation value,
+ * as `simulate_nodes<kitty::partial_truth_table>( ntk, sim )`.
+ *
+ * **Required network functions:**
+ * - `get_constant`
+ * - `constant_value`
+ * - `get_node`
+ * - `node_to_index`
+ * - `foreach_pi`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `compute<kitty::partial_truth_table>`
+ *
+ * The network must support concurrent calls to its const methods.
+ *
+ * \param ntk Network
+ * \param sim Simulator
+ * \param num_threads Number of threads
+ */
+template<class Ntk, class Simulator = partial_simulator>
+node_map<kitty::partial_truth_table, Ntk> simulate_nodes_parallel( Ntk const& ntk, Simulator const& sim, uint32_t num_threads = std::max( 1u, std::thread::hardware_concurrency() ) )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_constant_value_v<Ntk>, "Ntk does not implement the constant_value method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute specialization for kitty::partial_truth_table" );
+
+  const auto num_bits = sim.num_bits();
+  const auto num_words = ( num_bits + 63u ) >> 6;
+
+  node_map<kitty::partial_truth_table, Ntk> node_to_value( ntk );
+  std::vector<uint64_t*> words( ntk.size(), nullptr );
+
+  const auto constant = ntk.get_node( ntk.get_constant( false ) );
+  node_to_value[constant] = sim.compute_constant( ntk.constant_value( constant ) );
+  if ( constant != ntk.get_node( ntk.get_constant( true ) ) )
+  {
+    node_to_value[ntk.get_node( ntk.get_constant( true ) )] = sim.compute_constant( ntk.constant_value( ntk.get_node( ntk.get_constant( true ) ) ) );
+  }
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    node_to_value[n] = sim.compute_pi( i );
+  } );
+  ntk.foreach_gate( [&]( auto const& n ) {
+    node_to_value[n] = kitty::partial_truth_table( num_bits );
+  } );
+
+  const auto collect = [&]( auto const& n ) {
+    words[ntk.node_to_index( n )] = node_to_value[n]._bits.data();
+  };
+  collect( constant );
+  collect( ntk.get_node( ntk.get_constant( true ) ) );
+  ntk.foreach_pi( collect );
+  ntk.foreach_gate( collect );
+
+  const auto gates = detail::topological_gates( ntk );
+  if constexpr ( detail::is_bit_parallel_simulatable_v<Ntk> )
+  {
+    detail::simulate_gate_words_parallel( ntk, gates, words, num_words, num_threads );
+  }
+  else
+  {
+    /* values of all nodes for the current chunk, one vector per thread */
+    std::vector<std::vector<kitty::partial_truth_table>> chunks( std::max( 1u, num_threads ) );
+
+    detail::foreach_word_chunk_parallel( num_words, num_threads, detail::simulation_chunk_size, [&]( uint32_t begin, uint32_t end, uint32_t thread_id ) {
+      auto& values = chunks[thread_id];
+      values.resize( ntk.size() );
+
+      const auto load = [&]( auto const& n ) {
+        auto& tt = values[ntk.node_to_index( n )];
+        tt.resize( ( end - begin ) * 64u );
+        std::copy( words[ntk.node_to_index( n )] + begin, words[ntk.node_to_index( n )] + end, tt._bits.begin() );
+      };
+      load( constant );
+      load( ntk.get_node( ntk.get_constant( true ) ) );
+      ntk.foreach_pi( load );
+
+      std::vector<kitty::partial_truth_table> fanin_values;
+      for ( auto const& n : gates )
+      {
+        fanin_values.clear();
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          fanin_values.push_back( values[ntk.node_to_index( ntk.get_node( f ) )] );
+        } );
+
+        const auto index = ntk.node_to_index( n );
+        values[index] = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+        std::copy( values[index]._bits.begin(), values[index]._bits.end(), words[index] + begin );
+      }
+    } );
+  }
+
+  ntk.foreach_gate( [&]( auto const& n ) {
+    node_to_value[n].mask_bits();
+  } );
+
+  return node_to_value;
+}
+
+/*! \brief Simulates a network while keeping only live values in memory.
+ *
+ * Nodes are simulated in topological order, which is not necessarily the
+ * index order (see `substitute_node`).  The value of a node is kept
+ * only until all its fanouts (counted with `fanout_size`) have been
+ * simulated, unless the node drives a primary output or is contained in
+ * `keep`.  Released `partial_truth_table` values of AIGs, XAGs, MIGs, and
+ * XMGs are recycled for later nodes.
+ *
+ * The function `fn( n, value )` is called for every node right after its
+ * value has been computed, and before the value may be released.
+ *
+ * This method returns a map with the values of all nodes that drive primary
+ * outputs or are contained in `keep`.
+ *
+ * **Required network functions:**
+ * - `fanout_size`
+ * - `compute<SimulationType>`
+ *
+ * \param ntk Network
+ * \param sim Simulator, which implements the simulator interface
+ * \param keep Nodes whose values are retained
+ * \param fn Callback for each simulated node
+ */
+template<class SimulationType, class Ntk, class Simulator, class Fn>
+unordered_node_map<SimulationType, Ntk> simulate_nodes_streaming( Ntk const& ntk, Simulator const& sim, std::vector<node<Ntk>> const& keep, Fn&& fn )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_constant_value_v<Ntk>, "Ntk does not implement the constant_value method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+  static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_compute_v<Ntk, SimulationType>, "Ntk does not implement the compute method for SimulationType" );
+
+  constexpr bool bit_parallel = std::is_same_v<SimulationType, kitty::partial_truth_table> && detail::is_bit_parallel_simulatable_v<Ntk>;
+
+  unordered_node_map<SimulationType, Ntk> node_to_value( ntk );
+  std::vector<uint32_t> refs( ntk.size(), 0u );
+  std::vector<bool> retained( ntk.size(), false );
+  for ( auto const& n : keep )
+  {
+    retained[ntk.node_to_index( n )] = true;
+  }
+  ntk.foreach_po( [&]( auto const& f ) {
+    retained[ntk.node_to_index( ntk.get_node( f ) )] = true;
+  } );
+
+  std::vector<SimulationType> pool;
+  const auto release = [&]( auto const& n ) {
+    if constexpr ( bit_parallel )
+    {
+      pool.emplace_back( std::move( node_to_value[n] ) );
+    }
+    node_to_value.erase( n );
+  };
+  const auto visit = [&]( auto const& n ) {
+    const auto index = ntk.node_to_index( n );
+    fn( n, static_cast<SimulationType const&>( node_to_value[n] ) );
+    refs[index] = ntk.fanout_size( n );
+    if ( refs[index] == 0u && !retained[index] )
+    {
+      release( n );
+    }
+  };
+
+  /* constants */
+  node_to_value[ntk.get_node( ntk.get_constant( false ) )] = sim.compute_constant( ntk.constant_value( ntk.get_node( ntk.get_constant( false ) ) ) );
+  visit( ntk.get_node( ntk.get_constant( false ) ) );
+  if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
+  {
+    node_to_value[ntk.get_node( ntk.get_constant( true ) )] = sim.compute_constant( ntk.constant_value( ntk.get_node( ntk.get_constant( true ) ) ) );
+    visit( ntk.get_node( ntk.get_constant( true ) ) );
+  }
+
+  /* pis */
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    node_to_value[n] = sim.compute_pi( i );
+    visit( n );
+  } );
+
+  /* gates */
+  std::vector<SimulationType> fanin_values;
+  for ( auto const& n : detail::topological_gates( ntk ) )
+  {
+    if constexpr ( bit_parallel )
+    {
+      kitty::partial_truth_table tt;
+      if ( !pool.empty() )
+      {
+        tt = std::move( pool.back() );
+        pool.pop_back();
+      }
+      tt.resize( sim.num_bits() );
+
+      const auto words = [&]( auto const& fanin ) {
+        return static_cast<kitty::partial_truth_table const&>( node_to_value[fanin] )._bits.data();
+      };
+      detail::compute_gate_words( ntk, n, words, tt._bits.data(), static_cast<uint32_t>( tt._bits.size() ) );
+      tt.mask_bits();
+      node_to_value[n] = std::move( tt );
+    }
+    else
+    {
+      fanin_values.resize( ntk.fanin_size( n ) );
+      ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+        fanin_values[i] = node_to_value[ntk.get_node( f )];
+      } );
+      node_to_value[n] = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+    }
+
+    /* release fanins whose fanouts have all been simulated */
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      const auto index = ntk.node_to_index( ntk.get_node( f ) );
+      assert( refs[index] > 0u );
+      if ( --refs[index] == 0u && !retained[index] )
+      {
+        release( ntk.get_node( f ) );
+      }
+    } );
+
+    visit( n );
+  }
+
+  return node_to_value;
+}
+
+/*! \brief Simulates a network while keeping only live values in memory.
+ *
+ * Same as the overload above, without a callback.
+ */
+template<class SimulationType, class Ntk, class Simulator = default_simulator<SimulationType>>
+unordered_node_map<SimulationType, Ntk> simulate_nodes_streaming( Ntk const& ntk, Simulator const& sim = Simulator(), std::vector<node<Ntk>> const& keep = {} )
+{
+  return simulate_nodes_streaming<SimulationType>( ntk, sim, keep, []( auto const&, auto const& ) {} );
+}
+
 /*! \brief Simulates a network with a generic simulator.
  *
  * This is a generic simulation algorithm that can simulate arbitrary values.
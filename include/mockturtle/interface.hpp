@@ -400,6 +400,34 @@ public:
    * \brief new_signal Signal to replace ``old_node`` with
    */
   void substitute_node_of_parents( std::vector<node> const& parents, node const& old_node, signal const& new_signal );
+
+  /*! \brief Removes dead nodes and renumbers the remaining nodes.
+   *
+   * The nodes are renumbered in place such that the constant comes first,
+   * followed by the CIs in their order and by the gates in topological
+   * order.  CIs, COs, and the structural hash table are updated.  Returns
+   * a vector that maps the index of each old node to its new index; dead
+   * nodes are mapped to ``std::numeric_limits<node>::max()``.  Containers
+   * and views that refer to nodes by index must be migrated or recomputed.
+   */
+  std::vector<node> compact();
+
+  /*! \brief Starts maintaining the fanouts of each node.
+   *
+   * The fanouts are computed once and then updated whenever nodes are
+   * created, modified, or taken out.  While tracking is enabled,
+   * ``substitute_node`` and ``substitute_nodes`` only visit the fanouts
+   * of the substituted node instead of all nodes in the network; the
+   * result is the same.  The fanouts are stored with the network and are
+   * shared by all shallow copies.
+   */
+  void enable_fanout_tracking();
+
+  /*! \brief Stops maintaining the fanouts and releases their memory. */
+  void disable_fanout_tracking();
+
+  /*! \brief Returns whether fanouts are maintained. */
+  bool has_fanout_tracking() const;
 #pragma endregion
 
 #pragma region Structural properties
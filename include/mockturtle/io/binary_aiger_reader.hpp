@@ -0,0 +1,353 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file binary_aiger_reader.hpp
+  \brief Native reader for binary AIGER files into AIGs
+
+  This reader does not use lorina.  It maps the file into memory and
+  decodes the delta-encoded AND section directly into the storage of an
+  `aig_network` (or `soa_aig_network`), whose node array and structural
+  hash table are sized from the header.
+*/
+
+#pragma once
+
+#include "../networks/aig.hpp"
+#include "../traits.hpp"
+#include "../utils/mapped_file.hpp"
+
+#include <lorina/common.hpp>
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+template<class Ntk>
+class binary_aiger_parser
+{
+public:
+  using signal = typename Ntk::signal;
+
+  binary_aiger_parser( char const* begin, char const* end, Ntk& ntk )
+      : _it( begin ), _end( end ), _ntk( ntk )
+  {
+  }
+
+  lorina::return_code run()
+  {
+    /* header: aig M I L O A [B C J F] */
+    if ( !expect( "aig " ) )
+    {
+      return lorina::return_code::parse_error;
+    }
+    uint64_t header[9] = {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u};
+    auto num_fields = 0u;
+    while ( num_fields < 9u )
+    {
+      if ( !read_number( header[num_fields++] ) )
+      {
+        return lorina::return_code::parse_error;
+      }
+      if ( _it != _end && *_it == '\n' )
+      {
+        ++_it;
+        break;
+      }
+      if ( !expect( " " ) )
+      {
+        return lorina::return_code::parse_error;
+      }
+    }
+    auto const [num_vars, num_inputs, num_latches, num_outputs, num_ands] = std::make_tuple( header[0], header[1], header[2], header[3], header[4] );
+    if ( num_fields < 5u || num_vars != num_inputs + num_latches + num_ands || header[5] + header[6] + header[7] + header[8] != 0u )
+    {
+      return lorina::return_code::parse_error;
+    }
+    if constexpr ( !has_create_ri_v<Ntk> || !has_create_ro_v<Ntk> )
+    {
+      if ( num_latches != 0u )
+      {
+        return lorina::return_code::parse_error;
+      }
+    }
+
+    auto& storage = *_ntk._storage;
+    storage.nodes.reserve( 1u + num_vars );
+    storage.hash.reserve( num_ands );
+
+    /* AIGER variables map to nodes with the same index, unless trivial or
+     * duplicate AND gates are merged */
+    _signals.reserve( 1u + num_vars );
+    _signals.push_back( _ntk.get_constant( false ) );
+    for ( auto i = 0u; i < num_inputs; ++i )
+    {
+      _signals.push_back( _ntk.create_pi() );
+    }
+    for ( auto i = 0u; i < num_latches; ++i )
+    {
+      _signals.push_back( _ntk.create_ro() );
+    }
+
+    /* latches and outputs */
+    std::vector<std::tuple<uint64_t, int8_t>> latches( num_latches );
+    for ( auto& [next, reset] : latches )
+    {
+      uint64_t init{0u};
+      if ( !read_number( next ) )
+      {
+        return lorina::return_code::parse_error;
+      }
+      if ( _it != _end && *_it == ' ' )
+      {
+        ++_it;
+        if ( !read_number( init ) )
+        {
+          return lorina::return_code::parse_error;
+        }
+      }
+      reset = init == 0u ? 0 : ( init == 1u ? 1 : -1 );
+      if ( !expect( "\n" ) )
+      {
+        return lorina::return_code::parse_error;
+      }
+    }
+
+    std::vector<uint64_t> outputs( num_outputs );
+    for ( auto& lit : outputs )
+    {
+      if ( !read_number( lit ) || !expect( "\n" ) )
+      {
+        return lorina::return_code::parse_error;
+      }
+    }
+
+    /* AND gates */
+    for ( auto i = 0u; i < num_ands; ++i )
+    {
+      uint64_t const lhs = 2u * ( 1u + num_inputs + num_latches + i );
+      uint64_t delta0, delta1;
+      if ( !decode( delta0 ) || !decode( delta1 ) || delta0 == 0u || delta0 > lhs || delta1 > lhs - delta0 )
+      {
+        return lorina::return_code::parse_error;
+      }
+      uint64_t const rhs0 = lhs - delta0;
+      uint64_t const rhs1 = rhs0 - delta1;
+      _signals.push_back( create_and( literal( rhs1 ), literal( rhs0 ) ) );
+    }
+
+    for ( auto const& lit : outputs )
+    {
+      if ( lit > 2u * num_vars + 1u )
+      {
+        return lorina::return_code::parse_error;
+      }
+      _ntk.create_po( literal( lit ) );
+    }
+    if constexpr ( has_create_ri_v<Ntk> && has_create_ro_v<Ntk> )
+    {
+      for ( auto const& [next, reset] : latches )
+      {
+        if ( next > 2u * num_vars + 1u )
+        {
+          return lorina::return_code::parse_error;
+        }
+        _ntk.create_ri( literal( next ), reset );
+      }
+    }
+
+    /* the AND gates bypass the network, so the fanout lists are rebuilt */
+    if ( _ntk.has_fanout_tracking() )
+    {
+      _ntk.enable_fanout_tracking();
+    }
+
+    /* the symbol table and comments are ignored */
+    return lorina::return_code::success;
+  }
+
+private:
+  signal literal( uint64_t lit ) const
+  {
+    return _signals[lit >> 1] ^ ( ( lit & 1 ) != 0 );
+  }
+
+  /* same as `create_and`, but without events and with a single probe into the hash table */
+  signal create_and( signal a, signal b )
+  {
+    if ( a.index > b.index )
+    {
+      std::swap( a, b );
+    }
+    if ( a.index == b.index || a.index == 0 )
+    {
+      return _ntk.create_and( a, b );
+    }
+
+    auto& storage = *_ntk._storage;
+    typename std::decay_t<decltype( storage )>::node_type node;
+    node.children[0] = a;
+    node.children[1] = b;
+
+    const auto index = storage.nodes.size();
+    const auto [it, inserted] = storage.hash.try_emplace( node, static_cast<typename decltype( storage.hash )::mapped_type>( index ) );
+    if ( !inserted )
+    {
+      return {it->second, 0};
+    }
+
+    storage.nodes.push_back( node );
+    storage.nodes[a.index].data[0].h1++;
+    storage.nodes[b.index].data[0].h1++;
+    return {index, 0};
+  }
+
+  bool expect( char const* s )
+  {
+    for ( ; *s != '\0'; ++s, ++_it )
+    {
+      if ( _it == _end || *_it != *s )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool read_number( uint64_t& value )
+  {
+    if ( _it == _end || *_it < '0' || *_it > '9' )
+    {
+      return false;
+    }
+    value = 0u;
+    while ( _it != _end && *_it >= '0' && *_it <= '9' )
+    {
+      value = 10u * value + static_cast<uint64_t>( *_it++ - '0' );
+    }
+    return true;
+  }
+
+  /* variable-length delta encoding with 7 bits per byte */
+  bool decode( uint64_t& value )
+  {
+    value = 0u;
+    for ( auto shift = 0u; shift < 64u; shift += 7u )
+    {
+      if ( _it == _end )
+      {
+        return false;
+      }
+      auto const byte = static_cast<uint8_t>( *_it++ );
+      value |= static_cast<uint64_t>( byte & 0x7f ) << shift;
+      if ( ( byte & 0x80 ) == 0 )
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  char const* _it;
+  char const* _end;
+  Ntk& _ntk;
+  std::vector<signal> _signals;
+};
+
+} // namespace detail
+
+/*! \brief Reads a binary AIGER file from memory into an AIG.
+ *
+ * The AND gates are decoded directly into the storage of `ntk`, which must
+ * be empty.  The node array and the structural hash table are reserved from
+ * the header, and each AND gate costs a single probe into the hash table.
+ * Hence, variable `i` of a structurally hashed AIGER file becomes node `i`
+ * in the network.  Trivial and duplicate AND gates are merged.  No
+ * `on_add` events are emitted.  If fanout tracking is enabled in `ntk`, the
+ * fanout lists are rebuilt once after all gates have been read.
+ *
+ * Names in the symbol table and comments are ignored; use `aiger_reader`
+ * with lorina to read them.  Justice, fairness, bad-state, and invariant
+ * constraint sections are not supported.
+ *
+ * \param begin Begin of the file contents
+ * \param end End of the file contents
+ * \param ntk Empty AIG (or a view on an AIG)
+ */
+template<class Ntk>
+lorina::return_code read_binary_aiger( char const* begin, char const* end, Ntk& ntk )
+{
+  static_assert( std::is_same_v<typename Ntk::base_type, basic_aig_network<typename Ntk::storage::element_type>>, "Ntk is not an AIG network" );
+
+  if ( ntk.size() != 1u || ntk.num_pos() != 0u )
+  {
+    return lorina::return_code::parse_error;
+  }
+
+  return detail::binary_aiger_parser<Ntk>( begin, end, ntk ).run();
+}
+
+/*! \brief Reads a binary AIGER file into an AIG.
+ *
+ * The file is memory-mapped (where supported) and read with
+ * `read_binary_aiger` from memory.
+
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network aig;
+      if ( read_binary_aiger( "file.aig", aig ) != lorina::return_code::success )
+      {
+        std::cerr << "[e] could not read file.aig\n";
+      }
+   \endverbatim
+ *
+ * \param filename Name of a binary AIGER file
+ * \param ntk Empty AIG (or a view on an AIG)
+ */
+template<class Ntk>
+lorina::return_code read_binary_aiger( std::string const& filename, Ntk& ntk )
+{
+  detail::mapped_file const file( filename );
+  if ( !file.is_open() )
+  {
+    return lorina::return_code::parse_error;
+  }
+  return read_binary_aiger( file.begin(), file.end(), ntk );
+}
+
+} /* namespace mockturtle */
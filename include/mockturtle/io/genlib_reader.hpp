@@ -69,6 +69,26 @@ struct gate
   kitty::dynamic_truth_table function;
   double area;
   std::vector<pin> pins;
+
+  /*! \brief Returns the pin of the `i`-th variable.
+   *
+   * Pins are matched by name (`a` is variable 0), unless a single pin
+   * (`PIN *`) describes all of them.  Returns `nullptr` for constants.
+   */
+  pin const* get_pin( uint32_t i ) const
+  {
+    if ( pins.empty() )
+      return nullptr;
+    if ( pins.size() == 1u )
+      return &pins.front();
+
+    for ( auto const& p : pins )
+    {
+      if ( p.name.size() == 1u && p.name[0] == static_cast<char>( 'a' + i ) )
+        return &p;
+    }
+    return i < pins.size() ? &pins[i] : &pins.back();
+  }
 }; /* gate */
 
 /*! \brief lorina callbacks for GENLIB files.
@@ -0,0 +1,724 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file snapshot.hpp
+  \brief Binary snapshots of networks
+
+  This file implements a binary snapshot format for `aig_network`,
+  `xag_network`, `mig_network`, `xmg_network`, `klut_network`, and
+  `inline_klut_network`, optionally wrapped in a `names_view`.  A snapshot
+  stores the complete state of the network (including dangling and dead
+  nodes, the structural hash table, latch information, and the truth table
+  cache of k-LUT networks).  The storage arrays are written as contiguous
+  blocks, such that the nodes of networks with a fixed number of fan-ins are
+  copied as one block when loading.  The structural hash table is stored as
+  the indices of the hashed nodes and rebuilt node by node; the nodes of
+  k-LUT networks and their truth table cache are rebuilt as well.  Like
+  `serialize_network`, the format depends on the platform and is meant for
+  checkpoints, not for exchange.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+
+#include "../networks/aig.hpp"
+#include "../networks/klut.hpp"
+#include "../networks/mig.hpp"
+#include "../networks/xag.hpp"
+#include "../networks/xmg.hpp"
+#include "../traits.hpp"
+#include "../utils/mapped_file.hpp"
+
+namespace mockturtle
+{
+
+/*! \cond PRIVATE */
+namespace detail
+{
+
+static constexpr char snapshot_magic[8] = {'M', 'T', 'S', 'N', 'A', 'P', 'S', 'H'};
+static constexpr uint32_t snapshot_version = 1u;
+
+struct snapshot_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t kind;      /* network type, see `snapshot_kind` */
+  uint32_t node_size; /* `sizeof` of the storage node */
+  uint32_t flags;     /* bit 0: names */
+  uint64_t payload_size;
+  uint64_t checksum;
+};
+
+template<class Ntk>
+constexpr uint32_t snapshot_kind()
+{
+  using base = typename Ntk::base_type;
+  if constexpr ( std::is_same_v<base, aig_network> )
+    return 1u;
+  else if constexpr ( std::is_same_v<base, xag_network> )
+    return 2u;
+  else if constexpr ( std::is_same_v<base, mig_network> )
+    return 3u;
+  else if constexpr ( std::is_same_v<base, xmg_network> )
+    return 4u;
+  else if constexpr ( std::is_same_v<base, klut_network> )
+    return 5u;
+  else if constexpr ( std::is_same_v<base, inline_klut_network> )
+    return 6u;
+  else
+    return 0u;
+}
+
+template<class Data, class = void>
+struct has_fanout_tracking : std::false_type
+{
+};
+
+template<class Data>
+struct has_fanout_tracking<Data, std::void_t<decltype( std::declval<Data>().track_fanouts )>> : std::true_type
+{
+};
+
+/* 64-bit checksum over a byte stream, computed word by word */
+class snapshot_checksum
+{
+public:
+  void update( char const* p, std::size_t n )
+  {
+    for ( ; n > 0u && _pending != 0u; --n )
+    {
+      push_byte( *p++ );
+    }
+    for ( ; n >= 8u; n -= 8u, p += 8u )
+    {
+      uint64_t word;
+      std::memcpy( &word, p, 8u );
+      mix( word );
+    }
+    for ( ; n > 0u; --n )
+    {
+      push_byte( *p++ );
+    }
+  }
+
+  uint64_t value() const
+  {
+    auto copy = *this;
+    if ( copy._pending != 0u )
+    {
+      copy.mix( copy._word );
+    }
+    return copy._hash;
+  }
+
+private:
+  void push_byte( char c )
+  {
+    _word |= uint64_t( static_cast<uint8_t>( c ) ) << ( 8u * _pending );
+    if ( ++_pending == 8u )
+    {
+      mix( _word );
+      _word = 0u;
+      _pending = 0u;
+    }
+  }
+
+  void mix( uint64_t word )
+  {
+    _hash = ( _hash ^ word ) * UINT64_C( 0x9e3779b97f4a7c15 );
+    _hash ^= _hash >> 32;
+  }
+
+private:
+  uint64_t _hash{UINT64_C( 0xcbf29ce484222325 )};
+  uint64_t _word{0u};
+  uint32_t _pending{0u};
+};
+
+/* output archive */
+class snapshot_writer
+{
+public:
+  explicit snapshot_writer( std::string const& filename )
+      : _os( filename, std::ofstream::binary | std::ofstream::trunc )
+  {
+  }
+
+  bool dump( char const* p, std::size_t n )
+  {
+    _checksum.update( p, n );
+    _os.write( p, n );
+    _size += n;
+    return static_cast<bool>( _os );
+  }
+
+  template<typename V>
+  bool dump( V const& v )
+  {
+    static_assert( std::is_trivially_copyable_v<V>, "V is not trivially copyable" );
+    return dump( reinterpret_cast<char const*>( &v ), sizeof( V ) );
+  }
+
+  template<typename V>
+  bool dump_array( V const* v, std::size_t count )
+  {
+    static_assert( std::is_trivially_copyable_v<V>, "V is not trivially copyable" );
+    return dump( uint64_t( count ) ) && dump( reinterpret_cast<char const*>( v ), count * sizeof( V ) ) && align();
+  }
+
+  bool dump_string( std::string const& s )
+  {
+    return dump_array( s.data(), s.size() );
+  }
+
+  /* pads the payload to a multiple of 8 bytes */
+  bool align()
+  {
+    static constexpr char zeros[8] = {};
+    return ( _size % 8u == 0u ) || dump( zeros, 8u - _size % 8u );
+  }
+
+  bool is_open() const { return _os.is_open(); }
+  uint64_t size() const { return _size; }
+  uint64_t checksum() const { return _checksum.value(); }
+
+  bool write_header( snapshot_header const& header )
+  {
+    _os.seekp( 0 );
+    _os.write( reinterpret_cast<char const*>( &header ), sizeof( header ) );
+    _os.flush();
+    return static_cast<bool>( _os );
+  }
+
+  void skip_header()
+  {
+    snapshot_header header{};
+    _os.write( reinterpret_cast<char const*>( &header ), sizeof( header ) );
+  }
+
+  void close() { _os.close(); }
+
+private:
+  std::ofstream _os;
+  snapshot_checksum _checksum;
+  uint64_t _size{0u};
+};
+
+/* input archive over a memory-mapped payload */
+class snapshot_reader
+{
+public:
+  snapshot_reader( char const* begin, char const* end )
+      : _begin( begin ), _pos( begin ), _end( end )
+  {
+  }
+
+  /* returns a pointer to the next `n` bytes and skips them */
+  char const* take( std::size_t n )
+  {
+    if ( static_cast<std::size_t>( _end - _pos ) < n )
+    {
+      _pos = _end;
+      _failed = true;
+      return nullptr;
+    }
+    auto const p = _pos;
+    _pos += n;
+    return p;
+  }
+
+  bool load( char* p, std::size_t n )
+  {
+    auto const src = take( n );
+    if ( src != nullptr )
+    {
+      std::memcpy( p, src, n );
+    }
+    return src != nullptr;
+  }
+
+  template<typename V>
+  bool load( V* v )
+  {
+    static_assert( std::is_trivially_copyable_v<V>, "V is not trivially copyable" );
+    return load( reinterpret_cast<char*>( v ), sizeof( V ) );
+  }
+
+  /* returns a pointer to an array written with `dump_array` */
+  template<typename V>
+  V const* load_array( uint64_t& count )
+  {
+    if ( !load( &count ) || count > static_cast<uint64_t>( _end - _pos ) / sizeof( V ) )
+    {
+      _failed = true;
+      return nullptr;
+    }
+    auto const p = reinterpret_cast<V const*>( take( count * sizeof( V ) ) );
+    align();
+    return p;
+  }
+
+  template<typename V>
+  bool load_vector( std::vector<V>& v )
+  {
+    uint64_t count;
+    auto const p = load_array<V>( count );
+    if ( p != nullptr )
+    {
+      v.assign( p, p + count );
+    }
+    return !_failed;
+  }
+
+  bool load_string( std::string& s )
+  {
+    uint64_t count;
+    auto const p = load_array<char>( count );
+    if ( p != nullptr )
+    {
+      s.assign( p, count );
+    }
+    return !_failed;
+  }
+
+  void align()
+  {
+    take( ( 8u - static_cast<std::size_t>( _pos - _begin ) % 8u ) % 8u );
+  }
+
+  bool failed() const { return _failed; }
+
+private:
+  char const* _begin;
+  char const* _pos;
+  char const* _end;
+  bool _failed{false};
+};
+
+template<class Storage>
+bool write_snapshot_storage( Storage const& storage, snapshot_writer& os )
+{
+  using node_type = typename Storage::node_type;
+
+  /* nodes */
+  if constexpr ( std::is_trivially_copyable_v<node_type> )
+  {
+    os.dump_array( storage.nodes.data(), storage.nodes.size() );
+  }
+  else
+  {
+    using pointer_type = typename node_type::pointer_type;
+
+    std::vector<uint32_t> num_fanins;
+    std::vector<pointer_type> fanins;
+    std::vector<decltype( node_type::data )> data;
+    num_fanins.reserve( storage.nodes.size() );
+    data.reserve( storage.nodes.size() );
+    for ( auto const& n : storage.nodes )
+    {
+      num_fanins.push_back( static_cast<uint32_t>( n.children.size() ) );
+      fanins.insert( fanins.end(), n.children.begin(), n.children.end() );
+      data.push_back( n.data );
+    }
+    os.dump_array( num_fanins.data(), num_fanins.size() );
+    os.dump_array( fanins.data(), fanins.size() );
+    os.dump_array( data.data(), data.size() );
+  }
+
+  /* inputs and outputs */
+  os.dump_array( storage.inputs.data(), storage.inputs.size() );
+  os.dump_array( storage.outputs.data(), storage.outputs.size() );
+
+  /* structural hash table (rebuilt from the indices of the hashed nodes) */
+  std::vector<uint64_t> hashed;
+  hashed.reserve( storage.hash.size() );
+  for ( auto const& [n, index] : storage.hash )
+  {
+    hashed.push_back( index );
+  }
+  os.dump_array( hashed.data(), hashed.size() );
+
+  /* latch information */
+  os.dump( uint64_t( storage.latch_information.size() ) );
+  for ( auto const& [index, info] : storage.latch_information )
+  {
+    os.dump( uint64_t( index ) );
+    os.dump( uint64_t( info.init ) );
+    os.dump_string( info.control );
+    os.dump_string( info.type );
+  }
+
+  /* storage data */
+  auto const& data = storage.data;
+  uint32_t track_fanouts{0u};
+  if constexpr ( has_fanout_tracking<decltype( storage.data )>::value )
+  {
+    track_fanouts = data.track_fanouts ? 1u : 0u;
+  }
+  os.dump( data.num_pis );
+  os.dump( data.num_pos );
+  os.dump( data.trav_id );
+  os.dump( track_fanouts );
+  os.dump_array( data.latches.data(), data.latches.size() );
+
+  /* truth tables of k-LUT networks */
+  if constexpr ( std::is_same_v<std::decay_t<decltype( data )>, klut_storage_data> )
+  {
+    auto const& cache = *data.cache;
+    os.dump( uint64_t( cache.size() ) );
+    for ( auto i = 0u; i < cache.size(); ++i )
+    {
+      auto const tt = cache[2 * i];
+      os.dump( uint64_t( tt.num_vars() ) );
+      os.dump_array( tt._bits.data(), tt._bits.size() );
+    }
+  }
+
+  return os.align();
+}
+
+template<class Storage>
+bool read_snapshot_storage( Storage& storage, snapshot_reader& in, bool& track_fanouts )
+{
+  using node_type = typename Storage::node_type;
+
+  /* nodes */
+  if constexpr ( std::is_trivially_copyable_v<node_type> )
+  {
+    in.load_vector( storage.nodes );
+  }
+  else
+  {
+    using pointer_type = typename node_type::pointer_type;
+
+    uint64_t num_nodes{0}, num_total_fanins{0}, num_data{0};
+    auto const num_fanins = in.load_array<uint32_t>( num_nodes );
+    auto const fanins = in.load_array<pointer_type>( num_total_fanins );
+    auto const data = in.load_array<decltype( node_type::data )>( num_data );
+    if ( in.failed() || num_data != num_nodes )
+    {
+      return false;
+    }
+
+    storage.nodes.clear();
+    storage.nodes.resize( num_nodes );
+    uint64_t offset{0};
+    for ( auto i = 0u; i < num_nodes; ++i )
+    {
+      if ( offset + num_fanins[i] > num_total_fanins )
+      {
+        return false;
+      }
+      auto& n = storage.nodes[i];
+      for ( auto j = 0u; j < num_fanins[i]; ++j )
+      {
+        n.children.push_back( fanins[offset++] );
+      }
+      n.data = data[i];
+    }
+  }
+
+  /* inputs and outputs */
+  in.load_vector( storage.inputs );
+  in.load_vector( storage.outputs );
+
+  /* structural hash table */
+  uint64_t num_hashed{0};
+  auto const hashed = in.load_array<uint64_t>( num_hashed );
+  if ( in.failed() )
+  {
+    return false;
+  }
+  storage.hash.clear();
+  storage.hash.reserve( num_hashed );
+  for ( auto i = 0u; i < num_hashed; ++i )
+  {
+    if ( hashed[i] >= storage.nodes.size() )
+    {
+      return false;
+    }
+    storage.hash.emplace( storage.nodes[hashed[i]], hashed[i] );
+  }
+
+  /* latch information */
+  uint64_t num_latches{0};
+  in.load( &num_latches );
+  storage.latch_information.clear();
+  for ( auto i = 0u; i < num_latches && !in.failed(); ++i )
+  {
+    uint64_t index{0};
+    latch_info info;
+    in.load( &index );
+    in.load( &info.init );
+    in.load_string( info.control );
+    in.load_string( info.type );
+    storage.latch_information.emplace( index, info );
+  }
+
+  /* storage data */
+  auto& data = storage.data;
+  uint32_t fanouts{0u};
+  in.load( &data.num_pis );
+  in.load( &data.num_pos );
+  in.load( &data.trav_id );
+  in.load( &fanouts );
+  in.load_vector( data.latches );
+  track_fanouts = fanouts != 0u;
+
+  /* truth tables of k-LUT networks */
+  if constexpr ( std::is_same_v<std::decay_t<decltype( data )>, klut_storage_data> )
+  {
+    uint64_t num_tts{0};
+    in.load( &num_tts );
+    data.cache = std::make_shared<truth_table_cache<kitty::dynamic_truth_table>>( static_cast<uint32_t>( num_tts ) );
+    for ( auto i = 0u; i < num_tts && !in.failed(); ++i )
+    {
+      uint64_t num_vars{0}, num_words{0};
+      in.load( &num_vars );
+      auto const words = in.load_array<uint64_t>( num_words );
+      if ( in.failed() || num_vars > 32u )
+      {
+        return false;
+      }
+      kitty::dynamic_truth_table tt( static_cast<uint32_t>( num_vars ) );
+      if ( num_words != tt.num_blocks() )
+      {
+        return false;
+      }
+      std::copy( words, words + num_words, tt.begin() );
+      if ( data.cache->insert( tt ) != 2 * i )
+      {
+        return false;
+      }
+    }
+  }
+
+  in.align();
+  return !in.failed();
+}
+
+} // namespace detail
+/*! \endcond */
+
+/*! \brief Writes a binary snapshot of a network.
+ *
+ * Writes the complete state of the network, and its names if `Ntk` is a
+ * `names_view`, into a binary file that can be loaded with `read_snapshot`.
+ * The storage arrays of the network are written as contiguous blocks,
+ * preceded by a header with a format version, the network type, and a
+ * checksum of the contents.  The snapshot is first written into a temporary
+ * file, which then replaces `filename`, such that an existing snapshot is
+ * never left partially overwritten.
+ *
+ * Supported network types are `aig_network`, `xag_network`, `mig_network`,
+ * `xmg_network`, `klut_network`, and `inline_klut_network`.
+ *
+ * \param ntk Network
+ * \param filename Filename
+ * \return Whether the snapshot was written successfully
+ */
+template<class Ntk>
+bool write_snapshot( Ntk const& ntk, std::string const& filename )
+{
+  static_assert( detail::snapshot_kind<Ntk>() != 0u, "Ntk is not supported by the snapshot format" );
+
+  auto const tmp_filename = filename + ".tmp";
+  detail::snapshot_writer os( tmp_filename );
+  if ( !os.is_open() )
+  {
+    return false;
+  }
+  os.skip_header();
+
+  uint32_t flags{0u};
+  bool okay = detail::write_snapshot_storage( *ntk._storage, os );
+
+  if constexpr ( has_get_network_name_v<Ntk> && has_get_name_v<Ntk> && has_get_output_name_v<Ntk> )
+  {
+    flags |= 1u;
+    os.dump_string( ntk.get_network_name() );
+
+    std::vector<std::pair<uint64_t, std::string const*>> signal_names;
+    ntk.foreach_signal_name( [&]( auto const& s, auto const& name ) {
+      signal_names.emplace_back( ( uint64_t( ntk.node_to_index( ntk.get_node( s ) ) ) << 1 ) | ( ntk.is_complemented( s ) ? 1u : 0u ), &name );
+    } );
+    os.dump( uint64_t( signal_names.size() ) );
+    for ( auto const& [literal, name] : signal_names )
+    {
+      os.dump( literal );
+      os.dump_string( *name );
+    }
+
+    std::vector<std::pair<uint64_t, std::string const*>> output_names;
+    ntk.foreach_output_name( [&]( auto index, auto const& name ) {
+      output_names.emplace_back( index, &name );
+    } );
+    os.dump( uint64_t( output_names.size() ) );
+    for ( auto const& [index, name] : output_names )
+    {
+      os.dump( index );
+      os.dump_string( *name );
+    }
+    okay = okay && os.align();
+  }
+
+  detail::snapshot_header header{};
+  std::copy( std::begin( detail::snapshot_magic ), std::end( detail::snapshot_magic ), header.magic );
+  header.version = detail::snapshot_version;
+  header.kind = detail::snapshot_kind<Ntk>();
+  header.node_size = sizeof( typename Ntk::storage::element_type::node_type );
+  header.flags = flags;
+  header.payload_size = os.size();
+  header.checksum = os.checksum();
+  okay = os.write_header( header ) && okay;
+  os.close();
+
+  if ( !okay || std::rename( tmp_filename.c_str(), filename.c_str() ) != 0 )
+  {
+    std::remove( tmp_filename.c_str() );
+    return false;
+  }
+  return true;
+}
+
+/*! \brief Reads a binary snapshot of a network.
+ *
+ * Loads a network written with `write_snapshot`.  The file is
+ * memory-mapped, and the node arrays of networks with a fixed number of
+ * fan-ins are copied as blocks.  The structural hash table is rebuilt by
+ * inserting the hashed nodes one by one, and k-LUT networks rebuild the
+ * fan-ins of each node and re-insert every truth table into the cache.  If
+ * fan-out tracking was enabled when writing the snapshot, it is enabled
+ * again, which computes the fan-outs of all nodes.
+ *
+ * Returns `std::nullopt` if the file cannot be read, if it is not a
+ * snapshot of a network of type `Ntk` in the current format version, or if
+ * its checksum does not match.
+ *
+ * \param filename Filename
+ * \return Network
+ */
+template<class Ntk>
+std::optional<Ntk> read_snapshot( std::string const& filename )
+{
+  static_assert( detail::snapshot_kind<Ntk>() != 0u, "Ntk is not supported by the snapshot format" );
+
+  detail::mapped_file file( filename );
+  if ( !file.is_open() || static_cast<std::size_t>( file.end() - file.begin() ) < sizeof( detail::snapshot_header ) )
+  {
+    return std::nullopt;
+  }
+
+  detail::snapshot_header header;
+  std::memcpy( &header, file.begin(), sizeof( header ) );
+  if ( !std::equal( std::begin( detail::snapshot_magic ), std::end( detail::snapshot_magic ), header.magic ) ||
+       header.version != detail::snapshot_version ||
+       header.kind != detail::snapshot_kind<Ntk>() ||
+       header.node_size != sizeof( typename Ntk::storage::element_type::node_type ) ||
+       header.payload_size != static_cast<uint64_t>( file.end() - file.begin() ) - sizeof( header ) )
+  {
+    return std::nullopt;
+  }
+
+  auto const payload = file.begin() + sizeof( header );
+  detail::snapshot_checksum checksum;
+  checksum.update( payload, header.payload_size );
+  if ( checksum.value() != header.checksum )
+  {
+    return std::nullopt;
+  }
+
+  Ntk ntk;
+  detail::snapshot_reader in( payload, file.end() );
+  bool track_fanouts{false};
+  if ( !detail::read_snapshot_storage( *ntk._storage, in, track_fanouts ) )
+  {
+    return std::nullopt;
+  }
+
+  if constexpr ( has_get_network_name_v<Ntk> && has_get_name_v<Ntk> && has_get_output_name_v<Ntk> )
+  {
+    if ( header.flags & 1u )
+    {
+      std::string name;
+      in.load_string( name );
+      ntk.set_network_name( name );
+
+      uint64_t num_names{0};
+      in.load( &num_names );
+      for ( auto i = 0u; i < num_names && !in.failed(); ++i )
+      {
+        uint64_t literal{0};
+        in.load( &literal );
+        in.load_string( name );
+        if ( ( literal >> 1 ) >= ntk.size() )
+        {
+          return std::nullopt;
+        }
+        auto const s = ntk.make_signal( ntk.index_to_node( static_cast<uint32_t>( literal >> 1 ) ) );
+        ntk.set_name( ( literal & 1 ) ? ntk.create_not( s ) : s, name );
+      }
+
+      in.load( &num_names );
+      for ( auto i = 0u; i < num_names && !in.failed(); ++i )
+      {
+        uint64_t index{0};
+        in.load( &index );
+        in.load_string( name );
+        ntk.set_output_name( static_cast<uint32_t>( index ), name );
+      }
+      in.align();
+    }
+  }
+
+  if ( in.failed() )
+  {
+    return std::nullopt;
+  }
+
+  if constexpr ( detail::has_fanout_tracking<decltype( ntk._storage->data )>::value )
+  {
+    if ( track_fanouts )
+    {
+      ntk.enable_fanout_tracking();
+    }
+  }
+
+  return ntk;
+}
+
+} /* namespace mockturtle */
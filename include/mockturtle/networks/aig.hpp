@@ -39,6 +39,8 @@
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
+#include "detail/compact_storage.hpp"
+#include "detail/fanout_lists.hpp"
 #include "detail/foreach.hpp"
 #include "events.hpp"
 #include "storage.hpp"
@@ -52,6 +54,7 @@
 #include <optional>
 #include <stack>
 #include <string>
+#include <unordered_map>
 
 namespace mockturtle
 {
@@ -77,6 +80,8 @@ struct aig_storage_data
   uint32_t num_pos = 0u;
   std::vector<int8_t> latches;
   uint32_t trav_id = 0u;
+  bool track_fanouts = false;
+  detail::fanout_lists<uint32_t> fanouts;
 };
 
 /*! \brief AIG storage container
@@ -93,15 +98,34 @@ using aig_storage = storage<regular_node<2, 2, 1>,
                             aig_storage_data,
                             aig_hash<regular_node<2, 2, 1>>>;
 
-class aig_network
+/*! \brief AIG storage container with structure-of-arrays layout
+
+  Stores the same information as `aig_storage`, but fan-ins are packed
+  32-bit literals and fan-out size, application-specific value, and visited
+  flag are kept in three separate arrays (see `soa_storage`).  The structural
+  hash table maps to 32-bit indexes.  This reduces memory by about a half and
+  keeps traversals over fan-ins from touching the remaining node data.
+  Networks are restricted to 2^31 nodes.
+*/
+using aig_soa_storage = soa_storage<compact_node<2, 1>,
+                                aig_storage_data,
+                                aig_hash<compact_node<2, 1>>>;
+
+/*! \brief AIG network parameterized by its storage container
+
+  `Storage` is either `aig_storage` (default) or `aig_soa_storage`.  Use the
+  type aliases `aig_network` and `soa_aig_network`.
+*/
+template<class Storage = aig_storage>
+class basic_aig_network
 {
 public:
 #pragma region Types and constructors
   static constexpr auto min_fanin_size = 2u;
   static constexpr auto max_fanin_size = 2u;
 
-  using base_type = aig_network;
-  using storage = std::shared_ptr<aig_storage>;
+  using base_type = basic_aig_network;
+  using storage = std::shared_ptr<Storage>;
   using node = uint64_t;
 
   struct signal
@@ -118,7 +142,7 @@ public:
     {
     }
 
-    signal( aig_storage::node_type::pointer_type const& p )
+    signal( typename Storage::node_type::pointer_type const& p )
         : complement( p.weight ), index( p.index )
     {
     }
@@ -167,30 +191,42 @@ public:
       return data < other.data;
     }
 
-    operator aig_storage::node_type::pointer_type() const
+    operator typename Storage::node_type::pointer_type() const
     {
       return {index, complement};
     }
 
 #if __cplusplus > 201703L
-    bool operator==( aig_storage::node_type::pointer_type const& other ) const
+    bool operator==( typename Storage::node_type::pointer_type const& other ) const
     {
       return data == other.data;
     }
 #endif
   };
 
-  aig_network()
-      : _storage( std::make_shared<aig_storage>() ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+  basic_aig_network()
+      : _storage( std::make_shared<Storage>() ),
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
 
-  aig_network( std::shared_ptr<aig_storage> storage )
+  basic_aig_network( std::shared_ptr<Storage> storage )
       : _storage( storage ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
+
+  /*! \brief Reserves memory for a network with `num_nodes` nodes.
+   *
+   * Reserves the node array and the structural hash table, such that they
+   * are not reallocated while the network grows to `num_nodes` nodes.
+   */
+  void reserve( uint64_t num_nodes )
+  {
+    /* node creation grows the arrays once 90% of the capacity is used */
+    _storage->nodes.reserve( static_cast<uint64_t>( num_nodes / .9 ) + 1u );
+    _storage->hash.reserve( num_nodes );
+  }
 #pragma endregion
 
 #pragma region Primary I / O and constants
@@ -204,7 +240,7 @@ public:
     (void)name;
 
     const auto index = _storage->nodes.size();
-    auto& node = _storage->nodes.emplace_back();
+    auto&& node = _storage->nodes.emplace_back();
     node.children[0].data = node.children[1].data = _storage->inputs.size();
     _storage->inputs.emplace_back( index );
     ++_storage->data.num_pis;
@@ -228,7 +264,7 @@ public:
     (void)name;
 
     auto const index = _storage->nodes.size();
-    auto& node = _storage->nodes.emplace_back();
+    auto&& node = _storage->nodes.emplace_back();
     node.children[0].data = node.children[1].data = _storage->inputs.size();
     _storage->inputs.emplace_back( index );
     return {index, 0};
@@ -316,7 +352,7 @@ public:
       return a.complement ? b : get_constant( false );
     }
 
-    storage::element_type::node_type node;
+    typename Storage::node_type node;
     node.children[0] = a;
     node.children[1] = b;
 
@@ -344,6 +380,12 @@ public:
     _storage->nodes[a.index].data[0].h1++;
     _storage->nodes[b.index].data[0].h1++;
 
+    if ( _storage->data.track_fanouts )
+    {
+      _storage->data.fanouts.push_back( static_cast<uint32_t>( a.index ), static_cast<uint32_t>( index ) );
+      _storage->data.fanouts.push_back( static_cast<uint32_t>( b.index ), static_cast<uint32_t>( index ) );
+    }
+
     for ( auto const& fn : _events->on_add )
     {
       (*fn)( index );
@@ -439,7 +481,7 @@ public:
 #pragma endregion
 
 #pragma region Create arbitrary functions
-  signal clone_node( aig_network const& other, node const& source, std::vector<signal> const& children )
+  signal clone_node( basic_aig_network const& other, node const& source, std::vector<signal> const& children )
   {
     (void)other;
     (void)source;
@@ -451,7 +493,7 @@ public:
 #pragma region Restructuring
   std::optional<std::pair<node, signal>> replace_in_node( node const& n, node const& old_node, signal new_signal )
   {
-    auto& node = _storage->nodes[n];
+    auto&& node = _storage->nodes[n];
 
     uint32_t fanin = 0u;
     if ( node.children[0].index == old_node )
@@ -490,7 +532,7 @@ public:
     }
 
     // node already in hash table
-    storage::element_type::node_type _hash_obj;
+    typename Storage::node_type _hash_obj;
     _hash_obj.children[0] = child0;
     _hash_obj.children[1] = child1;
     if ( const auto it = _storage->hash.find( _hash_obj ); it != _storage->hash.end() && it->second != old_node )
@@ -513,6 +555,12 @@ public:
     // update the reference counter of the new signal
     _storage->nodes[new_signal.index].data[0].h1++;
 
+    if ( _storage->data.track_fanouts )
+    {
+      _storage->data.fanouts.erase( static_cast<uint32_t>( old_node ), static_cast<uint32_t>( n ) );
+      _storage->data.fanouts.push_back( static_cast<uint32_t>( new_signal.index ), static_cast<uint32_t>( n ) );
+    }
+
     for ( auto const& fn : _events->on_modified )
     {
       (*fn)( n, {old_child0, old_child1} );
@@ -549,10 +597,19 @@ public:
       return;
 
     /* delete the node (ignoring it's current fanout_size) */
-    auto& nobj = _storage->nodes[n];
+    auto&& nobj = _storage->nodes[n];
     nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
     _storage->hash.erase( nobj );
 
+    if ( _storage->data.track_fanouts )
+    {
+      for ( auto const& child : nobj.children )
+      {
+        _storage->data.fanouts.erase( static_cast<uint32_t>( child.index ), static_cast<uint32_t>( n ) );
+      }
+      _storage->data.fanouts.clear( static_cast<uint32_t>( n ) );
+    }
+
     for ( auto const& fn : _events->on_delete )
     {
       (*fn)( n );
@@ -588,16 +645,15 @@ public:
       const auto [_old, _new] = to_substitute.top();
       to_substitute.pop();
 
-      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-      {
+      foreach_substitution_candidate( _old, [&]( node const& idx ) {
         if ( is_ci( idx ) || is_dead( idx ) )
-          continue; /* ignore CIs */
+          return; /* ignore CIs */
 
         if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
         {
           to_substitute.push( *repl );
         }
-      }
+      } );
 
       /* check outputs */
       replace_in_outputs( _old, _new );
@@ -612,8 +668,16 @@ public:
 
   void substitute_nodes( std::list<std::pair<node, signal>> substitutions )
   {
+    /* number of pending substitutions of each node */
+    std::unordered_map<node, uint32_t> pending;
+    for ( auto const& s : substitutions )
+    {
+      ++pending[s.first];
+    }
+
     auto clean_substitutions = [&]( node const& n )
     {
+      pending.erase( n );
       substitutions.erase( std::remove_if( std::begin( substitutions ), std::end( substitutions ),
                                            [&]( auto const& s ){
                                              if ( s.first == n )
@@ -655,25 +719,28 @@ public:
     {
       auto const [old_node, new_signal] = substitutions.front();
       substitutions.pop_front();
-
-      for ( auto index = 1u; index < _storage->nodes.size(); ++index )
+      if ( auto it = pending.find( old_node ); it != pending.end() && --it->second == 0u )
       {
+        pending.erase( it );
+      }
+
+      foreach_substitution_candidate( old_node, [&]( node const& index ) {
         /* skip CIs and dead nodes */
         if ( is_ci( index ) || is_dead( index ) )
-          continue;
+          return;
 
         /* skip nodes that will be deleted */
-        if ( std::find_if( std::begin( substitutions ), std::end( substitutions ),
-                           [&index]( auto s ){ return s.first == index; } ) != std::end( substitutions ) )
-          continue;
+        if ( pending.count( index ) != 0u )
+          return;
 
         /* replace in node */
         if ( const auto repl = replace_in_node( index, old_node, new_signal ); repl )
         {
           incr_fanout_size( get_node( repl->second ) );
           substitutions.emplace_back( *repl );
+          ++pending[repl->first];
         }
-      }
+      } );
 
       /* replace in outputs */
       replace_in_outputs( old_node, new_signal );
@@ -701,6 +768,76 @@ public:
 
     _events->release_delete_event( clean_sub_event );
   }
+
+  /*! \brief Removes dead nodes and renumbers the remaining ones.
+   *
+   * The constant comes first, followed by the CIs and then by the gates in
+   * topological order.  Returns the new index of each old node, which can
+   * be used to migrate node-indexed containers; dead nodes are mapped to
+   * `std::numeric_limits<node>::max()`.  Views on the network must be
+   * recomputed afterwards.
+   */
+  std::vector<node> compact()
+  {
+    auto old_to_new = detail::compact_storage( *_storage, []( auto const& ) { return false; } );
+    if ( _storage->data.track_fanouts )
+    {
+      enable_fanout_tracking();
+    }
+    return old_to_new;
+  }
+
+  /*! \brief Maintains the fanouts of each node in the storage.
+   *
+   * With fanout tracking, substituting a node only visits the gates that
+   * refer to it instead of all nodes in the network.  The fanouts live in
+   * the storage and are thus shared by all shallow copies of the network.
+   */
+  void enable_fanout_tracking()
+  {
+    auto& data = _storage->data;
+    data.fanouts.build( static_cast<uint32_t>( _storage->nodes.size() ), [&]( auto&& add_fanout ) {
+      foreach_gate( [&]( auto const& n ) {
+        foreach_fanin( n, [&]( auto const& f ) {
+          add_fanout( static_cast<uint32_t>( get_node( f ) ), static_cast<uint32_t>( n ) );
+        } );
+      } );
+    } );
+    data.track_fanouts = true;
+  }
+
+  void disable_fanout_tracking()
+  {
+    _storage->data.track_fanouts = false;
+    _storage->data.fanouts = {};
+  }
+
+  bool has_fanout_tracking() const
+  {
+    return _storage->data.track_fanouts;
+  }
+
+  /* calls `fn` on all nodes that may have `n` as fanin, in index order */
+  template<typename Fn>
+  void foreach_substitution_candidate( node const& n, Fn&& fn ) const
+  {
+    if ( _storage->data.track_fanouts )
+    {
+      auto parents = _storage->data.fanouts.to_vector( static_cast<uint32_t>( n ) );
+      std::sort( parents.begin(), parents.end() );
+      for ( auto const& p : parents )
+      {
+        fn( p );
+      }
+    }
+    else
+    {
+      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
+      {
+        fn( idx );
+      }
+    }
+  }
 #pragma endregion
 
 #pragma region Structural properties
@@ -1169,7 +1306,7 @@ public:
 #pragma region Custom node values
   void clear_values() const
   {
-    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[0].h2 = 0; } );
+    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto&& n ) { n.data[0].h2 = 0; } );
   }
 
   auto value( node const& n ) const
@@ -1196,7 +1333,7 @@ public:
 #pragma region Visited flags
   void clear_visited() const
   {
-    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[1].h1 = 0; } );
+    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto&& n ) { n.data[1].h1 = 0; } );
   }
 
   auto visited( node const& n ) const
@@ -1228,10 +1365,13 @@ public:
 #pragma endregion
 
 public:
-  std::shared_ptr<aig_storage> _storage;
+  std::shared_ptr<Storage> _storage;
   std::shared_ptr<network_events<base_type>> _events;
 };
 
+using aig_network = basic_aig_network<aig_storage>;
+using soa_aig_network = basic_aig_network<aig_soa_storage>;
+
 } // namespace mockturtle
 
 namespace std
@@ -1252,4 +1392,19 @@ struct hash<mockturtle::aig_network::signal>
   }
 }; /* hash */
 
+template<>
+struct hash<mockturtle::soa_aig_network::signal>
+{
+  uint64_t operator()( mockturtle::soa_aig_network::signal const &s ) const noexcept
+  {
+    uint64_t k = s.data;
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccd;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53;
+    k ^= k >> 33;
+    return k;
+  }
+}; /* hash */
+
 } // namespace std
@@ -0,0 +1,225 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file compact_storage.hpp
+  \brief Removes dead nodes from a storage
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "../storage.hpp"
+
+namespace mockturtle::detail
+{
+
+/* reorders `v` such that `v[i]` becomes the old `v[order[i]]` and keeps the
+ * first `num_kept` elements; `order` must be a permutation */
+template<typename T>
+void permute_and_truncate( std::vector<T>& v, std::vector<uint64_t> const& order, uint64_t num_kept )
+{
+  std::vector<bool> done( order.size(), false );
+  for ( uint64_t i = 0u; i < order.size(); ++i )
+  {
+    if ( done[i] )
+    {
+      continue;
+    }
+
+    /* follow the cycle starting in i */
+    T tmp = v[i];
+    auto j = i;
+    while ( order[j] != i )
+    {
+      v[j] = v[order[j]];
+      done[j] = true;
+      j = order[j];
+    }
+    v[j] = tmp;
+    done[j] = true;
+  }
+  v.erase( v.begin() + num_kept, v.end() );
+}
+
+template<typename Node>
+void permute_nodes( std::vector<Node>& nodes, std::vector<uint64_t> const& order, uint64_t num_kept )
+{
+  permute_and_truncate( nodes, order, num_kept );
+}
+
+template<typename Node, int NumWords>
+void permute_nodes( soa_node_container<Node, NumWords>& nodes, std::vector<uint64_t> const& order, uint64_t num_kept )
+{
+  permute_and_truncate( nodes.fanins, order, num_kept );
+  for ( auto& w : nodes.words )
+  {
+    permute_and_truncate( w, order, num_kept );
+  }
+}
+
+/*! \brief Removes dead nodes from a storage.
+ *
+ * Works on the storages of networks with fixed fan-in size, in which the
+ * MSB of `data[0].h1` marks dead nodes.  The remaining nodes are renumbered:
+ * the constant comes first, followed by the CIs in their order, followed by
+ * the gates in topological order.  Node data, CIs, COs, latch information,
+ * and the structural hash table are updated accordingly.
+ *
+ * The fan-ins of each gate are sorted again by their new indexes, in
+ * ascending order, or in descending order if `is_descending( children )`
+ * returns true for the old fan-ins.  This keeps the normal form of the
+ * network's `create_*` methods (XAGs and XMGs encode XOR gates by the order
+ * of their fan-ins), such that structural hashing finds existing gates.
+ *
+ * Returns the new index of each old node; dead nodes are mapped to
+ * `std::numeric_limits<uint64_t>::max()`.
+ */
+template<typename Storage, typename DescendingFn>
+std::vector<uint64_t> compact_storage( Storage& storage, DescendingFn&& is_descending )
+{
+  constexpr auto invalid = std::numeric_limits<uint64_t>::max();
+
+  auto& nodes = storage.nodes;
+  auto const size = static_cast<uint64_t>( nodes.size() );
+  auto const is_dead = [&]( uint64_t n ) {
+    return ( ( nodes[n].data[0].h1 >> 31 ) & 1 ) == 1;
+  };
+
+  std::vector<uint64_t> old_to_new( size, invalid );
+  std::vector<uint64_t> order;
+  order.reserve( size );
+  auto const assign = [&]( uint64_t n ) {
+    old_to_new[n] = order.size();
+    order.push_back( n );
+  };
+
+  /* constant and CIs */
+  assign( 0u );
+  for ( auto const& ci : storage.inputs )
+  {
+    assign( ci );
+  }
+  auto const num_fixed = order.size();
+
+  /* gates in topological order (iterative DFS, fanins before fanouts) */
+  std::vector<uint64_t> stack;
+  for ( uint64_t n = 1u; n < size; ++n )
+  {
+    if ( old_to_new[n] != invalid || is_dead( n ) )
+    {
+      continue;
+    }
+
+    stack.push_back( n );
+    while ( !stack.empty() )
+    {
+      auto const top = stack.back();
+      auto next = invalid;
+      for ( auto const& child : nodes[top].children )
+      {
+        if ( old_to_new[child.index] == invalid )
+        {
+          assert( !is_dead( child.index ) );
+          next = child.index;
+          break;
+        }
+      }
+
+      if ( next != invalid )
+      {
+        stack.push_back( next );
+      }
+      else
+      {
+        stack.pop_back();
+        if ( old_to_new[top] == invalid )
+        {
+          assign( top );
+        }
+      }
+    }
+  }
+
+  /* move the live nodes to the front, and the dead nodes behind them */
+  auto const num_live = order.size();
+  for ( uint64_t n = 1u; n < size; ++n )
+  {
+    if ( old_to_new[n] == invalid )
+    {
+      order.push_back( n );
+    }
+  }
+  permute_nodes( nodes, order, num_live );
+
+  /* update references and restore the order of the fan-ins */
+  for ( auto n = num_fixed; n < num_live; ++n )
+  {
+    auto& children = nodes[n].children;
+    bool const descending = is_descending( children );
+    for ( auto& child : children )
+    {
+      child.index = old_to_new[child.index];
+    }
+    std::sort( children.begin(), children.end(), [&]( auto const& a, auto const& b ) {
+      return descending ? a.index > b.index : a.index < b.index;
+    } );
+  }
+  for ( auto& ci : storage.inputs )
+  {
+    ci = old_to_new[ci];
+  }
+  for ( auto& co : storage.outputs )
+  {
+    co.index = old_to_new[co.index];
+  }
+
+  std::unordered_map<uint64_t, latch_info> latch_information;
+  for ( auto const& [n, info] : storage.latch_information )
+  {
+    if ( n < size && old_to_new[n] != invalid )
+    {
+      latch_information.emplace( old_to_new[n], info );
+    }
+  }
+  storage.latch_information = std::move( latch_information );
+
+  storage.hash.clear();
+  for ( auto n = num_fixed; n < num_live; ++n )
+  {
+    typename Storage::node_type const key = nodes[n];
+    storage.hash[key] = static_cast<typename decltype( storage.hash )::mapped_type>( n );
+  }
+
+  return old_to_new;
+}
+
+} // namespace mockturtle::detail
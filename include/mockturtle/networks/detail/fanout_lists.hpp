@@ -0,0 +1,268 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file fanout_lists.hpp
+  \brief Fanout lists in a compressed sparse row layout
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace mockturtle::detail
+{
+
+/*! \brief Fanout lists of all nodes in a compressed sparse row layout.
+ *
+ * The fanouts of all nodes are stored in one contiguous array.  Node `i`
+ * owns the slots `[begin(i), begin(i) + capacity(i))` of which the first
+ * `size(i)` are used.  If a node runs out of slots, its list is moved to
+ * the end of the array with twice the capacity, leaving the old slots
+ * unused.  The array is compacted when more than half of it is unused.
+ * Thus, insertion takes amortized constant time.
+ *
+ * Indexes beyond the current number of lists refer to empty lists; the
+ * lists are extended on insertion.
+ */
+template<typename Node>
+class fanout_lists
+{
+public:
+  class iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Node;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Node const*;
+    using reference = Node const&;
+
+    iterator( fanout_lists const* lists, uint32_t index, uint32_t pos )
+        : _lists( lists ), _index( index ), _pos( pos )
+    {
+    }
+
+    /* the position of the list is looked up on each access, such that
+     * iterators stay valid while fanouts are added to other nodes */
+    reference operator*() const
+    {
+      return _lists->_data[_lists->_begin[_index] + _pos];
+    }
+
+    iterator& operator++()
+    {
+      ++_pos;
+      return *this;
+    }
+
+    iterator operator++( int )
+    {
+      auto const copy = *this;
+      ++_pos;
+      return copy;
+    }
+
+    bool operator==( iterator const& other ) const
+    {
+      return _pos == other._pos;
+    }
+
+    bool operator!=( iterator const& other ) const
+    {
+      return _pos != other._pos;
+    }
+
+  private:
+    fanout_lists const* _lists;
+    uint32_t _index;
+    uint32_t _pos;
+  };
+
+public:
+  /*! \brief Builds the lists from `(index, fanout)` pairs.
+   *
+   * `foreach_edge( fn )` must call `fn( index, fanout )` for each pair; it
+   * is called twice, once to count and once to fill the lists.  Repeated
+   * pairs are only stored once.
+   */
+  template<typename Fn>
+  void build( uint32_t num_nodes, Fn&& foreach_edge )
+  {
+    _begin.assign( num_nodes, 0u );
+    _size.assign( num_nodes, 0u );
+    _capacity.assign( num_nodes, 0u );
+
+    foreach_edge( [&]( uint32_t index, Node const& ) {
+      ++_capacity[index];
+    } );
+
+    uint32_t offset{0u};
+    for ( auto i = 0u; i < num_nodes; ++i )
+    {
+      _begin[i] = offset;
+      offset += _capacity[i];
+    }
+    _data.assign( offset, Node{} );
+
+    foreach_edge( [&]( uint32_t index, Node const& n ) {
+      auto const first = _data.begin() + _begin[index];
+      auto const last = first + _size[index];
+      if ( std::find( first, last, n ) == last )
+      {
+        *last = n;
+        ++_size[index];
+      }
+    } );
+    _unused = offset - std::accumulate( _size.begin(), _size.end(), 0u );
+  }
+
+  /*! \brief Adds empty lists for new nodes. */
+  void resize( uint32_t num_nodes )
+  {
+    if ( num_nodes <= _size.size() )
+    {
+      return;
+    }
+    _begin.resize( num_nodes, static_cast<uint32_t>( _data.size() ) );
+    _size.resize( num_nodes, 0u );
+    _capacity.resize( num_nodes, 0u );
+  }
+
+  void push_back( uint32_t index, Node const& n )
+  {
+    resize( index + 1u );
+    if ( _size[index] == _capacity[index] )
+    {
+      grow( index );
+    }
+    _data[_begin[index] + _size[index]++] = n;
+    --_unused;
+  }
+
+  /*! \brief Removes all occurrences of `n` (keeps the order of the others). */
+  void erase( uint32_t index, Node const& n )
+  {
+    if ( index >= _size.size() )
+    {
+      return;
+    }
+    auto const first = _data.begin() + _begin[index];
+    auto const last = first + _size[index];
+    auto const new_last = std::remove( first, last, n );
+    auto const removed = static_cast<uint32_t>( last - new_last );
+    _size[index] -= removed;
+    _unused += removed;
+  }
+
+  void clear( uint32_t index )
+  {
+    if ( index >= _size.size() )
+    {
+      return;
+    }
+    _unused += _size[index];
+    _size[index] = 0u;
+  }
+
+  /*! \brief Returns the number of fanouts of the node at `index`. */
+  uint32_t size( uint32_t index ) const
+  {
+    return index < _size.size() ? _size[index] : 0u;
+  }
+
+  iterator begin( uint32_t index ) const
+  {
+    return iterator( this, index, 0u );
+  }
+
+  iterator end( uint32_t index ) const
+  {
+    return iterator( this, index, size( index ) );
+  }
+
+  std::vector<Node> to_vector( uint32_t index ) const
+  {
+    if ( index >= _size.size() )
+    {
+      return {};
+    }
+    auto const first = _data.begin() + _begin[index];
+    return std::vector<Node>( first, first + _size[index] );
+  }
+
+private:
+  void grow( uint32_t index )
+  {
+    if ( _unused > _data.size() / 2u && _unused > 1024u )
+    {
+      compact();
+    }
+
+    auto const old_begin = _begin[index];
+    auto const new_begin = static_cast<uint32_t>( _data.size() );
+    auto const new_capacity = std::max<uint32_t>( 2u, 2u * _capacity[index] );
+    assert( _data.size() + new_capacity <= std::numeric_limits<uint32_t>::max() );
+
+    _data.resize( _data.size() + new_capacity );
+    std::copy( _data.begin() + old_begin, _data.begin() + old_begin + _size[index], _data.begin() + new_begin );
+
+    _unused += new_capacity;
+    _begin[index] = new_begin;
+    _capacity[index] = new_capacity;
+  }
+
+  /* moves all lists to the front, keeping one free slot per non-empty list */
+  void compact()
+  {
+    std::vector<Node> data;
+    data.reserve( _data.size() - _unused + _size.size() );
+    for ( auto i = 0u; i < _size.size(); ++i )
+    {
+      auto const first = _data.begin() + _begin[i];
+      _begin[i] = static_cast<uint32_t>( data.size() );
+      data.insert( data.end(), first, first + _size[i] );
+      _capacity[i] = _size[i] == 0u ? 0u : _size[i] + 1u;
+      data.resize( _begin[i] + _capacity[i] );
+    }
+    _unused = static_cast<uint32_t>( data.size() ) - std::accumulate( _size.begin(), _size.end(), 0u );
+    _data = std::move( data );
+  }
+
+private:
+  std::vector<Node> _data;
+  std::vector<uint32_t> _begin;
+  std::vector<uint32_t> _size;
+  std::vector<uint32_t> _capacity;
+  uint32_t _unused{0u};
+};
+
+} // namespace mockturtle::detail
@@ -52,7 +52,7 @@ namespace mockturtle
 
 struct klut_storage_data
 {
-  truth_table_cache<kitty::dynamic_truth_table> cache;
+  std::shared_ptr<truth_table_cache<kitty::dynamic_truth_table>> cache = std::make_shared<truth_table_cache<kitty::dynamic_truth_table>>();
   uint32_t num_pis = 0u;
   uint32_t num_pos = 0u;
   std::vector<int8_t> latches;
@@ -65,47 +65,78 @@ struct klut_storage_data
  * `data[0].h2`: Application-specific value
  * `data[1].h1`: Function literal in truth table cache
  * `data[2].h2`: Visited flags
+ *
+ * `Node` determines how the fan-ins are stored.
  */
-struct klut_storage_node : mixed_fanin_node<2>
+template<class Node>
+struct basic_klut_storage_node : Node
 {
-  bool operator==( klut_storage_node const& other ) const
+  bool operator==( basic_klut_storage_node<Node> const& other ) const
   {
-    return data[1].h1 == other.data[1].h1 && children == other.children;
+    return this->data[1].h1 == other.data[1].h1 && this->children == other.children;
   }
 };
 
+using klut_storage_node = basic_klut_storage_node<mixed_fanin_node<2>>;
+
 /*! \brief k-LUT storage container
 
   ...
 */
 using klut_storage = storage<klut_storage_node, klut_storage_data>;
 
-class klut_network
+/*! \brief k-LUT storage container with inline fan-ins
+
+  Stores the same information as `klut_storage`, but up to 6 fan-ins are
+  kept inside the node as 32-bit pointers (see `small_fanin_vector`).  Only
+  nodes with more fan-ins allocate heap memory.  Networks are restricted to
+  2^32 nodes.
+*/
+using klut_inline_storage = storage<basic_klut_storage_node<inline_fanin_node<2, 6u>>, klut_storage_data>;
+
+/*! \brief k-LUT network parameterized by its storage container
+
+  `Storage` is either `klut_storage` (default) or `klut_inline_storage`.  Use
+  the type aliases `klut_network` and `inline_klut_network`.
+*/
+template<class Storage = klut_storage>
+class basic_klut_network
 {
 public:
 #pragma region Types and constructors
   static constexpr auto min_fanin_size = 1;
   static constexpr auto max_fanin_size = 32;
 
-  using base_type = klut_network;
-  using storage = std::shared_ptr<klut_storage>;
+  using base_type = basic_klut_network;
+  using storage = std::shared_ptr<Storage>;
   using node = uint64_t;
   using signal = uint64_t;
 
-  klut_network()
-      : _storage( std::make_shared<klut_storage>() ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+  basic_klut_network()
+      : _storage( std::make_shared<Storage>() ),
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
     _init();
   }
 
-  klut_network( std::shared_ptr<klut_storage> storage )
+  basic_klut_network( std::shared_ptr<Storage> storage )
       : _storage( storage ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
     _init();
   }
 
+  /*! \brief Reserves memory for a network with `num_nodes` nodes.
+   *
+   * Reserves the node array and the structural hash table, such that they
+   * are not reallocated while the network grows to `num_nodes` nodes.
+   */
+  void reserve( uint64_t num_nodes )
+  {
+    _storage->nodes.reserve( num_nodes );
+    _storage->hash.reserve( num_nodes );
+  }
+
 protected:
   inline void _init()
   {
@@ -114,52 +145,52 @@ protected:
 
     /* reserve some truth tables for nodes */
     kitty::dynamic_truth_table tt_zero( 0 );
-    _storage->data.cache.insert( tt_zero );
+    _storage->data.cache->insert( tt_zero );
 
     static uint64_t _not = 0x1;
     kitty::dynamic_truth_table tt_not( 1 );
     kitty::create_from_words( tt_not, &_not, &_not + 1 );
-    _storage->data.cache.insert( tt_not );
+    _storage->data.cache->insert( tt_not );
 
     static uint64_t _and = 0x8;
     kitty::dynamic_truth_table tt_and( 2 );
     kitty::create_from_words( tt_and, &_and, &_and + 1 );
-    _storage->data.cache.insert( tt_and );
+    _storage->data.cache->insert( tt_and );
 
     static uint64_t _or = 0xe;
     kitty::dynamic_truth_table tt_or( 2 );
     kitty::create_from_words( tt_or, &_or, &_or + 1 );
-    _storage->data.cache.insert( tt_or );
+    _storage->data.cache->insert( tt_or );
 
     static uint64_t _lt = 0x4;
     kitty::dynamic_truth_table tt_lt( 2 );
     kitty::create_from_words( tt_lt, &_lt, &_lt + 1 );
-    _storage->data.cache.insert( tt_lt );
+    _storage->data.cache->insert( tt_lt );
 
     static uint64_t _le = 0xd;
     kitty::dynamic_truth_table tt_le( 2 );
     kitty::create_from_words( tt_le, &_le, &_le + 1 );
-    _storage->data.cache.insert( tt_le );
+    _storage->data.cache->insert( tt_le );
 
     static uint64_t _xor = 0x6;
     kitty::dynamic_truth_table tt_xor( 2 );
     kitty::create_from_words( tt_xor, &_xor, &_xor + 1 );
-    _storage->data.cache.insert( tt_xor );
+    _storage->data.cache->insert( tt_xor );
 
     static uint64_t _maj = 0xe8;
     kitty::dynamic_truth_table tt_maj( 3 );
     kitty::create_from_words( tt_maj, &_maj, &_maj + 1 );
-    _storage->data.cache.insert( tt_maj );
+    _storage->data.cache->insert( tt_maj );
 
     static uint64_t _ite = 0xd8;
     kitty::dynamic_truth_table tt_ite( 3 );
     kitty::create_from_words( tt_ite, &_ite, &_ite + 1 );
-    _storage->data.cache.insert( tt_ite );
+    _storage->data.cache->insert( tt_ite );
 
     static uint64_t _xor3 = 0x96;
     kitty::dynamic_truth_table tt_xor3( 3 );
     kitty::create_from_words( tt_xor3, &_xor3, &_xor3 + 1 );
-    _storage->data.cache.insert( tt_xor3 );
+    _storage->data.cache->insert( tt_xor3 );
 
     /* truth tables for constants */
     _storage->nodes[0].data[1].h1 = 0;
@@ -343,7 +374,7 @@ signal create_maj( signal a, signal b, signal c )
 #pragma region Create arbitrary functions
   signal _create_node( std::vector<signal> const& children, uint32_t literal )
   {
-    storage::element_type::node_type node;
+    typename Storage::node_type node;
     std::copy( children.begin(), children.end(), std::back_inserter( node.children ) );
     node.data[1].h1 = literal;
 
@@ -380,13 +411,13 @@ signal create_maj( signal a, signal b, signal c )
       assert( function.num_vars() == 0u );
       return get_constant( !kitty::is_const0( function ) );
     }
-    return _create_node( children, _storage->data.cache.insert( function ) );
+    return _create_node( children, _storage->data.cache->insert( function ) );
   }
 
-  signal clone_node( klut_network const& other, node const& source, std::vector<signal> const& children )
+  signal clone_node( basic_klut_network const& other, node const& source, std::vector<signal> const& children )
   {
     assert( !children.empty() );
-    const auto tt = other._storage->data.cache[other._storage->nodes[source].data[1].h1];
+    const auto tt = ( *other._storage->data.cache )[other._storage->nodes[source].data[1].h1];
     return create_node( children, tt );
   }
 #pragma endregion
@@ -495,7 +526,18 @@ signal create_maj( signal a, signal b, signal c )
 #pragma region Functional properties
   kitty::dynamic_truth_table node_function( const node& n ) const
   {
-    return _storage->data.cache[_storage->nodes[n].data[1].h1];
+    return ( *_storage->data.cache )[_storage->nodes[n].data[1].h1];
+  }
+
+  /*! \brief Returns the cache that stores the node functions.
+   *
+   * The cache can be shared with other algorithms, e.g., with cut enumeration
+   * via `cut_enumeration_params::truth_tables`, such that functions computed
+   * there are already interned when creating nodes from them.
+   */
+  std::shared_ptr<truth_table_cache<kitty::dynamic_truth_table>> function_cache() const
+  {
+    return _storage->data.cache;
   }
 #pragma endregion
 
@@ -740,7 +782,7 @@ signal create_maj( signal a, signal b, signal c )
     if ( n == 0 || is_ci( n ) )
       return;
 
-    using IteratorType = decltype( _storage->outputs.begin() );
+    using IteratorType = decltype( _storage->nodes[n].children.begin() );
     detail::foreach_element_transform<IteratorType, uint32_t>( _storage->nodes[n].children.begin(), _storage->nodes[n].children.end(), []( auto f ) { return f.index; }, fn );
   }
 #pragma endregion
@@ -756,7 +798,7 @@ signal create_maj( signal a, signal b, signal c )
       index <<= 1;
       index ^= *begin++ ? 1 : 0;
     }
-    return kitty::get_bit( _storage->data.cache[_storage->nodes[n].data[1].h1], index );
+    return kitty::get_bit( ( *_storage->data.cache )[_storage->nodes[n].data[1].h1], index );
   }
 
   template<typename Iterator>
@@ -771,7 +813,7 @@ signal create_maj( signal a, signal b, signal c )
 
     /* resulting truth table has the same size as any of the children */
     auto result = tts.front().construct();
-    const auto gate_tt = _storage->data.cache[_storage->nodes[n].data[1].h1];
+    const auto gate_tt = ( *_storage->data.cache )[_storage->nodes[n].data[1].h1];
 
     for ( uint32_t i = 0u; i < static_cast<uint32_t>( result.num_bits() ); ++i )
     {
@@ -852,8 +894,11 @@ signal create_maj( signal a, signal b, signal c )
 #pragma endregion
 
 public:
-  std::shared_ptr<klut_storage> _storage;
+  std::shared_ptr<Storage> _storage;
   std::shared_ptr<network_events<base_type>> _events;
 };
 
+using klut_network = basic_klut_network<klut_storage>;
+using inline_klut_network = basic_klut_network<klut_inline_storage>;
+
 } // namespace mockturtle
@@ -35,9 +35,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <parallel_hashmap/phmap.h>
@@ -88,6 +94,54 @@ public:
   }
 };
 
+/*! \brief 32-bit node pointer
+ *
+ * Same layout as `node_pointer`, but the index and weight share a single
+ * 32-bit word.  Used by storage containers that pack fan-in literals.
+ */
+template<int PointerFieldSize = 0>
+struct compact_node_pointer
+{
+private:
+  static constexpr auto _len = sizeof( uint32_t ) * 8;
+
+public:
+  compact_node_pointer() = default;
+  compact_node_pointer( uint64_t index, uint64_t weight ) : weight( static_cast<uint32_t>( weight ) ), index( static_cast<uint32_t>( index ) ) {}
+
+  union {
+    struct
+    {
+      uint32_t weight : PointerFieldSize;
+      uint32_t index : _len - PointerFieldSize;
+    };
+    uint32_t data;
+  };
+
+  bool operator==( compact_node_pointer<PointerFieldSize> const& other ) const
+  {
+    return data == other.data;
+  }
+};
+
+template<>
+struct compact_node_pointer<0>
+{
+public:
+  compact_node_pointer<0>() = default;
+  compact_node_pointer<0>( uint64_t index ) : index( static_cast<uint32_t>( index ) ) {}
+
+  union {
+    uint32_t index;
+    uint32_t data;
+  };
+
+  bool operator==( compact_node_pointer<0> const& other ) const
+  {
+    return data == other.data;
+  }
+};
+
 union cauint64_t {
   uint64_t n{0};
   struct
@@ -132,6 +186,206 @@ struct mixed_fanin_node
   }
 };
 
+/*! \brief Fan-in container with inline storage
+ *
+ * Keeps up to `Capacity` fan-ins inside the node and only allocates heap
+ * memory for nodes with more fan-ins.  `T` must be trivially copyable.  The
+ * container implements the subset of the `std::vector` interface used by
+ * the network implementations.
+ */
+template<typename T, uint32_t Capacity>
+class small_fanin_vector
+{
+  static_assert( std::is_trivially_copyable_v<T>, "T must be trivially copyable" );
+  static_assert( Capacity > 0u, "inline capacity must be positive" );
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using iterator = T*;
+  using const_iterator = T const*;
+
+  small_fanin_vector() = default;
+
+  small_fanin_vector( std::initializer_list<T> init )
+  {
+    reserve( init.size() );
+    std::copy( init.begin(), init.end(), data() );
+    _size = static_cast<uint32_t>( init.size() );
+  }
+
+  small_fanin_vector( small_fanin_vector const& other )
+  {
+    reserve( other._size );
+    std::copy( other.begin(), other.end(), data() );
+    _size = other._size;
+  }
+
+  small_fanin_vector( small_fanin_vector&& other ) noexcept
+  {
+    steal( other );
+  }
+
+  small_fanin_vector& operator=( small_fanin_vector const& other )
+  {
+    if ( this != &other )
+    {
+      clear();
+      reserve( other._size );
+      std::copy( other.begin(), other.end(), data() );
+      _size = other._size;
+    }
+    return *this;
+  }
+
+  small_fanin_vector& operator=( small_fanin_vector&& other ) noexcept
+  {
+    if ( this != &other )
+    {
+      release();
+      steal( other );
+    }
+    return *this;
+  }
+
+  ~small_fanin_vector()
+  {
+    release();
+  }
+
+  size_type size() const { return _size; }
+  bool empty() const { return _size == 0u; }
+
+  T* data() { return is_inline() ? _inline : _heap; }
+  T const* data() const { return is_inline() ? _inline : _heap; }
+
+  iterator begin() { return data(); }
+  iterator end() { return data() + _size; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + _size; }
+
+  T& operator[]( size_type i ) { return data()[i]; }
+  T const& operator[]( size_type i ) const { return data()[i]; }
+
+  void reserve( size_type capacity )
+  {
+    if ( capacity <= _capacity )
+    {
+      return;
+    }
+
+    auto* heap = new T[capacity];
+    std::copy( begin(), end(), heap );
+    release();
+    _heap = heap;
+    _capacity = static_cast<uint32_t>( capacity );
+  }
+
+  void push_back( T const& value )
+  {
+    if ( _size == _capacity )
+    {
+      reserve( 2u * _capacity );
+    }
+    data()[_size++] = value;
+  }
+
+  template<typename... Args>
+  T& emplace_back( Args&&... args )
+  {
+    push_back( T( std::forward<Args>( args )... ) );
+    return data()[_size - 1u];
+  }
+
+  void clear()
+  {
+    _size = 0u;
+  }
+
+  bool operator==( small_fanin_vector const& other ) const
+  {
+    return std::equal( begin(), end(), other.begin(), other.end() );
+  }
+
+private:
+  bool is_inline() const
+  {
+    return _capacity == Capacity;
+  }
+
+  void release()
+  {
+    if ( !is_inline() )
+    {
+      delete[] _heap;
+      _capacity = Capacity;
+    }
+  }
+
+  void steal( small_fanin_vector& other )
+  {
+    if ( other.is_inline() )
+    {
+      std::copy( other.begin(), other.end(), _inline );
+    }
+    else
+    {
+      _heap = other._heap;
+      _capacity = other._capacity;
+      other._capacity = Capacity;
+    }
+    _size = other._size;
+    other._size = 0u;
+  }
+
+private:
+  uint32_t _size{0u};
+  uint32_t _capacity{Capacity};
+  union
+  {
+    T _inline[Capacity];
+    T* _heap;
+  };
+};
+
+/*! \brief Node with a variable number of fan-ins stored inline
+ *
+ * Same as `mixed_fanin_node`, but up to `Capacity` fan-ins are stored in the
+ * node as 32-bit pointers (see `small_fanin_vector`).
+ */
+template<int Size = 0, uint32_t Capacity = 6u, int PointerFieldSize = 0>
+struct inline_fanin_node
+{
+  using pointer_type = compact_node_pointer<PointerFieldSize>;
+
+  small_fanin_vector<pointer_type, Capacity> children;
+  std::array<cauint64_t, Size> data;
+
+  bool operator==( inline_fanin_node<Size, Capacity, PointerFieldSize> const& other ) const
+  {
+    return children == other.children;
+  }
+};
+
+/*! \brief Node with fan-ins only
+ *
+ * Node type for storage containers that keep the per-node data outside of
+ * the node (see `soa_storage`).  It also serves as key in the structural
+ * hash table.
+ */
+template<int Fanin, int PointerFieldSize = 0>
+struct compact_node
+{
+  using pointer_type = compact_node_pointer<PointerFieldSize>;
+
+  std::array<pointer_type, Fanin> children;
+
+  bool operator==( compact_node<Fanin, PointerFieldSize> const& other ) const
+  {
+    return children == other.children;
+  }
+};
+
 /*! \brief Hash function for 64-bit word */
 inline uint64_t hash_block( uint64_t word )
 {
@@ -213,4 +467,178 @@ struct storage
   T data;
 };
 
+/*! \brief Reference to a data word of a node in a `soa_node_container`
+ *
+ * Mimics the `h1` and `h2` halves of a `cauint64_t`.
+ */
+struct soa_data_reference
+{
+  uint32_t& h1;
+  uint32_t& h2;
+};
+
+/*! \brief Structure-of-arrays node container
+ *
+ * Stores the fan-ins of all nodes in one packed array and each 32-bit half of
+ * the node data in a separate array.  `NumWords` is the number of data halves
+ * that are backed by an array: `data[i].h1` refers to `words[2 * i]` and
+ * `data[i].h2` to `words[2 * i + 1]`.  Halves beyond `NumWords` are not
+ * stored per node; they refer to a single scratch word.
+ *
+ * The container implements the subset of the `std::vector` interface used
+ * by the network implementations.  Element access returns a proxy, hence
+ * `operator[]` and `emplace_back` must be bound to `auto&&` instead of
+ * `auto&`.
+ */
+template<typename Node, int NumWords>
+struct soa_node_container
+{
+  using node_type = Node;
+  using children_type = decltype( Node::children );
+
+  struct data_accessor
+  {
+    soa_data_reference operator[]( uint32_t i ) const
+    {
+      assert( 2 * i < NumWords );
+      return {container->words[2 * i][index], 2 * i + 1 < NumWords ? container->words[2 * i + 1][index] : container->scratch};
+    }
+
+    soa_node_container* container;
+    uint64_t index;
+  };
+
+  struct reference
+  {
+    operator node_type() const
+    {
+      return node_type{children};
+    }
+
+    children_type& children;
+    data_accessor data;
+  };
+
+  struct iterator
+  {
+    using iterator_category = std::input_iterator_tag;
+    using value_type = node_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = typename soa_node_container::reference;
+
+    reference operator*() const
+    {
+      return ( *container )[index];
+    }
+
+    iterator& operator++()
+    {
+      ++index;
+      return *this;
+    }
+
+    bool operator==( iterator const& other ) const
+    {
+      return index == other.index;
+    }
+
+    bool operator!=( iterator const& other ) const
+    {
+      return index != other.index;
+    }
+
+    soa_node_container* container;
+    uint64_t index;
+  };
+
+  reference operator[]( uint64_t index )
+  {
+    return {fanins[index].children, {this, index}};
+  }
+
+  reference emplace_back()
+  {
+    fanins.emplace_back();
+    for ( auto& w : words )
+    {
+      w.emplace_back( 0u );
+    }
+    return ( *this )[fanins.size() - 1];
+  }
+
+  void push_back( node_type const& n )
+  {
+    fanins.push_back( n );
+    for ( auto& w : words )
+    {
+      w.emplace_back( 0u );
+    }
+  }
+
+  uint64_t size() const
+  {
+    return fanins.size();
+  }
+
+  uint64_t capacity() const
+  {
+    return fanins.capacity();
+  }
+
+  void reserve( uint64_t n )
+  {
+    fanins.reserve( n );
+    for ( auto& w : words )
+    {
+      w.reserve( n );
+    }
+  }
+
+  iterator begin()
+  {
+    return {this, 0u};
+  }
+
+  iterator end()
+  {
+    return {this, fanins.size()};
+  }
+
+  std::vector<node_type> fanins;
+  std::array<std::vector<uint32_t>, NumWords> words;
+  uint32_t scratch{0};
+};
+
+/*! \brief Structure-of-arrays storage container
+ *
+ * Drop-in replacement for `storage` for networks with fixed fan-in size.
+ * Nodes are of type `compact_node`, i.e., fan-ins are 32-bit literals, and
+ * the node data is split into separate arrays (see `soa_node_container`).
+ * The structural hash table maps to 32-bit indexes.
+ */
+template<typename Node, typename T = empty_storage_data, typename NodeHasher = node_hash<Node>, int NumWords = 3>
+struct soa_storage
+{
+  soa_storage()
+  {
+    nodes.reserve( 10000u );
+    hash.reserve( 10000u );
+
+    /* we generally reserve the first node for a constant */
+    nodes.emplace_back();
+  }
+
+  using node_type = Node;
+
+  soa_node_container<Node, NumWords> nodes;
+  std::vector<uint64_t> inputs;
+  std::vector<typename node_type::pointer_type> outputs;
+  std::unordered_map<uint64_t, latch_info> latch_information;
+
+  phmap::flat_hash_map<node_type, uint32_t, NodeHasher> hash;
+
+  T data;
+};
+
 } /* namespace mockturtle */
\ No newline at end of file
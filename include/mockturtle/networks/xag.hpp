@@ -48,6 +48,8 @@
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
+#include "detail/compact_storage.hpp"
+#include "detail/fanout_lists.hpp"
 #include "detail/foreach.hpp"
 #include "events.hpp"
 #include "storage.hpp"
@@ -76,6 +78,8 @@ struct xag_storage_data
   uint32_t num_pos = 0u;
   std::vector<int8_t> latches;
   uint32_t trav_id = 0;
+  bool track_fanouts = false;
+  detail::fanout_lists<uint32_t> fanouts;
 };
 
 /*! \brief XAG storage container
@@ -92,15 +96,34 @@ using xag_storage = storage<regular_node<2, 2, 1>,
                             xag_storage_data,
                             xag_hash<regular_node<2, 2, 1>>>;
 
-class xag_network
+/*! \brief XAG storage container with structure-of-arrays layout
+
+  Stores the same information as `xag_storage`, but fan-ins are packed
+  32-bit literals and fan-out size, application-specific value, and visited
+  flag are kept in three separate arrays (see `soa_storage`).  The structural
+  hash table maps to 32-bit indexes.  This reduces memory by about a half and
+  keeps traversals over fan-ins from touching the remaining node data.
+  Networks are restricted to 2^31 nodes.
+*/
+using xag_soa_storage = soa_storage<compact_node<2, 1>,
+                                xag_storage_data,
+                                xag_hash<compact_node<2, 1>>>;
+
+/*! \brief XAG network parameterized by its storage container
+
+  `Storage` is either `xag_storage` (default) or `xag_soa_storage`.  Use the
+  type aliases `xag_network` and `soa_xag_network`.
+*/
+template<class Storage = xag_storage>
+class basic_xag_network
 {
 public:
 #pragma region Types and constructors
   static constexpr auto min_fanin_size = 2u;
   static constexpr auto max_fanin_size = 2u;
 
-  using base_type = xag_network;
-  using storage = std::shared_ptr<xag_storage>;
+  using base_type = basic_xag_network;
+  using storage = std::shared_ptr<Storage>;
   using node = uint64_t;
 
   struct signal
@@ -117,7 +140,7 @@ public:
     {
     }
 
-    signal( xag_storage::node_type::pointer_type const& p )
+    signal( typename Storage::node_type::pointer_type const& p )
         : complement( p.weight ), index( p.index )
     {
     }
@@ -166,29 +189,41 @@ public:
       return data < other.data;
     }
 
-    operator xag_storage::node_type::pointer_type() const
+    operator typename Storage::node_type::pointer_type() const
     {
       return {index, complement};
     }
 
 #if __cplusplus > 201703L
-    bool operator==( xag_storage::node_type::pointer_type const& other ) const
+    bool operator==( typename Storage::node_type::pointer_type const& other ) const
     {
       return data == other.data;
     }
 #endif
   };
 
-  xag_network()
-      : _storage( std::make_shared<xag_storage>() ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+  basic_xag_network()
+      : _storage( std::make_shared<Storage>() ),
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
 
-  xag_network( std::shared_ptr<xag_storage> storage )
+  basic_xag_network( std::shared_ptr<Storage> storage )
       : _storage( storage ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
+  {
+  }
+
+  /*! \brief Reserves memory for a network with `num_nodes` nodes.
+   *
+   * Reserves the node array and the structural hash table, such that they
+   * are not reallocated while the network grows to `num_nodes` nodes.
+   */
+  void reserve( uint64_t num_nodes )
   {
+    /* node creation grows the arrays once 90% of the capacity is used */
+    _storage->nodes.reserve( static_cast<uint64_t>( num_nodes / .9 ) + 1u );
+    _storage->hash.reserve( num_nodes );
   }
 #pragma endregion
 
@@ -203,7 +238,7 @@ public:
     (void)name;
 
     const auto index = _storage->nodes.size();
-    auto& node = _storage->nodes.emplace_back();
+    auto&& node = _storage->nodes.emplace_back();
     node.children[0].data = node.children[1].data = _storage->inputs.size();
     _storage->inputs.emplace_back( index );
     ++_storage->data.num_pis;
@@ -227,7 +262,7 @@ public:
     (void)name;
 
     auto const index = _storage->nodes.size();
-    auto& node = _storage->nodes.emplace_back();
+    auto&& node = _storage->nodes.emplace_back();
     node.children[0].data = node.children[1].data = _storage->inputs.size();
     _storage->inputs.emplace_back( index );
     return {index, 0};
@@ -299,7 +334,7 @@ public:
 #pragma region Create binary functions
   signal _create_node( signal a, signal b )
   {
-    storage::element_type::node_type node;
+    typename Storage::node_type node;
     node.children[0] = a;
     node.children[1] = b;
 
@@ -326,6 +361,12 @@ public:
     _storage->nodes[a.index].data[0].h1++;
     _storage->nodes[b.index].data[0].h1++;
 
+    if ( _storage->data.track_fanouts )
+    {
+      _storage->data.fanouts.push_back( static_cast<uint32_t>( a.index ), static_cast<uint32_t>( index ) );
+      _storage->data.fanouts.push_back( static_cast<uint32_t>( b.index ), static_cast<uint32_t>( index ) );
+    }
+
     for ( auto const& fn : _events->on_add )
     {
       (*fn)( index );
@@ -457,7 +498,7 @@ public:
 #pragma endregion
 
 #pragma region Create arbitrary functions
-  signal clone_node( xag_network const& other, node const& source, std::vector<signal> const& children )
+  signal clone_node( basic_xag_network const& other, node const& source, std::vector<signal> const& children )
   {
     assert( children.size() == 2u );
     if ( other.is_and( source ) )
@@ -474,7 +515,7 @@ public:
 #pragma region Restructuring
   std::optional<std::pair<node, signal>> replace_in_node( node const& n, node const& old_node, signal new_signal )
   {
-    auto& node = _storage->nodes[n];
+    auto&& node = _storage->nodes[n];
 
     uint32_t fanin = 0u;
     if ( node.children[0].index == old_node )
@@ -530,7 +571,7 @@ public:
     }
 
     // node already in hash table
-    storage::element_type::node_type _hash_obj;
+    typename Storage::node_type _hash_obj;
     _hash_obj.children[0] = child0;
     _hash_obj.children[1] = child1;
     if ( const auto it = _storage->hash.find( _hash_obj ); it != _storage->hash.end() )
@@ -553,6 +594,12 @@ public:
     // update the reference counter of the new signal
     _storage->nodes[new_signal.index].data[0].h1++;
 
+    if ( _storage->data.track_fanouts )
+    {
+      _storage->data.fanouts.erase( static_cast<uint32_t>( old_node ), static_cast<uint32_t>( n ) );
+      _storage->data.fanouts.push_back( static_cast<uint32_t>( new_signal.index ), static_cast<uint32_t>( n ) );
+    }
+
     for ( auto const& fn : _events->on_modified )
     {
       (*fn)( n, {old_child0, old_child1} );
@@ -582,10 +629,19 @@ public:
     if ( n == 0 || is_ci( n ) )
       return;
 
-    auto& nobj = _storage->nodes[n];
+    auto&& nobj = _storage->nodes[n];
     nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
     _storage->hash.erase( nobj );
 
+    if ( _storage->data.track_fanouts )
+    {
+      for ( auto const& child : nobj.children )
+      {
+        _storage->data.fanouts.erase( static_cast<uint32_t>( child.index ), static_cast<uint32_t>( n ) );
+      }
+      _storage->data.fanouts.clear( static_cast<uint32_t>( n ) );
+    }
+
     for ( auto const& fn : _events->on_delete )
     {
       (*fn)( n );
@@ -619,16 +675,15 @@ public:
       const auto [_old, _new] = to_substitute.top();
       to_substitute.pop();
 
-      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-      {
+      foreach_substitution_candidate( _old, [&]( node const& idx ) {
         if ( is_ci( idx ) )
-          continue; /* ignore CIs */
+          return; /* ignore CIs */
 
         if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
         {
           to_substitute.push( *repl );
         }
-      }
+      } );
 
       /* check outputs */
       replace_in_outputs( _old, _new );
@@ -637,6 +692,79 @@ public:
       take_out_node( _old );
     }
   }
+
+  /*! \brief Removes dead nodes and renumbers the remaining ones.
+   *
+   * The constant comes first, followed by the CIs and then by the gates in
+   * topological order.  Returns the new index of each old node, which can
+   * be used to migrate node-indexed containers; dead nodes are mapped to
+   * `std::numeric_limits<node>::max()`.  Views on the network must be
+   * recomputed afterwards.
+   */
+  std::vector<node> compact()
+  {
+    /* XOR gates have their fan-ins in descending order */
+    auto old_to_new = detail::compact_storage( *_storage, []( auto const& children ) {
+      return children[0].index > children[1].index;
+    } );
+    if ( _storage->data.track_fanouts )
+    {
+      enable_fanout_tracking();
+    }
+    return old_to_new;
+  }
+
+  /*! \brief Maintains the fanouts of each node in the storage.
+   *
+   * With fanout tracking, substituting a node only visits the gates that
+   * refer to it instead of all nodes in the network.  The fanouts live in
+   * the storage and are thus shared by all shallow copies of the network.
+   */
+  void enable_fanout_tracking()
+  {
+    auto& data = _storage->data;
+    data.fanouts.build( static_cast<uint32_t>( _storage->nodes.size() ), [&]( auto&& add_fanout ) {
+      foreach_gate( [&]( auto const& n ) {
+        foreach_fanin( n, [&]( auto const& f ) {
+          add_fanout( static_cast<uint32_t>( get_node( f ) ), static_cast<uint32_t>( n ) );
+        } );
+      } );
+    } );
+    data.track_fanouts = true;
+  }
+
+  void disable_fanout_tracking()
+  {
+    _storage->data.track_fanouts = false;
+    _storage->data.fanouts = {};
+  }
+
+  bool has_fanout_tracking() const
+  {
+    return _storage->data.track_fanouts;
+  }
+
+  /* calls `fn` on all nodes that may have `n` as fanin, in index order */
+  template<typename Fn>
+  void foreach_substitution_candidate( node const& n, Fn&& fn ) const
+  {
+    if ( _storage->data.track_fanouts )
+    {
+      auto parents = _storage->data.fanouts.to_vector( static_cast<uint32_t>( n ) );
+      std::sort( parents.begin(), parents.end() );
+      for ( auto const& p : parents )
+      {
+        fn( p );
+      }
+    }
+    else
+    {
+      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
+      {
+        fn( idx );
+      }
+    }
+  }
 #pragma endregion
 
 #pragma region Structural properties
@@ -1133,7 +1261,7 @@ public:
 #pragma region Custom node values
   void clear_values() const
   {
-    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[0].h2 = 0; } );
+    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto&& n ) { n.data[0].h2 = 0; } );
   }
 
   auto value( node const& n ) const
@@ -1160,7 +1288,7 @@ public:
 #pragma region Visited flags
   void clear_visited() const
   {
-    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[1].h1 = 0; } );
+    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto&& n ) { n.data[1].h1 = 0; } );
   }
 
   auto visited( node const& n ) const
@@ -1192,10 +1320,13 @@ public:
 #pragma endregion
 
 public:
-  std::shared_ptr<xag_storage> _storage;
+  std::shared_ptr<Storage> _storage;
   std::shared_ptr<network_events<base_type>> _events;
 };
 
+using xag_network = basic_xag_network<xag_storage>;
+using soa_xag_network = basic_xag_network<xag_soa_storage>;
+
 } // namespace mockturtle
 
 namespace std
@@ -1216,4 +1347,19 @@ struct hash<mockturtle::xag_network::signal>
   }
 }; /* hash */
 
+template<>
+struct hash<mockturtle::soa_xag_network::signal>
+{
+  uint64_t operator()( mockturtle::soa_xag_network::signal const& s ) const noexcept
+  {
+    uint64_t k = s.data;
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccd;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53;
+    k ^= k >> 33;
+    return k;
+  }
+}; /* hash */
+
 } // namespace std
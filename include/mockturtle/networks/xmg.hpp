@@ -47,6 +47,8 @@
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
+#include "detail/compact_storage.hpp"
+#include "detail/fanout_lists.hpp"
 #include "detail/foreach.hpp"
 #include "events.hpp"
 #include "storage.hpp"
@@ -60,6 +62,8 @@ struct xmg_storage_data
   uint32_t num_pos = 0u;
   std::vector<int8_t> latches;
   uint32_t trav_id = 0u;
+  bool track_fanouts = false;
+  detail::fanout_lists<uint32_t> fanouts;
 };
 
 /*! \brief XMG storage container
@@ -174,6 +178,18 @@ public:
         _events( std::make_shared<decltype( _events )::element_type>() )
   {
   }
+
+  /*! \brief Reserves memory for a network with `num_nodes` nodes.
+   *
+   * Reserves the node array and the structural hash table, such that they
+   * are not reallocated while the network grows to `num_nodes` nodes.
+   */
+  void reserve( uint64_t num_nodes )
+  {
+    /* node creation grows the arrays once 90% of the capacity is used */
+    _storage->nodes.reserve( static_cast<uint64_t>( num_nodes / .9 ) + 1u );
+    _storage->hash.reserve( num_nodes );
+  }
 #pragma endregion
 
 #pragma region Primary I / O and constants
@@ -350,6 +366,13 @@ public:
     _storage->nodes[b.index].data[0].h1++;
     _storage->nodes[c.index].data[0].h1++;
 
+    if ( _storage->data.track_fanouts )
+    {
+      _storage->data.fanouts.push_back( static_cast<uint32_t>( a.index ), static_cast<uint32_t>( index ) );
+      _storage->data.fanouts.push_back( static_cast<uint32_t>( b.index ), static_cast<uint32_t>( index ) );
+      _storage->data.fanouts.push_back( static_cast<uint32_t>( c.index ), static_cast<uint32_t>( index ) );
+    }
+
     for ( auto const& fn : _events->on_add )
     {
       (*fn)( index );
@@ -417,6 +440,13 @@ public:
     _storage->nodes[b.index].data[0].h1++;
     _storage->nodes[c.index].data[0].h1++;
 
+    if ( _storage->data.track_fanouts )
+    {
+      _storage->data.fanouts.push_back( static_cast<uint32_t>( a.index ), static_cast<uint32_t>( index ) );
+      _storage->data.fanouts.push_back( static_cast<uint32_t>( b.index ), static_cast<uint32_t>( index ) );
+      _storage->data.fanouts.push_back( static_cast<uint32_t>( c.index ), static_cast<uint32_t>( index ) );
+    }
+
     for ( auto const& fn : _events->on_add )
     {
       (*fn)( index );
@@ -656,6 +686,12 @@ public:
     // update the reference counter of the new signal
     _storage->nodes[new_signal.index].data[0].h1++;
 
+    if ( _storage->data.track_fanouts )
+    {
+      _storage->data.fanouts.erase( static_cast<uint32_t>( old_node ), static_cast<uint32_t>( n ) );
+      _storage->data.fanouts.push_back( static_cast<uint32_t>( new_signal.index ), static_cast<uint32_t>( n ) );
+    }
+
     for ( auto const& fn : _events->on_modified )
     {
       (*fn)( n, {old_child0, old_child1, old_child2} );
@@ -689,6 +725,15 @@ public:
     nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
     _storage->hash.erase( nobj );
 
+    if ( _storage->data.track_fanouts )
+    {
+      for ( auto const& child : nobj.children )
+      {
+        _storage->data.fanouts.erase( static_cast<uint32_t>( child.index ), static_cast<uint32_t>( n ) );
+      }
+      _storage->data.fanouts.clear( static_cast<uint32_t>( n ) );
+    }
+
     for ( auto const& fn : _events->on_delete )
     {
       (*fn)( n );
@@ -722,16 +767,15 @@ public:
       const auto [_old, _new] = to_substitute.top();
       to_substitute.pop();
 
-      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-      {
+      foreach_substitution_candidate( _old, [&]( node const& idx ) {
         if ( is_ci( idx ) )
-          continue; /* ignore CIs */
+          return; /* ignore CIs */
 
         if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
         {
           to_substitute.push( *repl );
         }
-      }
+      } );
 
       /* check outputs */
       replace_in_outputs( _old, _new );
@@ -740,6 +784,79 @@ public:
       take_out_node( _old );
     }
   }
+
+  /*! \brief Removes dead nodes and renumbers the remaining ones.
+   *
+   * The constant comes first, followed by the CIs and then by the gates in
+   * topological order.  Returns the new index of each old node, which can
+   * be used to migrate node-indexed containers; dead nodes are mapped to
+   * `std::numeric_limits<node>::max()`.  Views on the network must be
+   * recomputed afterwards.
+   */
+  std::vector<node> compact()
+  {
+    /* XOR3 gates have their fan-ins in descending order */
+    auto old_to_new = detail::compact_storage( *_storage, []( auto const& children ) {
+      return children[0].index > children[1].index;
+    } );
+    if ( _storage->data.track_fanouts )
+    {
+      enable_fanout_tracking();
+    }
+    return old_to_new;
+  }
+
+  /*! \brief Maintains the fanouts of each node in the storage.
+   *
+   * With fanout tracking, substituting a node only visits the gates that
+   * refer to it instead of all nodes in the network.  The fanouts live in
+   * the storage and are thus shared by all shallow copies of the network.
+   */
+  void enable_fanout_tracking()
+  {
+    auto& data = _storage->data;
+    data.fanouts.build( static_cast<uint32_t>( _storage->nodes.size() ), [&]( auto&& add_fanout ) {
+      foreach_gate( [&]( auto const& n ) {
+        foreach_fanin( n, [&]( auto const& f ) {
+          add_fanout( static_cast<uint32_t>( get_node( f ) ), static_cast<uint32_t>( n ) );
+        } );
+      } );
+    } );
+    data.track_fanouts = true;
+  }
+
+  void disable_fanout_tracking()
+  {
+    _storage->data.track_fanouts = false;
+    _storage->data.fanouts = {};
+  }
+
+  bool has_fanout_tracking() const
+  {
+    return _storage->data.track_fanouts;
+  }
+
+  /* calls `fn` on all nodes that may have `n` as fanin, in index order */
+  template<typename Fn>
+  void foreach_substitution_candidate( node const& n, Fn&& fn ) const
+  {
+    if ( _storage->data.track_fanouts )
+    {
+      auto parents = _storage->data.fanouts.to_vector( static_cast<uint32_t>( n ) );
+      std::sort( parents.begin(), parents.end() );
+      for ( auto const& p : parents )
+      {
+        fn( p );
+      }
+    }
+    else
+    {
+      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
+      {
+        fn( idx );
+      }
+    }
+  }
 #pragma endregion
 
 #pragma region Structural properties
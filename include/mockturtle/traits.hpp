@@ -559,6 +559,21 @@ template<class Ntk>
 inline constexpr bool has_clone_node_v = has_clone_node<Ntk>::value;
 #pragma endregion
 
+#pragma region has_reserve
+template<class Ntk, class = void>
+struct has_reserve : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_reserve<Ntk, std::void_t<decltype( std::declval<Ntk>().reserve( uint64_t() ) )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_reserve_v = has_reserve<Ntk>::value;
+#pragma endregion
+
 #pragma region has_substitute_node
 template<class Ntk, class = void>
 struct has_substitute_node : std::false_type
@@ -641,7 +656,7 @@ struct has_is_dead : std::false_type
 };
 
 template<class Ntk>
-struct has_is_dead<Ntk, std::void_t<decltype( std::declval<Ntk>().is_dead( std::declval<signal<Ntk>>() ) )>> : std::true_type
+struct has_is_dead<Ntk, std::void_t<decltype( std::declval<Ntk>().is_dead( std::declval<node<Ntk>>() ) )>> : std::true_type
 {
 };
 
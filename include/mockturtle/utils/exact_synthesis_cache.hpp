@@ -0,0 +1,396 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file exact_synthesis_cache.hpp
+  \brief Persistent cache for exact synthesis results
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+
+#include "include/percy.hpp"
+#include "mapped_file.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Persistent cache for exact synthesis results.
+ *
+ * Stores optimum Boolean chains (`percy::chain`) of NPN representatives in a
+ * binary file.  Each entry belongs to a *domain*, a string that identifies
+ * the kind of synthesis (e.g., the gate basis), and holds one or more chains
+ * of the representative.  The resynthesis functions in `exact.hpp` use the
+ * cache through `exact_resynthesis_params::disk_cache`.
+ *
+ * The file is a sequence of self-contained records, which are only ever
+ * appended.  When the cache is opened (or `reload` is called), the file is
+ * memory-mapped read-only and indexed; chains are decoded on lookup.  New
+ * entries are appended to the file with a single write and are immediately
+ * visible to this object, but only to other objects (or processes) after
+ * they reload.  Several processes can therefore share one file.  Lookups and
+ * insertions are thread-safe.
+ *
+ * Each record consists of six 32-bit words (magic number, size in bytes,
+ * hash of the domain, checksum of the payload, number of variables | number
+ * of chains << 8 | format version << 16, and zero), followed by the truth
+ * table of the representative in 64-bit words and, for each chain, the
+ * number of inputs, the fan-in, the number of steps, the output literal,
+ * and for each step its fan-ins and its operator as a 64-bit word.  Records
+ * are padded to a multiple of 8 bytes and use the native byte order.  A
+ * record with a wrong magic number, size, or checksum (e.g., a truncated
+ * record after a crash during a write) is skipped up to the next magic
+ * number, hence records appended after it are still found.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      exact_resynthesis_params ps;
+      ps.disk_cache = std::make_shared<exact_synthesis_cache>( "exact.cache" );
+      exact_aig_resynthesis<aig_network> resyn( false, ps );
+      aig = cut_rewriting( aig, resyn );
+   \endverbatim
+ */
+class exact_synthesis_cache
+{
+public:
+  static constexpr uint32_t magic = 0x4345544du; /* "MTEC" */
+  static constexpr uint32_t version = 1u;
+
+  /*! \brief Opens (or prepares to create) a cache file. */
+  explicit exact_synthesis_cache( std::string const& filename )
+      : _filename( filename )
+  {
+    reload();
+  }
+
+  /*! \brief Returns the chains stored for an NPN representative. */
+  std::optional<std::vector<percy::chain>> find( std::string const& domain, kitty::dynamic_truth_table const& repr ) const
+  {
+    auto const key = make_key( hash_domain( domain ), repr );
+
+    std::shared_lock lock( _mutex );
+    if ( auto const it = _added.find( key ); it != _added.end() )
+    {
+      return it->second;
+    }
+    if ( auto const it = _index.find( key ); it != _index.end() )
+    {
+      return decode( it->second );
+    }
+    return std::nullopt;
+  }
+
+  /*! \brief Stores chains for an NPN representative and appends them to the file.
+   *
+   * Returns false if the record could not be written to the file (the entry
+   * is still available in this object).
+   */
+  bool insert( std::string const& domain, kitty::dynamic_truth_table const& repr, std::vector<percy::chain> const& chains )
+  {
+    auto const domain_hash = hash_domain( domain );
+    auto const key = make_key( domain_hash, repr );
+    auto const record = encode( domain_hash, repr, chains );
+
+    std::unique_lock lock( _mutex );
+    if ( _added.find( key ) != _added.end() || _index.find( key ) != _index.end() )
+    {
+      return true;
+    }
+    _added.emplace( key, chains );
+    return detail::append_to_file( _filename, reinterpret_cast<char const*>( record.data() ), record.size() * sizeof( uint32_t ) );
+  }
+
+  /*! \brief Maps the file again to include entries appended by others. */
+  void reload()
+  {
+    std::unique_lock lock( _mutex );
+
+    _index.clear();
+    _file = std::make_unique<detail::mapped_file>( _filename );
+    if ( !_file->is_open() )
+    {
+      return;
+    }
+
+    char magic_bytes[sizeof( uint32_t )];
+    std::memcpy( magic_bytes, &magic, sizeof( uint32_t ) );
+
+    auto it = _file->begin();
+    while ( _file->end() - it >= static_cast<std::ptrdiff_t>( header_size ) )
+    {
+      uint32_t header[header_words];
+      std::memcpy( header, it, header_size );
+      if ( header[0] != magic || header[1] < header_size || header[1] % 8u != 0u || header[1] > static_cast<std::size_t>( _file->end() - it ) ||
+           checksum( it + header_size, header[1] - header_size ) != header[3] )
+      {
+        /* truncated or corrupted record: records appended after it start at a later magic number */
+        it = std::search( it + 1, _file->end(), magic_bytes, magic_bytes + sizeof( uint32_t ) );
+        continue;
+      }
+
+      auto const num_vars = header[4] & 0xffu;
+      if ( ( header[4] >> 16u ) == version && num_vars <= max_num_vars )
+      {
+        kitty::dynamic_truth_table repr( num_vars );
+        std::memcpy( repr._bits.data(), it + header_size, repr.num_blocks() * sizeof( uint64_t ) );
+        _index.emplace( make_key( header[2], repr ), it );
+      }
+      it += header[1];
+    }
+  }
+
+  /*! \brief Number of entries. */
+  uint64_t size() const
+  {
+    std::shared_lock lock( _mutex );
+    return _index.size() + _added.size();
+  }
+
+  /*! \brief Name of the cache file. */
+  std::string const& filename() const
+  {
+    return _filename;
+  }
+
+private:
+  static constexpr uint32_t header_words = 6u;
+  static constexpr uint32_t header_size = header_words * sizeof( uint32_t );
+  static constexpr uint32_t max_num_vars = 16u;
+
+  /* FNV-1a */
+  static uint32_t hash_bytes( char const* data, std::size_t size )
+  {
+    uint32_t h = 2166136261u;
+    for ( auto i = 0u; i < size; ++i )
+    {
+      h ^= static_cast<uint8_t>( data[i] );
+      h *= 16777619u;
+    }
+    return h;
+  }
+
+  static uint32_t hash_domain( std::string const& domain )
+  {
+    return hash_bytes( domain.data(), domain.size() );
+  }
+
+  static uint32_t checksum( char const* data, std::size_t size )
+  {
+    return hash_bytes( data, size );
+  }
+
+  static std::string make_key( uint32_t domain_hash, kitty::dynamic_truth_table const& tt )
+  {
+    std::string key( sizeof( uint32_t ) + 1u + tt.num_blocks() * sizeof( uint64_t ), '\0' );
+    std::memcpy( &key[0], &domain_hash, sizeof( uint32_t ) );
+    key[sizeof( uint32_t )] = static_cast<char>( tt.num_vars() );
+    std::memcpy( &key[sizeof( uint32_t ) + 1u], tt._bits.data(), tt.num_blocks() * sizeof( uint64_t ) );
+    return key;
+  }
+
+  static void push_word( std::vector<uint32_t>& words, uint64_t word )
+  {
+    words.push_back( static_cast<uint32_t>( word ) );
+    words.push_back( static_cast<uint32_t>( word >> 32u ) );
+  }
+
+  static std::vector<uint32_t> encode( uint32_t domain_hash, kitty::dynamic_truth_table const& repr, std::vector<percy::chain> const& chains )
+  {
+    std::vector<uint32_t> words( header_words, 0u );
+    for ( auto const& block : repr )
+    {
+      push_word( words, block );
+    }
+
+    for ( auto const& c : chains )
+    {
+      assert( c.get_fanin() <= 6 && c.get_nr_outputs() == 1 );
+      words.push_back( static_cast<uint32_t>( c.get_nr_inputs() ) );
+      words.push_back( static_cast<uint32_t>( c.get_fanin() ) );
+      words.push_back( static_cast<uint32_t>( c.get_nr_steps() ) );
+      words.push_back( static_cast<uint32_t>( c.get_outputs()[0] ) );
+      for ( auto i = 0; i < c.get_nr_steps(); ++i )
+      {
+        for ( auto const& fanin : c.get_step( i ) )
+        {
+          words.push_back( static_cast<uint32_t>( fanin ) );
+        }
+        push_word( words, c.get_operator( i )._bits[0] );
+      }
+    }
+    if ( words.size() % 2u != 0u )
+    {
+      words.push_back( 0u );
+    }
+
+    auto const size = static_cast<uint32_t>( words.size() * sizeof( uint32_t ) );
+    words[0] = magic;
+    words[1] = size;
+    words[2] = domain_hash;
+    words[3] = checksum( reinterpret_cast<char const*>( words.data() + header_words ), size - header_size );
+    words[4] = repr.num_vars() | ( static_cast<uint32_t>( chains.size() ) << 8u ) | ( version << 16u );
+    return words;
+  }
+
+  static std::vector<percy::chain> decode( char const* record )
+  {
+    uint32_t header[header_words];
+    std::memcpy( header, record, header_size );
+    auto const num_vars = header[4] & 0xffu;
+    auto const num_chains = ( header[4] >> 8u ) & 0xffu;
+
+    auto const* it = record + header_size + ( num_vars <= 6u ? 1u : 1u << ( num_vars - 6u ) ) * sizeof( uint64_t );
+    auto const read = [&]() {
+      uint32_t word;
+      std::memcpy( &word, it, sizeof( uint32_t ) );
+      it += sizeof( uint32_t );
+      return word;
+    };
+
+    std::vector<percy::chain> chains( num_chains );
+    for ( auto& c : chains )
+    {
+      auto const nr_in = static_cast<int>( read() );
+      auto const fanin = static_cast<int>( read() );
+      auto const nr_steps = static_cast<int>( read() );
+      c.reset( nr_in, 1, nr_steps, fanin );
+      c.set_output( 0, static_cast<int>( read() ) );
+
+      std::vector<int> step( fanin );
+      for ( auto i = 0; i < nr_steps; ++i )
+      {
+        for ( auto& f : step )
+        {
+          f = static_cast<int>( read() );
+        }
+        kitty::dynamic_truth_table op( fanin );
+        uint64_t const lo = read();
+        uint64_t const hi = read();
+        op._bits[0] = lo | ( hi << 32u );
+        op.mask_bits();
+        c.set_step( i, step, op );
+      }
+    }
+    return chains;
+  }
+
+private:
+  std::string _filename;
+  std::unique_ptr<detail::mapped_file> _file;
+
+  /* entries in the mapped file (pointing to their records) and entries added since */
+  std::unordered_map<std::string, char const*> _index;
+  std::unordered_map<std::string, std::vector<percy::chain>> _added;
+
+  mutable std::shared_mutex _mutex;
+};
+
+namespace detail
+{
+
+/* inputs of an NPN representative in terms of the original function: for an
+ * NPN configuration `( repr, phase, perm )` of `f`, input `i` of `repr` is
+ * variable `var[i]` of `f`, complemented if bit `i` of `neg` is set */
+struct npn_inputs
+{
+  std::vector<uint8_t> var;
+  uint32_t neg{0};
+  bool output_neg{false};
+};
+
+inline npn_inputs npn_input_mapping( uint32_t num_vars, uint32_t phase, std::vector<uint8_t> perm )
+{
+  npn_inputs m;
+  m.output_neg = ( phase >> num_vars ) & 1;
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    m.var.push_back( static_cast<uint8_t>( i ) );
+  }
+
+  /* replay the swaps and flips of `kitty::create_from_npn_config` */
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    if ( perm[i] == i )
+    {
+      continue;
+    }
+
+    auto k = i;
+    while ( perm[k] != i )
+    {
+      ++k;
+    }
+
+    for ( auto& v : m.var )
+    {
+      if ( v == i )
+      {
+        v = static_cast<uint8_t>( k );
+      }
+      else if ( v == k )
+      {
+        v = static_cast<uint8_t>( i );
+      }
+    }
+    std::swap( perm[i], perm[k] );
+  }
+
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    if ( ( phase >> i ) & 1 )
+    {
+      for ( auto j = 0u; j < num_vars; ++j )
+      {
+        if ( m.var[j] == i )
+        {
+          m.neg ^= 1u << j;
+        }
+      }
+    }
+  }
+
+  return m;
+}
+
+} // namespace detail
+
+} // namespace mockturtle
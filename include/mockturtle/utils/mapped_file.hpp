@@ -0,0 +1,136 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file mapped_file.hpp
+  \brief Read-only and append-only file access
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MOCKTURTLE_HAS_MMAP
+#endif
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+/* read-only view of a file, memory-mapped where supported */
+class mapped_file
+{
+public:
+  explicit mapped_file( std::string const& filename )
+  {
+#ifdef MOCKTURTLE_HAS_MMAP
+    int const fd = ::open( filename.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+      return;
+    }
+    struct stat st;
+    if ( ::fstat( fd, &st ) == 0 && st.st_size > 0 )
+    {
+      void* const addr = ::mmap( nullptr, static_cast<std::size_t>( st.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+      if ( addr != MAP_FAILED )
+      {
+        _data = static_cast<char const*>( addr );
+        _size = static_cast<std::size_t>( st.st_size );
+        _mapped = true;
+      }
+    }
+    ::close( fd );
+#else
+    std::ifstream in( filename, std::ifstream::binary | std::ifstream::ate );
+    if ( !in.is_open() )
+    {
+      return;
+    }
+    _buffer.resize( static_cast<std::size_t>( in.tellg() ) );
+    in.seekg( 0 );
+    in.read( _buffer.data(), _buffer.size() );
+    _data = _buffer.data();
+    _size = _buffer.size();
+#endif
+  }
+
+  ~mapped_file()
+  {
+#ifdef MOCKTURTLE_HAS_MMAP
+    if ( _mapped )
+    {
+      ::munmap( const_cast<char*>( _data ), _size );
+    }
+#endif
+  }
+
+  mapped_file( mapped_file const& ) = delete;
+  mapped_file& operator=( mapped_file const& ) = delete;
+
+  char const* begin() const { return _data; }
+  char const* end() const { return _data + _size; }
+  bool is_open() const { return _data != nullptr; }
+
+private:
+  char const* _data{nullptr};
+  std::size_t _size{0};
+  bool _mapped{false};
+  std::vector<char> _buffer;
+};
+
+/* appends `size` bytes to a file (created if needed) with a single write
+ * call, such that concurrent appends of several processes do not interleave */
+inline bool append_to_file( std::string const& filename, char const* data, std::size_t size )
+{
+#ifdef MOCKTURTLE_HAS_MMAP
+  int const fd = ::open( filename.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644 );
+  if ( fd < 0 )
+  {
+    return false;
+  }
+  auto const written = ::write( fd, data, size );
+  ::close( fd );
+  return written == static_cast<ssize_t>( size );
+#else
+  std::ofstream out( filename, std::ofstream::binary | std::ofstream::app );
+  out.write( data, size );
+  return static_cast<bool>( out );
+#endif
+}
+
+} // namespace detail
+
+} // namespace mockturtle
@@ -36,6 +36,7 @@
 
 #include <cassert>
 #include <memory>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -349,6 +350,10 @@ std::pair<NtkDest, node_map<signal<NtkDest>, NtkSrc>> initialize_copy_network( N
 
   node_map<signal<NtkDest>, NtkSrc> old2new( src );
   NtkDest dest;
+  if constexpr ( std::is_same_v<NtkDest, NtkSrc> && has_reserve_v<NtkDest> )
+  {
+    dest.reserve( src.size() );
+  }
   old2new[src.get_constant( false )] = dest.get_constant( false );
   if ( src.get_node( src.get_constant( true ) ) != src.get_node( src.get_constant( false ) ) )
   {
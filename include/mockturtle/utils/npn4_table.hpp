@@ -0,0 +1,149 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file npn4_table.hpp
+  \brief Shared NPN classification of all 4-input functions
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include <kitty/npn.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/static_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief NPN classification of all 4-input functions.
+ *
+ * The table stores, for each of the 65,536 functions over 4 variables, the
+ * index of its NPN class together with the phase and permutation that
+ * `kitty::exact_npn_canonization` returns for it.  The table is computed
+ * once per process, on first use, and shared by all callers; use
+ * `npn4_table::get()` to access it.  Lookups are thread-safe.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      auto const& npn4 = npn4_table::get();
+      kitty::static_truth_table<4> tt;
+      kitty::create_from_hex_string( tt, "6996" );
+      const auto [repr, phase, perm] = npn4.canonization( tt );
+   \endverbatim
+ */
+class npn4_table
+{
+public:
+  using truth_table_t = kitty::static_truth_table<4u>;
+  using npn_config_t = std::tuple<truth_table_t, uint32_t, std::vector<uint8_t>>;
+
+public:
+  /*! \brief Returns the process-wide table (computed on first call). */
+  static npn4_table const& get()
+  {
+    static const npn4_table table;
+    return table;
+  }
+
+  /*! \brief Returns the same result as `kitty::exact_npn_canonization( tt )`. */
+  npn_config_t canonization( truth_table_t const& tt ) const
+  {
+    auto const& e = _entries[*tt.cbegin()];
+    std::vector<uint8_t> perm( 4u );
+    for ( auto i = 0u; i < 4u; ++i )
+    {
+      perm[i] = ( e.perm >> ( 2u * i ) ) & 3u;
+    }
+    return {_repr[e.class_index], e.phase, perm};
+  }
+
+  /*! \brief Returns the NPN representative of `tt`. */
+  truth_table_t const& representative( truth_table_t const& tt ) const
+  {
+    return _repr[_entries[*tt.cbegin()].class_index];
+  }
+
+  /*! \brief Returns the index of the NPN class of `tt`. */
+  uint32_t class_index( truth_table_t const& tt ) const
+  {
+    return _entries[*tt.cbegin()].class_index;
+  }
+
+  /*! \brief Returns all NPN representatives (222 classes), ordered by class index. */
+  std::vector<truth_table_t> const& representatives() const
+  {
+    return _repr;
+  }
+
+private:
+  npn4_table()
+      : _entries( 1u << 16u )
+  {
+    /* class indexes are assigned in order of the smallest function of each class */
+    std::vector<int32_t> repr_to_class( 1u << 16u, -1 );
+    truth_table_t tt;
+    do
+    {
+      const auto [repr, phase, perm] = kitty::exact_npn_canonization( tt );
+      auto& class_index = repr_to_class[*repr.cbegin()];
+      if ( class_index == -1 )
+      {
+        class_index = static_cast<int32_t>( _repr.size() );
+        _repr.push_back( repr );
+      }
+
+      auto& e = _entries[*tt.cbegin()];
+      e.class_index = static_cast<uint8_t>( class_index );
+      e.phase = static_cast<uint8_t>( phase );
+      for ( auto i = 0u; i < 4u; ++i )
+      {
+        e.perm |= perm[i] << ( 2u * i );
+      }
+
+      kitty::next_inplace( tt );
+    } while ( !kitty::is_const0( tt ) );
+  }
+
+private:
+  struct entry
+  {
+    uint8_t class_index{0};
+    uint8_t phase{0};
+    uint8_t perm{0}; /* 2 bits per variable */
+  };
+
+  std::vector<entry> _entries;
+  std::vector<truth_table_t> _repr;
+};
+
+} // namespace mockturtle
@@ -32,17 +32,34 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/npn.hpp>
+#include <kitty/operations.hpp>
 #include <kitty/print.hpp>
+#include <kitty/properties.hpp>
 #include <kitty/static_truth_table.hpp>
+#include <parallel_hashmap/phmap.h>
 
 #include "../io/genlib_reader.hpp"
+#include "mapped_file.hpp"
+#include "npn4_table.hpp"
 
 namespace mockturtle
 {
@@ -80,6 +97,55 @@ struct tech_library_params
 
   /*! \brief reports all the entries in the library */
   bool very_verbose{ false };
+
+  /*! \brief number of gate levels in supergates (1 disables supergates) */
+  uint32_t supergate_levels{ 1u };
+
+  /*! \brief maximum number of inputs of a supergate (at most NInputs) */
+  uint32_t supergate_inputs{ 5u };
+
+  /*! \brief maximum number of generated supergates (0 for no limit) */
+  uint32_t max_supergates{ 100000u };
+
+  /*! \brief binary file to load the library from, or to store it in */
+  std::string cache_filename{};
+};
+
+/*! \brief Tree of library gates
+ *
+ * The root pins are connected to leaves or to other trees.  Leaves are
+ * numbered from left to right.  A single gate is a tree with one gate.
+ */
+template<unsigned NInputs>
+struct composed_gate
+{
+  static constexpr uint32_t leaf = std::numeric_limits<uint32_t>::max();
+
+  /* gate at the root */
+  struct gate const* root{};
+
+  /* number of leaves */
+  uint32_t num_vars{ 0 };
+  /* fanin of each root pin, `leaf` or the index of another composed gate */
+  std::array<uint32_t, NInputs> fanin{};
+  /* function over the leaves */
+  kitty::dynamic_truth_table function;
+
+  /* area */
+  float area{ 0 };
+  /* leaf-to-output delay */
+  std::array<float, NInputs> tdelay{};
+  /* leaf-to-output delay including the loads of the internal nets */
+  std::array<float, NInputs> tdelay_loaded{};
+  /* input load of each leaf */
+  std::array<float, NInputs> input_load{};
+  /* delay per unit of output load */
+  float fanout_delay{ 0 };
+
+  bool is_super() const
+  {
+    return std::any_of( fanin.begin(), fanin.begin() + root->num_vars, []( auto f ) { return f != leaf; } );
+  }
 };
 
 template<unsigned NInputs>
@@ -87,25 +153,77 @@ struct supergate
 {
   struct gate const* root{};
 
+  /* tree of library gates (only the root for single gates) */
+  composed_gate<NInputs> const* tree{};
+
   /* area */
   float area{ 0 };
   /* worst delay */
   float worstDelay{ 0 };
   /* pin-to-pin delay */
   std::array<float, NInputs> tdelay{};
+  /* pin-to-pin delay including the loads of the internal nets */
+  std::array<float, NInputs> tdelay_loaded{};
+  /* input load of each pin */
+  std::array<float, NInputs> input_load{};
+  /* delay per unit of output load */
+  float fanout_delay{ 0 };
 
   /* np permutation vector */
-  std::vector<uint8_t> permutation{};
+  std::array<uint8_t, NInputs> permutation{};
 
   /* pin negations */
   uint8_t polarity{ 0 };
 };
 
-/*! \brief Library of np-enumerated gates
+/*! \brief Supergates matching one truth table
+ *
+ * A contiguous range of the match table, sorted by area.
+ */
+template<unsigned NInputs>
+class supergate_list
+{
+public:
+  supergate_list( supergate<NInputs> const* begin, supergate<NInputs> const* end )
+      : _begin( begin ), _end( end )
+  {
+  }
+
+  supergate<NInputs> const* begin() const { return _begin; }
+  supergate<NInputs> const* end() const { return _end; }
+  std::size_t size() const { return static_cast<std::size_t>( _end - _begin ); }
+  bool empty() const { return _begin == _end; }
+  supergate<NInputs> const& operator[]( std::size_t index ) const { return _begin[index]; }
+
+private:
+  supergate<NInputs> const* _begin;
+  supergate<NInputs> const* _end;
+};
+
+/*! \brief Library of np-enumerated gates and supergates
  *
  * This class creates a technology library from a set
  * of input gates. Each NP-configuration of each gate
  * is enumerated and inserted in the library.
+ *
+ * If `supergate_levels` is larger than 1, the library
+ * also contains supergates, i.e., trees of gates with up
+ * to `supergate_levels` levels and `supergate_inputs`
+ * leaves, as generated by the command ``super`` in ABC.
+ * Supergates that are dominated in area and in all
+ * leaf-to-output delays by a gate or another supergate
+ * of the same function are discarded.
+ *
+ * Configurations that are equal up to symmetries, and
+ * supergates dominated by another match, are discarded
+ * during the enumeration, such that the memory needed
+ * only depends on the size of the resulting library.
+ *
+ * All matches are stored in one array sorted by truth
+ * table and area.  If `cache_filename` is set, the
+ * library is loaded from this binary file when it was
+ * generated from the same gates and parameters, and
+ * written to it otherwise.
  *
    \verbatim embed:rst
 
@@ -121,9 +239,13 @@ struct supergate
 template<unsigned NInputs = 4u>
 class tech_library
 {
-  using supergates_list_t = std::vector<supergate<NInputs>>;
+  using supergates_list_t = supergate_list<NInputs>;
   using tt_hash = kitty::hash<kitty::static_truth_table<NInputs>>;
-  using lib_t = std::unordered_map<kitty::static_truth_table<NInputs>, supergates_list_t, tt_hash>;
+  using lib_t = phmap::flat_hash_map<kitty::static_truth_table<NInputs>, supergates_list_t, tt_hash>;
+
+  static constexpr uint32_t leaf = composed_gate<NInputs>::leaf;
+  static constexpr char cache_magic[8] = { 'M', 'T', 'T', 'E', 'C', 'H', 'L', 'B' };
+  static constexpr uint32_t cache_version = 2u;
 
 public:
   explicit tech_library( std::vector<gate> const& gates, tech_library_params const ps = {} )
@@ -131,7 +253,19 @@ public:
         _ps( ps ),
         _super_lib()
   {
-    generate_library();
+    analyze_gates();
+    if ( _ps.cache_filename.empty() || !read_library( _ps.cache_filename ) )
+    {
+      generate_library();
+      if ( !_ps.cache_filename.empty() && !write_library( _ps.cache_filename ) )
+      {
+        std::cerr << "[i] WARNING: could not write library to " << _ps.cache_filename << std::endl;
+      }
+    }
+    if ( _ps.very_verbose )
+    {
+      print_library();
+    }
   }
 
   const supergates_list_t* get_supergates( kitty::static_truth_table<NInputs> const& tt ) const
@@ -147,18 +281,36 @@ public:
     return std::make_tuple( _inv_area, _inv_delay, _inv_id );
   }
 
+  /*! \brief Returns the input load and the delay per unit of output load of the inverter. */
+  const std::tuple<float, float> get_inverter_load_info() const
+  {
+    return std::make_tuple( _inv_input_load, _inv_fanout_delay );
+  }
+
   unsigned max_gate_size()
   {
     return _max_size;
   }
 
-  const std::vector<gate> get_gates() const
+  const std::vector<gate>& get_gates() const
   {
     return _gates;
   }
 
+  /*! \brief Returns the gate trees referred to by the supergates. */
+  std::vector<composed_gate<NInputs>> const& get_composed_gates() const
+  {
+    return _composed;
+  }
+
+  /*! \brief Returns the number of generated supergates. */
+  uint32_t num_supergates() const
+  {
+    return static_cast<uint32_t>( std::count_if( _composed.begin(), _composed.end(), []( auto const& g ) { return g.is_super(); } ) );
+  }
+
 private:
-  void generate_library()
+  void analyze_gates()
   {
     bool inv = false;
 
@@ -170,8 +322,6 @@ private:
         continue;
       }
 
-      float worst_delay = compute_worst_delay( gate );
-
       if ( gate.function.num_vars() == 1 )
       {
         /* extract inverter delay and area */
@@ -181,7 +331,9 @@ private:
           if ( !inv || gate.area < _inv_area )
           {
             _inv_area = gate.area;
-            _inv_delay = worst_delay;
+            _inv_delay = compute_worst_delay( gate );
+            _inv_input_load = compute_input_load( gate, 0u );
+            _inv_fanout_delay = compute_worst_fanout_delay( gate );
             _inv_id = gate.id;
             inv = true;
           }
@@ -189,104 +341,621 @@ private:
       }
 
       _max_size = std::max( _max_size, gate.num_vars );
+    }
+
+    if ( !inv )
+    {
+      std::cerr << "[i] WARNING: inverter gate has not been detected in the library" << std::endl;
+    }
+  }
+
+  void generate_library()
+  {
+    /* single gates */
+    for ( auto const& gate : _gates )
+    {
+      if ( gate.function.num_vars() > NInputs )
+      {
+        continue;
+      }
+
+      composed_gate<NInputs> g;
+      g.root = &gate;
+      g.num_vars = gate.function.num_vars();
+      g.fanin.fill( leaf );
+      g.function = gate.function;
+      g.area = static_cast<float>( gate.area );
+      std::fill( g.tdelay.begin(), g.tdelay.begin() + g.num_vars, compute_worst_delay( gate ) ); /* if pin-to-pin delay change to: gate.delay[i] */
+      g.tdelay_loaded = g.tdelay;
+      for ( auto i = 0u; i < g.num_vars; ++i )
+      {
+        g.input_load[i] = compute_input_load( gate, i );
+      }
+      g.fanout_delay = compute_worst_fanout_delay( gate );
+      _composed.push_back( g );
+    }
+
+    std::vector<bool> in_library( _composed.size(), true );
+    if ( _ps.supergate_levels > 1u )
+    {
+      generate_supergates( in_library );
+    }
+
+    /* NP enumeration of each gate and supergate, keeping only the
+     * configurations that are not redundant for their function */
+    std::map<kitty::static_truth_table<NInputs>, std::vector<supergate<NInputs>>> matches;
+    for ( auto i = 0u; i < _composed.size(); ++i )
+    {
+      if ( !in_library[i] )
+      {
+        continue;
+      }
 
-      uint32_t np_count = 0;
+      auto const& g = _composed[i];
+      float const worst_delay = *std::max_element( g.tdelay.begin(), g.tdelay.end() );
 
       const auto on_np = [&]( auto const& tt, auto neg, auto const& perm ) {
         supergate<NInputs> sg;
-        sg.root = &gate;
-        sg.area = gate.area;
+        sg.root = g.root;
+        sg.tree = &g;
+        sg.area = g.area;
         sg.worstDelay = worst_delay;
+        sg.fanout_delay = g.fanout_delay;
         sg.polarity = 0;
-        sg.permutation = perm;
 
         for ( auto i = 0u; i < perm.size() && i < NInputs; ++i )
         {
-          sg.tdelay[i] = worst_delay;                     /* if pin-to-pin delay change to: gate.delay[perm[i]] */
+          sg.permutation[i] = perm[i];
+          sg.tdelay[i] = g.tdelay[perm[i]];
+          sg.tdelay_loaded[i] = g.tdelay_loaded[perm[i]];
+          sg.input_load[i] = g.input_load[perm[i]];
           sg.polarity |= ( ( neg >> perm[i] ) & 1 ) << i; /* permutate input negation to match the right pin */
         }
-        for ( auto i = perm.size(); i < NInputs; ++i )
+
+        insert_match( matches[kitty::extend_to<NInputs>( tt )], sg );
+      };
+
+      kitty::exact_np_enumeration( g.function, on_np );
+    }
+
+    build_match_table( matches );
+
+    if ( _ps.verbose )
+    {
+      std::vector<uint32_t> np_count( _composed.size(), 0u );
+      for ( auto const& sg : _supergates )
+      {
+        ++np_count[sg.tree - _composed.data()];
+      }
+      for ( auto i = 0u; i < _composed.size() && !_composed[i].is_super(); ++i )
+      {
+        std::cout << "Gate " << _composed[i].root->name << ", num_vars = " << _composed[i].num_vars << ", np entries = " << np_count[i] << std::endl;
+      }
+      std::cout << "Supergates = " << num_supergates() << ", matches = " << _supergates.size() << std::endl;
+    }
+  }
+
+  /* generates trees of gates level by level, keeping for each function only
+   * the trees that are not dominated in area and delay */
+  void generate_supergates( std::vector<bool>& in_library )
+  {
+    auto const max_inputs = std::min<uint32_t>( _ps.supergate_inputs, NInputs );
+    auto const num_gates = static_cast<uint32_t>( _composed.size() );
+
+    std::unordered_map<kitty::static_truth_table<NInputs>, std::vector<uint32_t>, tt_hash> fronts;
+    std::vector<bool> on_front( num_gates, false );
+    std::vector<uint32_t> level( num_gates, 1u );
+
+    const auto dominates = []( composed_gate<NInputs> const& a, composed_gate<NInputs> const& b ) {
+      if ( a.num_vars != b.num_vars || a.area > b.area || a.fanout_delay > b.fanout_delay )
+        return false;
+      for ( auto i = 0u; i < a.num_vars; ++i )
+      {
+        if ( a.tdelay[i] > b.tdelay[i] || a.tdelay_loaded[i] > b.tdelay_loaded[i] || a.input_load[i] > b.input_load[i] )
+          return false;
+      }
+      return true;
+    };
+
+    const auto is_dominated = [&]( composed_gate<NInputs> const& g ) {
+      auto const it = fronts.find( kitty::extend_to<NInputs>( g.function ) );
+      return it != fronts.end() && std::any_of( it->second.begin(), it->second.end(), [&]( auto other ) { return dominates( _composed[other], g ); } );
+    };
+
+    /* inserts a gate that is not dominated and removes the gates it dominates */
+    const auto insert_front = [&]( uint32_t index ) {
+      auto& front = fronts[kitty::extend_to<NInputs>( _composed[index].function )];
+      front.erase( std::remove_if( front.begin(), front.end(), [&]( auto other ) {
+                     if ( !dominates( _composed[index], _composed[other] ) )
+                       return false;
+                     on_front[other] = false;
+                     return true;
+                   } ),
+                   front.end() );
+      front.push_back( index );
+      on_front[index] = true;
+    };
+
+    /* gates with at least two inputs are the roots and fanins of the first level */
+    for ( auto i = 0u; i < num_gates; ++i )
+    {
+      if ( _composed[i].num_vars >= 2u && _composed[i].num_vars <= max_inputs && !is_dominated( _composed[i] ) )
+      {
+        insert_front( i );
+      }
+    }
+
+    std::vector<uint32_t> roots, operands;
+    for ( auto i = 0u; i < num_gates; ++i )
+    {
+      if ( on_front[i] )
+      {
+        roots.push_back( i );
+        if ( _composed[i].num_vars < max_inputs )
+          operands.push_back( i );
+      }
+    }
+
+    std::vector<std::vector<kitty::dynamic_truth_table>> nth_vars( max_inputs + 1u );
+    for ( auto n = 1u; n <= max_inputs; ++n )
+    {
+      for ( auto i = 0u; i < n; ++i )
+      {
+        kitty::dynamic_truth_table v( n );
+        kitty::create_nth_var( v, i );
+        nth_vars[n].push_back( v );
+      }
+    }
+
+    std::array<uint32_t, NInputs> choice{};
+    std::vector<kitty::dynamic_truth_table> pin_functions;
+    std::vector<kitty::dynamic_truth_table> child_vars;
+    bool limit_reached = false;
+
+    /* creates the tree of the current choice (0 is a leaf, c > 0 is operands[c - 1]) */
+    const auto add_candidate = [&]( uint32_t r, uint32_t num_leaves, uint32_t l ) {
+      auto const num_pins = _composed[r].num_vars;
+      float const root_delay = _composed[r].tdelay[0];
+      auto const& vars = nth_vars[num_leaves];
+
+      composed_gate<NInputs> g;
+      g.root = _composed[r].root;
+      g.num_vars = num_leaves;
+      g.fanin.fill( leaf );
+      g.area = _composed[r].area;
+      g.fanout_delay = _composed[r].fanout_delay;
+
+      pin_functions.resize( num_pins );
+      auto pos = 0u;
+      for ( auto pin = 0u; pin < num_pins; ++pin )
+      {
+        if ( choice[pin] == 0u )
         {
-          sg.tdelay[i] = 0; /* added for completeness but not necessary */
+          pin_functions[pin] = vars[pos];
+          g.tdelay[pos] = root_delay;
+          g.tdelay_loaded[pos] = root_delay;
+          g.input_load[pos++] = _composed[r].input_load[pin];
+          continue;
         }
 
-        const auto static_tt = kitty::extend_to<NInputs>( tt );
-
-        auto& v = _super_lib[static_tt];
-
-        /* ordered insert by ascending area and number of input pins */
-        auto it = std::lower_bound( v.begin(), v.end(), sg, [&]( auto const& s1, auto const& s2 ) {
-          if ( s1.area < s2.area )
-            return true;
-          if ( s1.area > s2.area )
-            return false;
-          if ( s1.root->num_vars < s2.root->num_vars )
-            return true;
-          if ( s1.root->num_vars > s2.root->num_vars )
-            return true;
-          return s1.root->id < s2.root->id;
-        } );
-
-        bool to_add = true;
-        /* search for duplicated element due to symmetries */
-        while ( it != v.end() )
+        auto const& child = _composed[operands[choice[pin] - 1u]];
+        child_vars.assign( vars.begin() + pos, vars.begin() + pos + child.num_vars );
+        pin_functions[pin] = kitty::compose_truth_table( child.function, child_vars );
+        /* the internal net drives exactly one root pin */
+        float const internal_delay = child.fanout_delay * _composed[r].input_load[pin];
+        for ( auto i = 0u; i < child.num_vars; ++i )
         {
-          if ( sg.root->id == it->root->id )
+          g.tdelay[pos] = root_delay + child.tdelay[i];
+          g.tdelay_loaded[pos] = root_delay + child.tdelay_loaded[i] + internal_delay;
+          g.input_load[pos++] = child.input_load[i];
+        }
+        g.fanin[pin] = operands[choice[pin] - 1u];
+        g.area += child.area;
+      }
+      g.function = kitty::compose_truth_table( g.root->function, pin_functions );
+
+      /* trees with redundant leaves are never needed */
+      for ( auto i = 0u; i < num_leaves; ++i )
+      {
+        if ( !kitty::has_var( g.function, i ) )
+          return;
+      }
+      if ( is_dominated( g ) )
+        return;
+
+      _composed.push_back( g );
+      on_front.push_back( false );
+      level.push_back( l );
+      insert_front( static_cast<uint32_t>( _composed.size() - 1u ) );
+      limit_reached = _ps.max_supergates > 0u && _composed.size() - num_gates >= _ps.max_supergates;
+    };
+
+    for ( auto l = 2u; l <= _ps.supergate_levels && !limit_reached; ++l )
+    {
+      auto const num_operands = static_cast<uint32_t>( operands.size() );
+      auto const first_new = static_cast<uint32_t>( _composed.size() );
+
+      for ( auto r : roots )
+      {
+        auto const num_pins = _composed[r].num_vars;
+
+        /* neighboring symmetric pins receive non-decreasing choices */
+        std::array<bool, NInputs> symmetric{};
+        for ( auto i = 1u; i < num_pins; ++i )
+        {
+          symmetric[i] = kitty::is_symmetric_in( _composed[r].root->function, i - 1, i );
+        }
+
+        /* each tree of level l has a fanin of level l - 1 */
+        std::function<void( uint32_t, uint32_t, bool )> enumerate = [&]( uint32_t pin, uint32_t num_leaves, bool deepest ) {
+          if ( limit_reached )
+            return;
+
+          if ( pin == num_pins )
           {
-            /* if already in the library exit, else ignore permutations if with equal delay cost */
-            if ( sg.polarity == it->polarity && sg.tdelay == it->tdelay )
-            {
-              to_add = false;
-              break;
-            }
+            if ( deepest )
+              add_candidate( r, num_leaves, l );
+            return;
           }
-          else
+
+          for ( auto c = symmetric[pin] ? choice[pin - 1] : 0u; c <= num_operands; ++c )
           {
-            break;
+            auto size = 1u;
+            auto is_deepest = false;
+            if ( c > 0u )
+            {
+              auto const op = operands[c - 1u];
+              if ( !on_front[op] )
+                continue;
+              size = _composed[op].num_vars;
+              is_deepest = level[op] == l - 1u;
+            }
+            if ( num_leaves + size + ( num_pins - pin - 1u ) > max_inputs )
+              continue;
+
+            choice[pin] = c;
+            enumerate( pin + 1u, num_leaves + size, deepest || is_deepest );
           }
-          ++it;
-        }
+        };
+        enumerate( 0u, 0u, false );
+      }
 
-        if ( to_add )
-        {
-          v.insert( it, sg );
-          ++np_count;
-        }
+      /* new trees are fanins of the next level */
+      for ( auto i = first_new; i < _composed.size(); ++i )
+      {
+        if ( on_front[i] && _composed[i].num_vars < max_inputs )
+          operands.push_back( i );
+      }
+    }
+
+    in_library.resize( _composed.size() );
+    for ( auto i = num_gates; i < _composed.size(); ++i )
+    {
+      in_library[i] = on_front[i];
+    }
+  }
+
+  /* matches of a function are sorted by area, then by size and gate */
+  static bool precedes( supergate<NInputs> const& s1, supergate<NInputs> const& s2 )
+  {
+    if ( s1.area != s2.area )
+      return s1.area < s2.area;
+    if ( s1.tree->num_vars != s2.tree->num_vars )
+      return s1.tree->num_vars < s2.tree->num_vars;
+    if ( s1.root->id != s2.root->id )
+      return s1.root->id < s2.root->id;
+    return s1.tree < s2.tree;
+  }
+
+  /* `sg` is redundant after `other` if both are the same configuration up
+   * to symmetries, or if `sg` is a supergate dominated by `other` */
+  static bool is_redundant( supergate<NInputs> const& other, supergate<NInputs> const& sg )
+  {
+    if ( other.tree == sg.tree && other.polarity == sg.polarity && other.tdelay == sg.tdelay && other.tdelay_loaded == sg.tdelay_loaded && other.input_load == sg.input_load )
+      return true;
+    if ( !sg.tree->is_super() || other.area > sg.area || other.fanout_delay > sg.fanout_delay )
+      return false;
+    for ( auto k = 0u; k < NInputs; ++k )
+    {
+      if ( other.tdelay[k] > sg.tdelay[k] || other.tdelay_loaded[k] > sg.tdelay_loaded[k] || other.input_load[k] > sg.input_load[k] )
+        return false;
+    }
+    return true;
+  }
+
+  /* inserts `sg` into the sorted matches of a function, unless it is
+   * redundant after an earlier match, and removes the later matches that are
+   * redundant after `sg`; since redundancy is transitive, the matches are the
+   * same as if all configurations were sorted and filtered at once, but only
+   * the non-redundant ones are kept in memory */
+  static void insert_match( std::vector<supergate<NInputs>>& list, supergate<NInputs> const& sg )
+  {
+    auto const pos = std::upper_bound( list.begin(), list.end(), sg, precedes );
+    if ( std::any_of( list.begin(), pos, [&]( auto const& other ) { return is_redundant( other, sg ); } ) )
+    {
+      return;
+    }
+
+    auto const it = list.insert( pos, sg );
+    list.erase( std::remove_if( it + 1, list.end(), [&]( auto const& other ) { return is_redundant( sg, other ); } ), list.end() );
+  }
+
+  /* stores the matches in one array sorted by truth table and area */
+  void build_match_table( std::map<kitty::static_truth_table<NInputs>, std::vector<supergate<NInputs>>>& matches )
+  {
+    std::size_t num_matches{ 0u };
+    for ( auto const& [tt, list] : matches )
+    {
+      num_matches += list.size();
+    }
+
+    std::vector<std::tuple<kitty::static_truth_table<NInputs>, uint64_t, uint64_t>> ranges;
+    _supergates.clear();
+    _supergates.reserve( num_matches );
+    for ( auto& [tt, list] : matches )
+    {
+      auto const begin = _supergates.size();
+      _supergates.insert( _supergates.end(), list.begin(), list.end() );
+      ranges.emplace_back( tt, begin, _supergates.size() );
+      std::vector<supergate<NInputs>>().swap( list );
+    }
+
+    _super_lib.clear();
+    _super_lib.reserve( ranges.size() );
+    for ( auto const& [tt, begin, end] : ranges )
+    {
+      _super_lib.emplace( tt, supergates_list_t{ _supergates.data() + begin, _supergates.data() + end } );
+    }
+  }
+
+  void print_library() const
+  {
+    for ( auto const& entry : _super_lib )
+    {
+      kitty::print_hex( entry.first );
+      std::cout << ": ";
+      for ( auto const& gate : entry.second )
+      {
+        printf( "%s%s(d:%.2f, a:%.2f, p:%d) ", gate.root->name.c_str(), gate.tree->is_super() ? "*" : "", gate.worstDelay, gate.area, gate.polarity );
+      }
+      std::cout << std::endl;
+    }
+  }
+
+  /* identifies the gates and the parameters the library is generated from */
+  uint64_t fingerprint() const
+  {
+    uint64_t h = UINT64_C( 0xcbf29ce484222325 );
+    const auto add = [&]( void const* data, std::size_t size ) {
+      for ( auto i = 0u; i < size; ++i )
+      {
+        h = ( h ^ static_cast<unsigned char const*>( data )[i] ) * UINT64_C( 0x100000001b3 );
+      }
+    };
+    const auto add_value = [&]( auto value ) {
+      add( &value, sizeof( value ) );
+    };
+
+    add_value( NInputs );
+    add_value( _ps.supergate_levels );
+    add_value( _ps.supergate_inputs );
+    add_value( _ps.max_supergates );
+    add_value( _gates.size() );
+    for ( auto const& g : _gates )
+    {
+      add( g.name.data(), g.name.size() );
+      add( g.expression.data(), g.expression.size() );
+      add_value( g.area );
+      add_value( g.pins.size() );
+      for ( auto const& pin : g.pins )
+      {
+        add( pin.name.data(), pin.name.size() );
+        add_value( pin.input_load );
+        add_value( pin.rise_block_delay );
+        add_value( pin.rise_fanout_delay );
+        add_value( pin.fall_block_delay );
+        add_value( pin.fall_fanout_delay );
+      }
+    }
+    return h;
+  }
 
-        /* check correct results */
-        // assert( gate.function == create_from_npn_config( std::make_tuple( tt, neg, sg.permutation ) ) );
+  bool write_library( std::string const& filename ) const
+  {
+    auto const tmp = filename + ".tmp";
+    {
+      std::ofstream out( tmp, std::ofstream::binary );
+      const auto write = [&]( auto const& value ) {
+        out.write( reinterpret_cast<char const*>( &value ), sizeof( value ) );
       };
 
-      /* NP enumeration of the function */
-      const auto tt = gate.function;
-      kitty::exact_np_enumeration( tt, on_np );
+      out.write( cache_magic, sizeof( cache_magic ) );
+      write( cache_version );
+      write( fingerprint() );
+      write( uint64_t( _composed.size() ) );
+      write( uint64_t( _supergates.size() ) );
+      write( uint64_t( _super_lib.size() ) );
+
+      for ( auto const& g : _composed )
+      {
+        write( uint32_t( g.root - _gates.data() ) );
+        write( g.num_vars );
+        write( g.fanin );
+        write( g.area );
+        write( g.tdelay );
+        write( g.tdelay_loaded );
+        write( g.input_load );
+        write( g.fanout_delay );
+      }
+      for ( auto const& sg : _supergates )
+      {
+        write( uint32_t( sg.tree - _composed.data() ) );
+        write( sg.area );
+        write( sg.worstDelay );
+        write( sg.tdelay );
+        write( sg.tdelay_loaded );
+        write( sg.input_load );
+        write( sg.fanout_delay );
+        write( sg.permutation );
+        write( sg.polarity );
+      }
+      for ( auto const& [tt, list] : _super_lib )
+      {
+        write( tt._bits );
+        write( uint64_t( list.begin() - _supergates.data() ) );
+        write( uint64_t( list.end() - _supergates.data() ) );
+      }
 
-      if ( _ps.verbose )
+      if ( !out )
       {
-        std::cout << "Gate " << gate.name << ", num_vars = " << gate.num_vars << ", np entries = " << np_count << std::endl;
+        std::remove( tmp.c_str() );
+        return false;
       }
     }
+    return std::rename( tmp.c_str(), filename.c_str() ) == 0;
+  }
 
-    if ( !inv )
+  bool read_library( std::string const& filename )
+  {
+    detail::mapped_file file( filename );
+    if ( !file.is_open() )
     {
-      std::cerr << "[i] WARNING: inverter gate has not been detected in the library" << std::endl;
+      return false;
     }
 
-    if ( _ps.very_verbose )
+    auto pos = file.begin();
+    bool failed = false;
+    const auto read = [&]( auto& value ) {
+      if ( failed || static_cast<std::size_t>( file.end() - pos ) < sizeof( value ) )
+      {
+        failed = true;
+        return;
+      }
+      std::memcpy( &value, pos, sizeof( value ) );
+      pos += sizeof( value );
+    };
+
+    char magic[sizeof( cache_magic )];
+    uint32_t version{ 0 };
+    uint64_t hash{ 0 }, num_composed{ 0 }, num_supergates{ 0 }, num_lists{ 0 };
+    read( magic );
+    read( version );
+    read( hash );
+    read( num_composed );
+    read( num_supergates );
+    read( num_lists );
+    if ( failed || std::memcmp( magic, cache_magic, sizeof( magic ) ) != 0 || version != cache_version || hash != fingerprint() )
     {
-      for ( auto const& entry : _super_lib )
+      return false;
+    }
+
+    std::vector<composed_gate<NInputs>> composed( num_composed );
+    for ( auto i = 0u; i < num_composed && !failed; ++i )
+    {
+      auto& g = composed[i];
+      uint32_t root{ 0 };
+      read( root );
+      read( g.num_vars );
+      read( g.fanin );
+      read( g.area );
+      read( g.tdelay );
+      read( g.tdelay_loaded );
+      read( g.input_load );
+      read( g.fanout_delay );
+      if ( root >= _gates.size() || _gates[root].num_vars > NInputs || g.num_vars > NInputs )
       {
-        kitty::print_hex( entry.first );
-        std::cout << ": ";
-        for ( auto const& gate : entry.second )
+        return false;
+      }
+      g.root = &_gates[root];
+      if ( !g.is_super() )
+      {
+        g.function = g.root->function;
+        continue;
+      }
+
+      /* recompute the function from the fanins, which precede the tree */
+      std::vector<kitty::dynamic_truth_table> pin_functions;
+      auto leaf_index = 0u;
+      for ( auto pin = 0u; pin < g.root->num_vars; ++pin )
+      {
+        if ( g.fanin[pin] == leaf )
         {
-          printf( "%s(d:%.2f, a:%.2f, p:%d) ", gate.root->name.c_str(), gate.worstDelay, gate.area, gate.polarity );
+          kitty::dynamic_truth_table v( g.num_vars );
+          kitty::create_nth_var( v, leaf_index++ );
+          pin_functions.push_back( v );
+          continue;
         }
-        std::cout << std::endl;
+        if ( g.fanin[pin] >= i )
+        {
+          return false;
+        }
+        auto const& child = composed[g.fanin[pin]];
+        std::vector<kitty::dynamic_truth_table> child_vars;
+        for ( auto k = 0u; k < child.num_vars; ++k )
+        {
+          kitty::dynamic_truth_table v( g.num_vars );
+          kitty::create_nth_var( v, leaf_index++ );
+          child_vars.push_back( v );
+        }
+        pin_functions.push_back( kitty::compose_truth_table( child.function, child_vars ) );
       }
+      if ( leaf_index != g.num_vars )
+      {
+        return false;
+      }
+      g.function = kitty::compose_truth_table( g.root->function, pin_functions );
+    }
+
+    std::vector<supergate<NInputs>> supergates( num_supergates );
+    std::vector<uint32_t> trees( num_supergates );
+    for ( auto i = 0u; i < num_supergates; ++i )
+    {
+      auto& sg = supergates[i];
+      auto& tree = trees[i];
+      read( tree );
+      read( sg.area );
+      read( sg.worstDelay );
+      read( sg.tdelay );
+      read( sg.tdelay_loaded );
+      read( sg.input_load );
+      read( sg.fanout_delay );
+      read( sg.permutation );
+      read( sg.polarity );
+      if ( failed || tree >= composed.size() )
+      {
+        return false;
+      }
+    }
+
+    std::vector<std::tuple<kitty::static_truth_table<NInputs>, uint64_t, uint64_t>> ranges( num_lists );
+    for ( auto& [tt, begin, end] : ranges )
+    {
+      read( tt._bits );
+      read( begin );
+      read( end );
+      if ( failed || begin > end || end > supergates.size() )
+      {
+        return false;
+      }
+    }
+
+    _composed = std::move( composed );
+    _supergates = std::move( supergates );
+    for ( auto i = 0u; i < _supergates.size(); ++i )
+    {
+      _supergates[i].tree = &_composed[trees[i]];
+      _supergates[i].root = _supergates[i].tree->root;
+    }
+    _super_lib.clear();
+    _super_lib.reserve( ranges.size() );
+    for ( auto const& [tt, begin, end] : ranges )
+    {
+      _super_lib.emplace( tt, supergates_list_t{ _supergates.data() + begin, _supergates.data() + end } );
     }
+    return true;
   }
 
+private:
   float compute_worst_delay( gate const& g )
   {
     float worst_delay = 0.0f;
@@ -300,17 +969,38 @@ private:
     return worst_delay;
   }
 
+  float compute_input_load( gate const& g, uint32_t i )
+  {
+    auto const pin = g.get_pin( i );
+    return pin == nullptr ? 0.0f : static_cast<float>( pin->input_load );
+  }
+
+  float compute_worst_fanout_delay( gate const& g )
+  {
+    float worst_fanout_delay = 0.0f;
+
+    for ( auto const& pin : g.pins )
+    {
+      worst_fanout_delay = std::max( worst_fanout_delay, static_cast<float>( std::max( pin.rise_fanout_delay, pin.fall_fanout_delay ) ) );
+    }
+    return worst_fanout_delay;
+  }
+
 private:
   /* inverter info */
   float _inv_area{ 0.0 };
   float _inv_delay{ 0.0 };
+  float _inv_input_load{ 0.0 };
+  float _inv_fanout_delay{ 0.0 };
   uint32_t _inv_id{ UINT32_MAX };
 
   unsigned _max_size{ 0 }; /* max #fanins of the gates in the library */
 
   std::vector<gate> const _gates; /* collection of gates */
   tech_library_params const _ps;
-  lib_t _super_lib; /* library of enumerated gates */
+  std::vector<composed_gate<NInputs>> _composed; /* gates and supergates */
+  std::vector<supergate<NInputs>> _supergates;   /* matches sorted by truth table */
+  lib_t _super_lib;                              /* ranges of matches by truth table */
 };
 
 template<typename Ntk, unsigned NInputs>
@@ -415,13 +1105,21 @@ private:
 
     /* Compute NPN classes */
     std::unordered_set<kitty::static_truth_table<NInputs>, tt_hash> classes;
-    kitty::static_truth_table<NInputs> tt;
-    do
+    if constexpr ( NInputs == 4u )
     {
-      const auto res = kitty::exact_npn_canonization( tt );
-      classes.insert( std::get<0>( res ) );
-      kitty::next_inplace( tt );
-    } while ( !kitty::is_const0( tt ) );
+      auto const& repr = npn4_table::get().representatives();
+      classes.insert( repr.begin(), repr.end() );
+    }
+    else
+    {
+      kitty::static_truth_table<NInputs> tt;
+      do
+      {
+        const auto res = kitty::exact_npn_canonization( tt );
+        classes.insert( std::get<0>( res ) );
+        kitty::next_inplace( tt );
+      } while ( !kitty::is_const0( tt ) );
+    }
 
     /* Constuct supergates */
     for ( auto const& entry : classes )
@@ -33,16 +33,103 @@
 
 #pragma once
 
-#include <unordered_map>
-#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
 
+#include <kitty/dynamic_truth_table.hpp>
 #include <kitty/hash.hpp>
 #include <kitty/operations.hpp>
 #include <kitty/operators.hpp>
+#include <kitty/traits.hpp>
 
 namespace mockturtle
 {
 
+/*! \cond PRIVATE */
+namespace detail
+{
+
+/* array of `width`-word elements in segments of doubling size that are never
+ * moved, such that elements can be added while others are read */
+class segmented_words
+{
+public:
+  static constexpr uint32_t num_segments = 32u;
+
+  explicit segmented_words( uint32_t width, uint32_t log_first_segment = 6u )
+      : _width( width ), _log_first( log_first_segment )
+  {
+    for ( auto& s : _segments )
+    {
+      s.store( nullptr, std::memory_order_relaxed );
+    }
+  }
+
+  ~segmented_words()
+  {
+    for ( auto& s : _segments )
+    {
+      delete[] s.load( std::memory_order_relaxed );
+    }
+  }
+
+  segmented_words( segmented_words const& ) = delete;
+  segmented_words& operator=( segmented_words const& ) = delete;
+
+  /* returns the words of element `i`, allocating its segment if needed */
+  uint64_t* allocate( uint64_t i )
+  {
+    auto const [s, offset] = locate( i );
+    auto* segment = _segments[s].load( std::memory_order_acquire );
+    if ( segment == nullptr )
+    {
+      auto* fresh = new uint64_t[( uint64_t( 1 ) << ( _log_first + s ) ) * _width];
+      if ( _segments[s].compare_exchange_strong( segment, fresh, std::memory_order_acq_rel ) )
+      {
+        segment = fresh;
+      }
+      else
+      {
+        delete[] fresh;
+      }
+    }
+    return segment + offset * _width;
+  }
+
+  /* returns the words of element `i`, which must have been allocated */
+  uint64_t const* operator[]( uint64_t i ) const
+  {
+    auto const [s, offset] = locate( i );
+    return _segments[s].load( std::memory_order_acquire ) + offset * _width;
+  }
+
+private:
+  std::pair<uint32_t, uint64_t> locate( uint64_t i ) const
+  {
+    auto q = ( i >> _log_first ) + 1u;
+    uint32_t s{0};
+    while ( q >>= 1 )
+    {
+      ++s;
+    }
+    return {s, i - ( ( ( uint64_t( 1 ) << s ) - 1u ) << _log_first )};
+  }
+
+private:
+  uint32_t _width;
+  uint32_t _log_first;
+  std::atomic<uint64_t*> _segments[num_segments];
+};
+
+} // namespace detail
+/*! \endcond */
+
 /*! \brief Truth table cache.
  *
  * A truth table cache is used to store truth tables.  Many applications
@@ -58,6 +145,12 @@ namespace mockturtle
  * \f$2i\f$ points to the normal truth table at index \f$i\f$.  A negative
  * literal \f$2i + 1\f$ points to the same truth table but returns its
  * complement.
+ *
+ * The words of the truth tables are stored inline in one arena per number of
+ * variables, and are found with an open addressing hash table.  Entries are
+ * never moved, and `insert` and `operator[]` can be called concurrently from
+ * several threads: inserts of different threads only synchronize when the
+ * hash table needs to grow.
  *
    \verbatim embed:rst
 
@@ -80,10 +173,17 @@ namespace mockturtle
 template<typename TT>
 class truth_table_cache
 {
+  static_assert( kitty::is_complete_truth_table<TT>::value, "TT is not a complete truth table type" );
+
 public:
   /*! \brief Creates a truth table cache and reserves memory. */
   truth_table_cache( uint32_t capacity = 1000u );
 
+  /*! \brief Creates a copy of a truth table cache with the same literals. */
+  truth_table_cache( truth_table_cache const& other );
+
+  truth_table_cache& operator=( truth_table_cache const& other );
+
   /*! \brief Inserts a truth table and returns a literal.
    *
    * To save space, only normal functions are stored in the truth table cache.
@@ -107,18 +207,93 @@ public:
   TT operator[]( uint32_t lit ) const;
 
   /*! \brief Returns number of normalized truth tables in the cache. */
-  auto size() const { return _data.size(); }
+  auto size() const { return _size.load( std::memory_order_acquire ); }
 
 private:
-  std::unordered_map<TT, uint32_t, kitty::hash<TT>> _indexes;
-  std::vector<TT> _data;
+  static constexpr uint64_t empty_slot = 0u;
+  static constexpr uint64_t busy_slot = ~uint64_t( 0 );
+  static constexpr uint32_t max_num_vars = 32u;
+
+  void reset( uint32_t capacity );
+  void grow( uint64_t num_slots );
+  uint32_t add_entry( TT const& tt );
+  bool equals( uint32_t index, TT const& tt ) const;
+
+  static uint32_t hash( TT const& tt )
+  {
+    auto const h = ( kitty::hash<TT>()( tt ) ^ tt.num_vars() ) * UINT64_C( 0x9e3779b97f4a7c15 );
+    return static_cast<uint32_t>( h >> 32 );
+  }
+
+private:
+  /* hash table: 32-bit hash in the upper half and index + 1 in the lower half of a slot */
+  std::unique_ptr<std::atomic<uint64_t>[]> _slots;
+  uint64_t _mask{0};
+  std::shared_mutex _grow_mutex;
+
+  /* entries: number of variables in the upper half and position in the arena in the lower half */
+  std::unique_ptr<detail::segmented_words> _entries;
+  std::unique_ptr<detail::segmented_words> _arenas[max_num_vars + 1];
+  std::atomic<uint32_t> _arena_sizes[max_num_vars + 1];
+  std::atomic<detail::segmented_words*> _arena_ptrs[max_num_vars + 1];
+  std::mutex _arena_mutex;
+
+  std::atomic<uint32_t> _size{0};
 };
 
 template<typename TT>
 truth_table_cache<TT>::truth_table_cache( uint32_t capacity )
 {
-  _indexes.reserve( capacity );
-  _data.reserve( capacity );
+  reset( capacity );
+}
+
+template<typename TT>
+truth_table_cache<TT>::truth_table_cache( truth_table_cache const& other )
+{
+  reset( other.size() );
+  for ( auto i = 0u; i < other.size(); ++i )
+  {
+    insert( other[2 * i] );
+  }
+}
+
+template<typename TT>
+truth_table_cache<TT>& truth_table_cache<TT>::operator=( truth_table_cache const& other )
+{
+  if ( this != &other )
+  {
+    reset( other.size() );
+    for ( auto i = 0u; i < other.size(); ++i )
+    {
+      insert( other[2 * i] );
+    }
+  }
+  return *this;
+}
+
+template<typename TT>
+void truth_table_cache<TT>::reset( uint32_t capacity )
+{
+  uint64_t num_slots = 1024u;
+  while ( num_slots < 2u * uint64_t( capacity ) )
+  {
+    num_slots <<= 1;
+  }
+  _slots.reset( new std::atomic<uint64_t>[num_slots] );
+  for ( auto i = 0u; i < num_slots; ++i )
+  {
+    _slots[i].store( empty_slot, std::memory_order_relaxed );
+  }
+  _mask = num_slots - 1u;
+
+  _entries = std::make_unique<detail::segmented_words>( 1u, 10u );
+  for ( auto i = 0u; i <= max_num_vars; ++i )
+  {
+    _arenas[i].reset();
+    _arena_sizes[i].store( 0u, std::memory_order_relaxed );
+    _arena_ptrs[i].store( nullptr, std::memory_order_relaxed );
+  }
+  _size.store( 0u, std::memory_order_release );
 }
 
 template<typename TT>
@@ -132,26 +307,137 @@ uint32_t truth_table_cache<TT>::insert( TT tt )
     tt = ~tt;
   }
 
-  /* is truth table already in cache? */
-  const auto it = _indexes.find( tt );
-  if ( it != _indexes.end() )
+  auto const h = hash( tt );
+  while ( true )
+  {
+    uint64_t num_slots{0};
+    {
+      std::shared_lock lock( _grow_mutex );
+      num_slots = _mask + 1u;
+
+      /* keep the load factor below 1/2 */
+      if ( 2u * ( uint64_t( _size.load( std::memory_order_relaxed ) ) + 1u ) <= num_slots )
+      {
+        for ( auto pos = h & _mask;; pos = ( pos + 1u ) & _mask )
+        {
+          auto slot = _slots[pos].load( std::memory_order_acquire );
+          if ( slot == empty_slot )
+          {
+            /* claim the slot, add the truth table, and publish its index */
+            if ( _slots[pos].compare_exchange_strong( slot, busy_slot, std::memory_order_acq_rel ) )
+            {
+              auto const index = add_entry( tt );
+              _slots[pos].store( ( uint64_t( h ) << 32 ) | ( index + 1u ), std::memory_order_release );
+              return 2 * index + is_compl;
+            }
+          }
+          while ( slot == busy_slot )
+          {
+            std::this_thread::yield();
+            slot = _slots[pos].load( std::memory_order_acquire );
+          }
+          if ( static_cast<uint32_t>( slot >> 32 ) == h && equals( static_cast<uint32_t>( slot ) - 1u, tt ) )
+          {
+            return 2 * ( static_cast<uint32_t>( slot ) - 1u ) + is_compl;
+          }
+        }
+      }
+    }
+
+    grow( num_slots );
+  }
+}
+
+template<typename TT>
+void truth_table_cache<TT>::grow( uint64_t num_slots )
+{
+  std::unique_lock lock( _grow_mutex );
+  if ( _mask + 1u != num_slots )
+  {
+    return; /* already grown by another thread */
+  }
+
+  std::unique_ptr<std::atomic<uint64_t>[]> slots( new std::atomic<uint64_t>[2u * num_slots] );
+  for ( auto i = 0u; i < 2u * num_slots; ++i )
   {
-    return static_cast<uint32_t>( 2 * it->second + is_compl );
+    slots[i].store( empty_slot, std::memory_order_relaxed );
+  }
+  auto const mask = 2u * num_slots - 1u;
+  for ( auto i = 0u; i < num_slots; ++i )
+  {
+    auto const slot = _slots[i].load( std::memory_order_relaxed );
+    if ( slot == empty_slot )
+      continue;
+
+    auto pos = ( slot >> 32 ) & mask;
+    while ( slots[pos].load( std::memory_order_relaxed ) != empty_slot )
+    {
+      pos = ( pos + 1u ) & mask;
+    }
+    slots[pos].store( slot, std::memory_order_relaxed );
   }
 
-  /* add truth table to end of cache */
-  const auto size = _data.size();
-  const auto index = static_cast<uint32_t>( 2 * size + is_compl );
-  _data.push_back( tt );
-  _indexes[tt] = static_cast<unsigned int>( size );
+  _slots = std::move( slots );
+  _mask = mask;
+}
+
+template<typename TT>
+uint32_t truth_table_cache<TT>::add_entry( TT const& tt )
+{
+  auto const num_vars = tt.num_vars();
+
+  auto* arena = _arena_ptrs[num_vars].load( std::memory_order_acquire );
+  if ( arena == nullptr )
+  {
+    std::lock_guard lock( _arena_mutex );
+    if ( !_arenas[num_vars] )
+    {
+      _arenas[num_vars] = std::make_unique<detail::segmented_words>( tt.num_blocks() );
+      _arena_ptrs[num_vars].store( _arenas[num_vars].get(), std::memory_order_release );
+    }
+    arena = _arenas[num_vars].get();
+  }
+
+  auto const position = _arena_sizes[num_vars].fetch_add( 1u, std::memory_order_relaxed );
+  std::copy( tt.cbegin(), tt.cend(), arena->allocate( position ) );
+
+  auto const index = _size.fetch_add( 1u, std::memory_order_acq_rel );
+  *_entries->allocate( index ) = ( uint64_t( num_vars ) << 32 ) | position;
   return index;
 }
 
+template<typename TT>
+bool truth_table_cache<TT>::equals( uint32_t index, TT const& tt ) const
+{
+  auto const entry = *( *_entries )[index];
+  if ( ( entry >> 32 ) != tt.num_vars() )
+  {
+    return false;
+  }
+  auto const* words = ( *_arena_ptrs[entry >> 32].load( std::memory_order_acquire ) )[static_cast<uint32_t>( entry )];
+  return std::equal( tt.cbegin(), tt.cend(), words );
+}
+
 template<typename TT>
 TT truth_table_cache<TT>::operator[]( uint32_t index ) const
 {
-  auto& entry = _data[index >> 1];
-  return ( index & 1 ) ? ~entry : entry;
+  auto const entry = *( *_entries )[index >> 1];
+  auto const num_vars = static_cast<uint32_t>( entry >> 32 );
+
+  TT tt = [&]() {
+    if constexpr ( std::is_same_v<TT, kitty::dynamic_truth_table> )
+    {
+      return TT( num_vars );
+    }
+    else
+    {
+      return TT();
+    }
+  }();
+  auto const* words = ( *_arena_ptrs[num_vars].load( std::memory_order_acquire ) )[static_cast<uint32_t>( entry )];
+  std::copy( words, words + tt.num_blocks(), tt.begin() );
+
+  return ( index & 1 ) ? ~tt : tt;
 }
 
-} /* namespace mockturtle */
\ No newline at end of file
+} /* namespace mockturtle */
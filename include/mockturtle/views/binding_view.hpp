@@ -0,0 +1,235 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file binding_view.hpp
+  \brief Binds the nodes of a network to the gates of a library
+*/
+
+#pragma once
+
+#include "../io/genlib_reader.hpp"
+#include "../traits.hpp"
+#include "topo_view.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Binds the nodes of a network to gates of a library.
+ *
+ * This view stores for each node the index of the library gate that
+ * implements it.  Technology mapping (`map`) returns a bound k-LUT network,
+ * and `gate_sizing` changes the bindings.  Like the network storage, the
+ * bindings are shared between copies of the view.  The view keeps a
+ * reference to the gates, hence they must outlive it.
+ *
+ * The arrival time of a bound node is the latest arrival time of a fanin
+ * plus the delay of its pin, which is the larger of the rise and fall block
+ * delays.  The load-dependent delay model adds the pin's fanout delay times
+ * the output load of the node, i.e., the sum of the input loads of the
+ * driven pins.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `node_to_index`
+ * - `get_node`
+ * - `is_ci`
+ * - `is_constant`
+ * - `foreach_node`
+ * - `foreach_fanin`
+ * - `foreach_po`
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      std::vector<gate> gates;
+      lorina::read_genlib( "file.genlib", genlib_reader( gates ) );
+      tech_library<5> lib( gates );
+
+      binding_view<klut_network> res = map( aig, lib );
+      res.foreach_gate( [&]( auto n ) {
+        std::cout << n << " is a " << res.get_binding( n ).name << "\n";
+      } );
+      res.report_stats();
+   \endverbatim
+ */
+template<class Ntk>
+class binding_view : public Ntk
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  static constexpr uint32_t unbound = std::numeric_limits<uint32_t>::max();
+
+  explicit binding_view( std::vector<gate> const& library, Ntk const& ntk = Ntk() )
+      : Ntk( ntk ),
+        _library( &library ),
+        _bindings( std::make_shared<std::vector<uint32_t>>() )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  }
+
+  /*! \brief Binds node `n` to the gate with index `id`. */
+  void add_binding( node const& n, uint32_t id )
+  {
+    assert( id < _library->size() );
+
+    auto const index = this->node_to_index( n );
+    if ( index >= _bindings->size() )
+    {
+      _bindings->resize( std::max<std::size_t>( index + 1u, this->size() ), unbound );
+    }
+    ( *_bindings )[index] = id;
+  }
+
+  void remove_binding( node const& n )
+  {
+    auto const index = this->node_to_index( n );
+    if ( index < _bindings->size() )
+    {
+      ( *_bindings )[index] = unbound;
+    }
+  }
+
+  bool has_binding( node const& n ) const
+  {
+    return get_binding_index( n ) != unbound;
+  }
+
+  /*! \brief Returns the index of the gate bound to `n`, or `unbound`. */
+  uint32_t get_binding_index( node const& n ) const
+  {
+    auto const index = this->node_to_index( n );
+    return index < _bindings->size() ? ( *_bindings )[index] : unbound;
+  }
+
+  gate const& get_binding( node const& n ) const
+  {
+    assert( has_binding( n ) );
+    return ( *_library )[get_binding_index( n )];
+  }
+
+  std::vector<gate> const& get_library() const
+  {
+    return *_library;
+  }
+
+  /*! \brief Returns the total area of the bound gates. */
+  double compute_area() const
+  {
+    double area = 0.0;
+    this->foreach_node( [&]( auto const& n ) {
+      if ( has_binding( n ) )
+      {
+        area += get_binding( n ).area;
+      }
+    } );
+    return area;
+  }
+
+  /*! \brief Returns the worst arrival time at the primary outputs.
+   *
+   * \param load_dependent Use the load-dependent delay model
+   * \param output_load Load of each primary output for the load-dependent model
+   */
+  double compute_worst_delay( bool load_dependent = false, double output_load = 0.0 ) const
+  {
+    std::vector<double> load( load_dependent ? this->size() : 0u, 0.0 );
+    if ( load_dependent )
+    {
+      this->foreach_node( [&]( auto const& n ) {
+        if ( !has_binding( n ) )
+          return;
+        auto const& g = get_binding( n );
+        this->foreach_fanin( n, [&]( auto const& f, auto i ) {
+          if ( auto const pin = g.get_pin( i ) )
+            load[this->node_to_index( this->get_node( f ) )] += pin->input_load;
+        } );
+      } );
+      this->foreach_po( [&]( auto const& f ) {
+        load[this->node_to_index( this->get_node( f ) )] += output_load;
+      } );
+    }
+
+    std::vector<double> arrival( this->size(), 0.0 );
+    topo_view<Ntk>{ *this }.foreach_node( [&]( auto const& n ) {
+      if ( this->is_constant( n ) || this->is_ci( n ) )
+        return;
+
+      auto const index = this->node_to_index( n );
+      auto const g = has_binding( n ) ? &get_binding( n ) : nullptr;
+      this->foreach_fanin( n, [&]( auto const& f, auto i ) {
+        double pin_delay = 0.0;
+        if ( auto const pin = g != nullptr ? g->get_pin( i ) : nullptr )
+        {
+          pin_delay = std::max( pin->rise_block_delay, pin->fall_block_delay );
+          if ( load_dependent )
+            pin_delay += std::max( pin->rise_fanout_delay, pin->fall_fanout_delay ) * load[index];
+        }
+        arrival[index] = std::max( arrival[index], arrival[this->node_to_index( this->get_node( f ) )] + pin_delay );
+      } );
+    } );
+
+    double delay = 0.0;
+    this->foreach_po( [&]( auto const& f ) {
+      delay = std::max( delay, arrival[this->node_to_index( this->get_node( f ) )] );
+    } );
+    return delay;
+  }
+
+  void report_stats( std::ostream& os = std::cout ) const
+  {
+    os << fmt::format( "[i] Area = {:>5.2f}; Delay = {:>5.2f};\n", compute_area(), compute_worst_delay() );
+  }
+
+private:
+  std::vector<gate> const* _library;
+  std::shared_ptr<std::vector<uint32_t>> _bindings;
+};
+
+} /* namespace mockturtle */
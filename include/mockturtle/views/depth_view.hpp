@@ -242,43 +242,82 @@ public:
     _depth = std::max( _depth, _levels[f] );
   }
 
-private:
-  uint32_t compute_levels( node const& n )
+  NodeCostFn const& cost_fn() const
   {
-    if ( this->visited( n ) == this->trav_id() )
-    {
-      return _levels[n];
-    }
-    this->set_visited( n, this->trav_id() );
+    return _cost_fn;
+  }
 
-    if ( this->is_constant( n ) )
-    {
-      return _levels[n] = 0;
-    }
-    if ( this->is_pi( n ) )
+  depth_view_params const& depth_params() const
+  {
+    return _ps;
+  }
+
+private:
+  /* computes the levels in the TFI of root without recursion: a node is
+   * kept on the stack until the levels of all its fanins are known */
+  uint32_t compute_levels( node const& root, std::vector<node>& stack )
+  {
+    stack.push_back( root );
+    while ( !stack.empty() )
     {
-      assert( !_ps.pi_cost || _cost_fn( *this, n ) >= 1 );
-      return _levels[n] = _ps.pi_cost ? _cost_fn( *this, n ) - 1 : 0;
-    }
+      auto const n = stack.back();
+      if ( this->visited( n ) == this->trav_id() )
+      {
+        stack.pop_back();
+        continue;
+      }
 
-    uint32_t level{0};
-    this->foreach_fanin( n, [&]( auto const& f ) {
-      auto clevel = compute_levels( this->get_node( f ) );
-      if ( _ps.count_complements && this->is_complemented( f ) )
+      if ( this->is_constant( n ) )
       {
-        clevel++;
+        _levels[n] = 0;
       }
-      level = std::max( level, clevel );
-    } );
+      else if ( this->is_pi( n ) )
+      {
+        assert( !_ps.pi_cost || _cost_fn( *this, n ) >= 1 );
+        _levels[n] = _ps.pi_cost ? _cost_fn( *this, n ) - 1 : 0;
+      }
+      else
+      {
+        bool ready = true;
+        uint32_t level{0};
+        this->foreach_fanin( n, [&]( auto const& f ) {
+          auto const cn = this->get_node( f );
+          if ( this->visited( cn ) != this->trav_id() )
+          {
+            stack.push_back( cn );
+            ready = false;
+            return;
+          }
+
+          auto clevel = _levels[cn];
+          if ( _ps.count_complements && this->is_complemented( f ) )
+          {
+            clevel++;
+          }
+          level = std::max( level, clevel );
+        } );
+
+        if ( !ready )
+        {
+          continue;
+        }
+        _levels[n] = level + _cost_fn( *this, n );
+      }
+
+      this->set_visited( n, this->trav_id() );
+      stack.pop_back();
+    }
 
-    return _levels[n] = level + _cost_fn( *this, n );
+    return _levels[root];
   }
 
   void compute_levels()
   {
+    std::vector<node> stack;
+
     _depth = 0;
     this->foreach_po( [&]( auto const& f ) {
-      auto clevel = compute_levels( this->get_node( f ) );
+      auto clevel = compute_levels( this->get_node( f ), stack );
       if ( _ps.count_complements && this->is_complemented( f ) )
       {
         clevel++;
@@ -295,11 +334,19 @@ private:
     } );
   }
 
-  void set_critical_path( node const& n )
+  void set_critical_path( node const& root )
   {
-    _crit_path[n] = true;
-    if ( !this->is_constant( n ) && !( _ps.pi_cost && this->is_pi( n ) ) )
+    std::vector<node> stack{root};
+    _crit_path[root] = true;
+    while ( !stack.empty() )
     {
+      auto const n = stack.back();
+      stack.pop_back();
+      if ( this->is_constant( n ) || ( _ps.pi_cost && this->is_pi( n ) ) )
+      {
+        continue;
+      }
+
       const auto lvl = _levels[n];
       this->foreach_fanin( n, [&]( auto const& f ) {
         const auto cn = this->get_node( f );
@@ -310,7 +357,8 @@ private:
         }
         if ( _levels[cn] + offset == lvl && !_crit_path[cn] )
         {
-          set_critical_path( cn );
+          _crit_path[cn] = true;
+          stack.push_back( cn );
         }
       } );
     }
@@ -35,6 +35,7 @@
 
 #include "../traits.hpp"
 #include "../networks/events.hpp"
+#include "../networks/detail/fanout_lists.hpp"
 #include "../networks/detail/foreach.hpp"
 #include "../utils/node_map.hpp"
 #include "immutable_view.hpp"
@@ -58,7 +59,9 @@ struct fanout_view_params
  * This view computes the fanout of each node of the network.
  * It implements the network interface method `foreach_fanout`.  The
  * fanout are computed at construction and can be recomputed by
- * calling the `update_fanout` method.
+ * calling the `update_fanout` method.  They are stored contiguously
+ * in a compressed sparse row layout (see `detail::fanout_lists`) and
+ * kept up to date on network events.
  *
  * **Required network functions:**
  * - `foreach_node`
@@ -90,7 +93,6 @@ public:
 
   explicit fanout_view( fanout_view_params const& ps = {} )
     : Ntk()
-    , _fanout( *this )
     , _ps( ps )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
@@ -104,7 +106,6 @@ public:
 
   explicit fanout_view( Ntk const& ntk, fanout_view_params const& ps = {} )
     : Ntk( ntk )
-    , _fanout( ntk )
     , _ps( ps )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
@@ -151,7 +152,8 @@ public:
   void foreach_fanout( node const& n, Fn&& fn ) const
   {
     assert( n < this->size() );
-    detail::foreach_element( _fanout[n].begin(), _fanout[n].end(), fn );
+    const auto index = this->node_to_index( n );
+    detail::foreach_element( _fanout.begin( index ), _fanout.end( index ), fn );
   }
 
   void update_fanout()
@@ -161,7 +163,7 @@ public:
 
   std::vector<node> fanout( node const& n ) const /* deprecated */
   {
-    return _fanout[n];
+    return _fanout.to_vector( this->node_to_index( n ) );
   }
 
   void substitute_node( node const& old_node, signal const& new_signal )
@@ -174,7 +176,7 @@ public:
       const auto [_old, _new] = to_substitute.top();
       to_substitute.pop();
 
-      const auto parents = _fanout[_old];
+      const auto parents = _fanout.to_vector( this->node_to_index( _old ) );
       for ( auto n : parents )
       {
         if ( const auto repl = Ntk::replace_in_node( n, _old, _new ); repl )
@@ -197,9 +199,9 @@ private:
     if ( _ps.update_on_add )
     {
       add_event = Ntk::events().register_add_event( [this]( auto const& n ) {
-        _fanout.resize();
+        _fanout.resize( static_cast<uint32_t>( this->size() ) );
         Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].push_back( n );
+          _fanout.push_back( fanin_index( f ), n );
         } );
       } );
     }
@@ -209,10 +211,10 @@ private:
       modified_event = Ntk::events().register_modified_event( [this]( auto const& n, auto const& previous ) {
         (void)previous;
         for ( auto const& f : previous ) {
-          _fanout[f].erase( std::remove( _fanout[f].begin(), _fanout[f].end(), n ), _fanout[f].end() );
+          _fanout.erase( fanin_index( f ), n );
         }
         Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].push_back( n );
+          _fanout.push_back( fanin_index( f ), n );
         } );
       } );
     }
@@ -220,9 +222,9 @@ private:
     if ( _ps.update_on_delete )
     {
       delete_event = Ntk::events().register_delete_event( [this]( auto const& n ) {
-        _fanout[n].clear();
+        _fanout.clear( this->node_to_index( n ) );
         Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].erase( std::remove( _fanout[f].begin(), _fanout[f].end(), n ), _fanout[f].end() );
+          _fanout.erase( fanin_index( f ), n );
         } );
       } );
     }
@@ -246,22 +248,32 @@ private:
     }
   }
 
+  /* works for fanins given as signals (`previous` in modified events) or nodes */
+  template<typename F>
+  uint32_t fanin_index( F const& f ) const
+  {
+    if constexpr ( std::is_same_v<F, signal> )
+    {
+      return this->node_to_index( this->get_node( f ) );
+    }
+    else
+    {
+      return this->node_to_index( f );
+    }
+  }
+
   void compute_fanout()
   {
-    _fanout.reset();
-
-    this->foreach_gate( [&]( auto const& n ){
-        this->foreach_fanin( n, [&]( auto const& c ){
-            auto& fanout = _fanout[c];
-            if ( std::find( fanout.begin(), fanout.end(), n ) == fanout.end() )
-            {
-              fanout.push_back( n );
-            }
-          });
-      });
+    _fanout.build( static_cast<uint32_t>( this->size() ), [&]( auto&& add ) {
+      this->foreach_gate( [&]( auto const& n ){
+          this->foreach_fanin( n, [&]( auto const& c ){
+              add( fanin_index( c ), n );
+            });
+        });
+    } );
   }
 
-  node_map<std::vector<node>, Ntk> _fanout;
+  detail::fanout_lists<node> _fanout;
   fanout_view_params _ps;
 
   std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
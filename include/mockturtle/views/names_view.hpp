@@ -139,6 +139,26 @@ public:
     return _output_names.at( index );
   }
 
+  /*! \brief Calls `fn( s, name )` for all named signals. */
+  template<typename Fn>
+  void foreach_signal_name( Fn&& fn ) const
+  {
+    for ( auto const& [s, name] : _signal_names )
+    {
+      fn( s, name );
+    }
+  }
+
+  /*! \brief Calls `fn( index, name )` for all named outputs. */
+  template<typename Fn>
+  void foreach_output_name( Fn&& fn ) const
+  {
+    for ( auto const& [index, name] : _output_names )
+    {
+      fn( index, name );
+    }
+  }
+
 private:
   std::string _network_name;
   std::map<signal, std::string> _signal_names;
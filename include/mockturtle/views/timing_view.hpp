@@ -0,0 +1,517 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file timing_view.hpp
+  \brief Incrementally maintained arrival and required times
+*/
+
+#pragma once
+
+#include "../networks/events.hpp"
+#include "../traits.hpp"
+#include "../utils/cost_functions.hpp"
+#include "../utils/node_map.hpp"
+#include "depth_view.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Maintains arrival times, required times, and critical paths.
+ *
+ * This view computes for each node its level (arrival time) and the
+ * length of the longest path from the node to a primary output.  The
+ * required time of a node is the difference of the depth and the latter;
+ * a node is on a critical path if its level equals its required time.
+ * Nodes without fanout are required at the depth.  Levels are defined as
+ * in `depth_view` and respect the same parameters.
+ *
+ * Unlike `depth_view`, the view keeps all values up to date when nodes
+ * are added, modified, or deleted.  After each change, only the nodes
+ * whose values change are updated by two levelized worklists, one
+ * towards the outputs for arrival times and one towards the inputs for
+ * required times.  No computation is recursive, such that very deep
+ * networks are supported.  The depth is recomputed from the outputs
+ * (only) when a level of an output driver decreases or outputs are
+ * redirected.
+ *
+ * The view requires fanouts, e.g., by means of `fanout_view`, which must
+ * be below the timing view such that its fanouts are updated first.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `is_complemented`
+ * - `is_constant`
+ * - `is_ci`
+ * - `is_pi`
+ * - `incr_trav_id`
+ * - `visited`
+ * - `set_visited`
+ * - `foreach_node`
+ * - `foreach_po`
+ * - `foreach_fanin`
+ * - `foreach_fanout`
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network aig = ...;
+      fanout_view aig_fanout{aig};
+      timing_view aig_timing{aig_fanout};
+
+      // changes to the network keep the timing information up to date
+      aig_timing.substitute_node( n, f );
+      std::cout << "Depth: " << aig_timing.depth() << "\n";
+   \endverbatim
+ */
+template<class Ntk, class NodeCostFn = unit_cost<Ntk>>
+class timing_view : public Ntk
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  explicit timing_view( Ntk const& ntk, NodeCostFn const& cost_fn = {}, depth_view_params const& ps = {} )
+      : Ntk( ntk ),
+        _ps( ps ),
+        _cost_fn( cost_fn ),
+        _levels( *this ),
+        _rlevels( *this ),
+        _po_refs( *this ),
+        _queued( *this )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+    static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+    static_assert( has_incr_trav_id_v<Ntk>, "Ntk does not implement the incr_trav_id method" );
+    static_assert( has_visited_v<Ntk>, "Ntk does not implement the visited method" );
+    static_assert( has_set_visited_v<Ntk>, "Ntk does not implement the set_visited method" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_foreach_fanout_v<Ntk>, "Ntk does not implement the foreach_fanout method" );
+
+    update_levels();
+    register_events();
+  }
+
+  /*! \brief Copy constructor (recomputes the timing information). */
+  timing_view( timing_view<Ntk, NodeCostFn> const& other )
+      : timing_view( static_cast<Ntk const&>( other ), other._cost_fn, other._ps )
+  {
+  }
+
+  timing_view<Ntk, NodeCostFn>& operator=( timing_view<Ntk, NodeCostFn> const& other ) = delete;
+
+  ~timing_view()
+  {
+    Ntk::events().release_add_event( _add_event );
+    Ntk::events().release_modified_event( _modified_event );
+    Ntk::events().release_delete_event( _delete_event );
+  }
+
+  uint32_t depth() const
+  {
+    if ( _depth_outdated )
+    {
+      compute_depth();
+    }
+    return _depth;
+  }
+
+  /*! \brief Returns the level (arrival time) of a node. */
+  uint32_t level( node const& n ) const
+  {
+    return _levels[n];
+  }
+
+  /*! \brief Returns the required time of a node. */
+  uint32_t required( node const& n ) const
+  {
+    return depth() - _rlevels[n];
+  }
+
+  /*! \brief Returns the difference of required time and level of a node. */
+  int32_t slack( node const& n ) const
+  {
+    return static_cast<int32_t>( required( n ) ) - static_cast<int32_t>( _levels[n] );
+  }
+
+  bool is_on_critical_path( node const& n ) const
+  {
+    return _levels[n] + _rlevels[n] == depth();
+  }
+
+  /*! \brief Recomputes all timing information from scratch. */
+  void update_levels()
+  {
+    _levels.reset( 0 );
+    _rlevels.reset( 0 );
+    _po_refs.reset( 0 );
+    _queued.reset( 0 );
+
+    compute_po_refs();
+
+    auto const order = topological_order();
+    for ( auto const& n : order )
+    {
+      _levels[n] = compute_level( n );
+    }
+    for ( auto it = order.rbegin(); it != order.rend(); ++it )
+    {
+      _rlevels[*it] = compute_rlevel( *it );
+    }
+    compute_depth();
+  }
+
+  void create_po( signal const& f )
+  {
+    Ntk::create_po( f );
+
+    auto const n = this->get_node( f );
+    add_po_ref( f );
+    _po_drivers.push_back( n );
+    if ( !_depth_outdated )
+    {
+      _depth = std::max( _depth, _levels[n] + complement_offset( f ) );
+    }
+    push_backward( n );
+    propagate();
+  }
+
+  void substitute_node( node const& old_node, signal const& new_signal )
+  {
+    Ntk::substitute_node( old_node, new_signal );
+
+    /* outputs are not redirected by an event, unless the old node is deleted */
+    if ( _po_refs[old_node] != 0u )
+    {
+      update_po_refs();
+      propagate();
+    }
+  }
+
+private:
+  /* additional delay of a complemented edge */
+  uint32_t complement_offset( signal const& f ) const
+  {
+    return ( _ps.count_complements && this->is_complemented( f ) ) ? 1u : 0u;
+  }
+
+  /* PO references are counted in bits 1 and above; bit 0 is set if a
+   * reference adds a complement to the path length */
+  void add_po_ref( signal const& f )
+  {
+    _po_refs[f] += 2u;
+    _po_refs[f] |= complement_offset( f );
+  }
+
+  void compute_po_refs()
+  {
+    _po_drivers.clear();
+    this->foreach_po( [&]( auto const& f ) {
+      add_po_ref( f );
+      _po_drivers.push_back( this->get_node( f ) );
+    } );
+  }
+
+  /* rescans the outputs after they have been redirected */
+  void update_po_refs()
+  {
+    for ( auto const& n : _po_drivers )
+    {
+      _po_refs[n] = 0u;
+      push_backward( n );
+    }
+    compute_po_refs();
+    for ( auto const& n : _po_drivers )
+    {
+      push_backward( n );
+    }
+    _depth_outdated = true;
+  }
+
+  void compute_depth() const
+  {
+    _depth = 0u;
+    this->foreach_po( [&]( auto const& f ) {
+      _depth = std::max( _depth, _levels[f] + complement_offset( f ) );
+    } );
+    _depth_outdated = false;
+  }
+
+  uint32_t compute_level( node const& n ) const
+  {
+    if ( this->is_constant( n ) )
+    {
+      return 0u;
+    }
+    if ( this->is_pi( n ) )
+    {
+      assert( !_ps.pi_cost || _cost_fn( *this, n ) >= 1 );
+      return _ps.pi_cost ? _cost_fn( *this, n ) - 1 : 0u;
+    }
+
+    uint32_t level{0};
+    this->foreach_fanin( n, [&]( auto const& f ) {
+      level = std::max( level, _levels[f] + complement_offset( f ) );
+    } );
+    return level + _cost_fn( *this, n );
+  }
+
+  /* length of the longest path from n to a PO */
+  uint32_t compute_rlevel( node const& n ) const
+  {
+    uint32_t rlevel = _po_refs[n] & 1u;
+    this->foreach_fanout( n, [&]( auto const& fo ) {
+      auto const cost = _cost_fn( *this, fo );
+      this->foreach_fanin( fo, [&]( auto const& f ) {
+        if ( this->get_node( f ) == n )
+        {
+          rlevel = std::max( rlevel, _rlevels[fo] + cost + complement_offset( f ) );
+        }
+      } );
+    } );
+    return rlevel;
+  }
+
+  /* all nodes, such that each node comes after its fanins */
+  std::vector<node> topological_order()
+  {
+    std::vector<node> order;
+    order.reserve( this->size() );
+    std::vector<node> stack;
+
+    this->incr_trav_id();
+    this->foreach_node( [&]( auto const& root ) {
+      stack.push_back( root );
+      while ( !stack.empty() )
+      {
+        auto const n = stack.back();
+        if ( this->visited( n ) == this->trav_id() )
+        {
+          stack.pop_back();
+          continue;
+        }
+
+        bool ready = true;
+        if ( !this->is_constant( n ) && !this->is_ci( n ) )
+        {
+          this->foreach_fanin( n, [&]( auto const& f ) {
+            if ( this->visited( this->get_node( f ) ) != this->trav_id() )
+            {
+              stack.push_back( this->get_node( f ) );
+              ready = false;
+            }
+          } );
+        }
+
+        if ( ready )
+        {
+          this->set_visited( n, this->trav_id() );
+          order.push_back( n );
+          stack.pop_back();
+        }
+      }
+    } );
+
+    return order;
+  }
+
+  void push_forward( node const& n )
+  {
+    if ( ( _queued[n] & 1u ) == 0u )
+    {
+      _queued[n] |= 1u;
+      _forward.emplace( _levels[n], n );
+    }
+  }
+
+  void push_backward( node const& n )
+  {
+    if ( ( _queued[n] & 2u ) == 0u )
+    {
+      _queued[n] |= 2u;
+      _backward.emplace( _levels[n], n );
+    }
+  }
+
+  /* updates all queued nodes; arrival times are processed in order of
+   * increasing level, required times in order of decreasing level */
+  void propagate()
+  {
+    while ( !_forward.empty() )
+    {
+      auto const n = _forward.top().second;
+      _forward.pop();
+      _queued[n] &= ~1u;
+
+      auto const level = compute_level( n );
+      if ( level == _levels[n] )
+      {
+        continue;
+      }
+
+      if ( _po_refs[n] != 0u && !_depth_outdated )
+      {
+        auto const arrival = level + ( _po_refs[n] & 1u );
+        if ( level > _levels[n] )
+        {
+          _depth = std::max( _depth, arrival );
+        }
+        else if ( _levels[n] + ( _po_refs[n] & 1u ) >= _depth )
+        {
+          _depth_outdated = true;
+        }
+      }
+
+      _levels[n] = level;
+      this->foreach_fanout( n, [&]( auto const& fo ) {
+        push_forward( fo );
+      } );
+    }
+
+    while ( !_backward.empty() )
+    {
+      auto const n = _backward.top().second;
+      _backward.pop();
+      _queued[n] &= ~2u;
+
+      if constexpr ( has_is_dead_v<Ntk> )
+      {
+        if ( this->is_dead( n ) )
+        {
+          continue;
+        }
+      }
+
+      auto const rlevel = compute_rlevel( n );
+      if ( rlevel == _rlevels[n] )
+      {
+        continue;
+      }
+
+      _rlevels[n] = rlevel;
+      if ( !this->is_constant( n ) && !this->is_ci( n ) )
+      {
+        this->foreach_fanin( n, [&]( auto const& f ) {
+          push_backward( this->get_node( f ) );
+        } );
+      }
+    }
+  }
+
+  void on_add( node const& n )
+  {
+    _levels.resize();
+    _rlevels.resize();
+    _po_refs.resize();
+    _queued.resize();
+
+    _levels[n] = compute_level( n );
+    this->foreach_fanin( n, [&]( auto const& f ) {
+      push_backward( this->get_node( f ) );
+    } );
+    propagate();
+  }
+
+  void on_modified( node const& n, std::vector<signal> const& previous )
+  {
+    push_forward( n );
+    for ( auto const& f : previous )
+    {
+      push_backward( this->get_node( f ) );
+    }
+    this->foreach_fanin( n, [&]( auto const& f ) {
+      push_backward( this->get_node( f ) );
+    } );
+    propagate();
+  }
+
+  void on_delete( node const& n )
+  {
+    if ( _po_refs[n] != 0u )
+    {
+      update_po_refs();
+    }
+    this->foreach_fanin( n, [&]( auto const& f ) {
+      push_backward( this->get_node( f ) );
+    } );
+    propagate();
+  }
+
+  void register_events()
+  {
+    _add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+    _modified_event = Ntk::events().register_modified_event( [this]( auto const& n, auto const& previous ) { on_modified( n, previous ); } );
+    _delete_event = Ntk::events().register_delete_event( [this]( auto const& n ) { on_delete( n ); } );
+  }
+
+private:
+  depth_view_params _ps;
+  NodeCostFn _cost_fn;
+
+  node_map<uint32_t, Ntk> _levels;
+  node_map<uint32_t, Ntk> _rlevels;
+  node_map<uint32_t, Ntk> _po_refs;
+  node_map<uint8_t, Ntk> _queued;
+  std::vector<node> _po_drivers;
+
+  mutable uint32_t _depth{0};
+  mutable bool _depth_outdated{false};
+
+  std::priority_queue<std::pair<uint32_t, node>, std::vector<std::pair<uint32_t, node>>, std::greater<>> _forward;
+  std::priority_queue<std::pair<uint32_t, node>> _backward;
+
+  std::shared_ptr<typename network_events<Ntk>::add_event_type> _add_event;
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> _modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> _delete_event;
+};
+
+template<class T>
+timing_view( T const& ) -> timing_view<T>;
+
+template<class T, class NodeCostFn = unit_cost<T>>
+timing_view( T const&, NodeCostFn const&, depth_view_params const& ) -> timing_view<T, NodeCostFn>;
+
+} // namespace mockturtle
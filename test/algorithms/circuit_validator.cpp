@@ -1,6 +1,10 @@
 #include <catch.hpp>
 
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
 #include <mockturtle/algorithms/circuit_validator.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/xag.hpp>
 #include <mockturtle/networks/mig.hpp>
@@ -8,6 +12,9 @@
 #include <mockturtle/utils/index_list.hpp>
 #include <bill/sat/interface/abc_bsat2.hpp>
 
+#include <algorithm>
+#include <vector>
+
 using namespace mockturtle;
 
 TEST_CASE( "Validating NEQ nodes and get CEX", "[validator]" )
@@ -184,4 +191,53 @@ TEST_CASE( "Validating with ODC", "[validator]" )
   v.set_odc_levels( 2 );
   CHECK( *( v.validate( f1, false ) ) == true );
   CHECK( *( v.validate( aig.get_node( f1 ), aig.get_constant( false ) ) ) == true );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Validating in incremental mode", "[validator]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 4u ), b( 4u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( f );
+  }
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  auto const tts = simulate_nodes<kitty::dynamic_truth_table>( aig, sim );
+
+  /* a small budget evicts cones between the queries */
+  validator_params ps;
+  ps.incremental = true;
+  ps.max_clauses = 50u;
+  ps.max_retired_clauses = 500u;
+  circuit_validator v( aig, ps );
+
+  std::vector<aig_network::node> gates;
+  aig.foreach_gate( [&]( auto const& n ) { gates.emplace_back( n ); } );
+
+  for ( auto round = 0u; round < 2u; ++round )
+  {
+    for ( auto i = 0u; i < gates.size(); i += 3u )
+    {
+      auto const n = gates[i];
+      auto const m = gates[( i * 7u + round ) % gates.size()];
+
+      auto const res = v.validate( n, aig.make_signal( m ) );
+      REQUIRE( res );
+      CHECK( *res == ( tts[n] == tts[m] ) );
+      if ( !*res )
+      {
+        uint64_t pattern = 0u;
+        for ( auto j = 0u; j < aig.num_pis(); ++j )
+        {
+          pattern |= uint64_t( v.cex[j] ) << j;
+        }
+        CHECK( kitty::get_bit( tts[n], pattern ) != kitty::get_bit( tts[m], pattern ) );
+      }
+
+      CHECK( *( v.validate( n, false ) ) == kitty::is_const0( tts[n] ) );
+    }
+  }
+}
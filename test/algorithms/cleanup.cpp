@@ -78,6 +78,32 @@ TEST_CASE( "cleanup networks with different types", "[cleanup]" )
   test_cleanup_into_network<mig_network, klut_network>();
 }
 
+TEST_CASE( "cleanup deep networks", "[cleanup]" )
+{
+  /* a chain that is too deep for a recursive traversal, with a dangling node
+   * attached to each gate */
+  aig_network aig;
+  auto f = aig.create_pi();
+  const auto x = aig.create_pi();
+  for ( auto i = 0u; i < 500000u; ++i )
+  {
+    aig.create_or( f, x );
+    f = aig.create_and( f, i % 2 ? x : !x );
+    f = aig.create_xor( f, x );
+  }
+  aig.create_po( f );
+  aig.create_po( !f );
+
+  const auto aig2 = cleanup_dangling( aig );
+  CHECK( aig.num_gates() == 2500000u );
+  CHECK( aig2.num_gates() == 2000000u );
+  CHECK( aig2.num_pos() == 2u );
+  CHECK( simulate<kitty::static_truth_table<2u>>( aig ) == simulate<kitty::static_truth_table<2u>>( aig2 ) );
+
+  CHECK( has_reserve_v<aig_network> );
+  CHECK( has_reserve_v<klut_network> );
+}
+
 TEST_CASE( "cleanup LUT network with too large AND gate", "[cleanup]" )
 {
   klut_network ntk;
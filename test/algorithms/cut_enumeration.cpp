@@ -1,6 +1,7 @@
 #include <catch.hpp>
 
 #include <iostream>
+#include <vector>
 
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
@@ -10,6 +11,42 @@
 
 using namespace mockturtle;
 
+namespace
+{
+
+/* wide AIG with 256 nodes on each level, such that levels are processed in parallel */
+aig_network create_wide_aig()
+{
+  aig_network aig;
+
+  std::vector<aig_network::signal> prev;
+  for ( auto i = 0u; i < 64u; ++i )
+  {
+    prev.push_back( aig.create_pi() );
+  }
+
+  for ( auto l = 0u; l < 8u; ++l )
+  {
+    std::vector<aig_network::signal> next;
+    for ( auto i = 0u; i < 256u; ++i )
+    {
+      const auto a = prev[( 7u * i + l ) % prev.size()];
+      const auto b = prev[( 13u * i + 3u * l + 1u ) % prev.size()];
+      next.push_back( ( i % 3u == 0u ) ? aig.create_or( a, !b ) : aig.create_and( !a, b ) );
+    }
+    prev = next;
+  }
+
+  for ( auto const& f : prev )
+  {
+    aig.create_po( f );
+  }
+
+  return aig;
+}
+
+} // namespace
+
 TEST_CASE( "enumerate cuts for an AIG", "[cut_enumeration]" )
 {
   aig_network aig;
@@ -329,3 +366,89 @@ TEST_CASE( "enumerate smaller cuts for an AIG (small graph version)", "[fast_sma
   CHECK( bitcut_to_vector( cuts.at( i4 )[1] ) == std::vector<uint32_t>{ 4, 5 } );
   CHECK( bitcut_to_vector( cuts.at( i4 )[2] ) == std::vector<uint32_t>{ 6 } );
 }
+
+TEST_CASE( "multi-threaded cut enumeration for an AIG", "[cut_enumeration]" )
+{
+  const auto aig = create_wide_aig();
+
+  cut_enumeration_params ps;
+  ps.cut_size = 6;
+  ps.cut_limit = 8;
+
+  const auto cuts = cut_enumeration<aig_network, true>( aig, ps );
+  ps.num_threads = 4;
+  const auto cuts_mt = cut_enumeration<aig_network, true>( aig, ps );
+
+  CHECK( cuts.total_cuts() == cuts_mt.total_cuts() );
+  CHECK( cuts.total_tuples() == cuts_mt.total_tuples() );
+
+  aig.foreach_node( [&]( auto const& n ) {
+    const auto index = aig.node_to_index( n );
+    const auto& set = cuts.cuts( index );
+    const auto& set_mt = cuts_mt.cuts( index );
+    REQUIRE( set.size() == set_mt.size() );
+    for ( auto i = 0u; i < set.size(); ++i )
+    {
+      CHECK( std::vector<uint32_t>( set[i].begin(), set[i].end() ) == std::vector<uint32_t>( set_mt[i].begin(), set_mt[i].end() ) );
+      CHECK( cuts.truth_table( set[i] ) == cuts_mt.truth_table( set_mt[i] ) );
+    }
+  } );
+}
+
+TEST_CASE( "multi-threaded fast cut enumeration for an AIG", "[cut_enumeration]" )
+{
+  const auto aig = create_wide_aig();
+
+  cut_enumeration_params ps;
+  ps.cut_limit = 8;
+  ps.minimize_truth_table = true;
+
+  const auto cuts = fast_cut_enumeration<aig_network, 6, true>( aig, ps );
+  ps.num_threads = 4;
+  const auto cuts_mt = fast_cut_enumeration<aig_network, 6, true>( aig, ps );
+
+  CHECK( cuts.total_cuts() == cuts_mt.total_cuts() );
+
+  aig.foreach_node( [&]( auto const& n ) {
+    const auto index = aig.node_to_index( n );
+    const auto& set = cuts.cuts( index );
+    const auto& set_mt = cuts_mt.cuts( index );
+    REQUIRE( set.size() == set_mt.size() );
+    for ( auto i = 0u; i < set.size(); ++i )
+    {
+      CHECK( std::vector<uint32_t>( set[i].begin(), set[i].end() ) == std::vector<uint32_t>( set_mt[i].begin(), set_mt[i].end() ) );
+      CHECK( cuts.truth_table( set[i] ) == cuts_mt.truth_table( set_mt[i] ) );
+    }
+  } );
+}
+
+TEST_CASE( "share truth table cache between cut enumeration and k-LUT network", "[cut_enumeration]" )
+{
+  const auto aig = create_wide_aig();
+
+  klut_network klut;
+  const auto size_before = klut.function_cache()->size();
+
+  cut_enumeration_params ps;
+  ps.cut_size = 4;
+  ps.cut_limit = 8;
+  ps.truth_tables = klut.function_cache();
+  const auto cuts = cut_enumeration<aig_network, true>( aig, ps );
+
+  CHECK( klut.function_cache()->size() > size_before );
+
+  std::vector<klut_network::signal> pis( 4u );
+  std::generate( pis.begin(), pis.end(), [&]() { return klut.create_pi(); } );
+
+  /* creating nodes from cut functions does not add new truth tables */
+  const auto size_after = klut.function_cache()->size();
+  aig.foreach_gate( [&]( auto const& n ) {
+    for ( auto const& cut : cuts.cuts( aig.node_to_index( n ) ) )
+    {
+      const auto tt = cuts.truth_table( *cut );
+      const auto f = klut.create_node( std::vector<klut_network::signal>( pis.begin(), pis.begin() + tt.num_vars() ), tt );
+      CHECK( klut.node_function( klut.get_node( f ) ) == tt );
+    }
+  } );
+  CHECK( klut.function_cache()->size() == size_after );
+}
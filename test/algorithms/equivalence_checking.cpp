@@ -1,9 +1,11 @@
 #include <catch.hpp>
 
+#include <algorithm>
 #include <vector>
 
 #include <mockturtle/algorithms/equivalence_checking.hpp>
 #include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/xag.hpp>
 
@@ -72,3 +74,54 @@ TEST_CASE( "Equivalence check on two non-equivalent AIGs", "[equivalence_checkin
   CHECK( !*result );
   CHECK( st.counter_example == std::vector<bool>( {true, true} ) );
 }
+
+TEST_CASE( "Sweeping equivalence check on two adders", "[equivalence_checking]" )
+{
+  aig_network aig1, aig2;
+
+  std::vector<aig_network::signal> a1( 8u ), b1( 8u ), a2( 8u ), b2( 8u );
+  std::generate( a1.begin(), a1.end(), [&]() { return aig1.create_pi(); } );
+  std::generate( b1.begin(), b1.end(), [&]() { return aig1.create_pi(); } );
+  std::generate( a2.begin(), a2.end(), [&]() { return aig2.create_pi(); } );
+  std::generate( b2.begin(), b2.end(), [&]() { return aig2.create_pi(); } );
+
+  auto carry1 = aig1.get_constant( false );
+  carry_ripple_adder_inplace( aig1, a1, b1, carry1 );
+  std::for_each( a1.begin(), a1.end(), [&]( auto const& f ) { aig1.create_po( f ); } );
+  aig1.create_po( carry1 );
+
+  auto carry2 = aig2.get_constant( false );
+  carry_lookahead_adder_inplace( aig2, a2, b2, carry2 );
+  std::for_each( a2.begin(), a2.end(), [&]( auto const& f ) { aig2.create_po( f ); } );
+  aig2.create_po( carry2 );
+
+  const auto miter_ntk = *miter<aig_network>( aig1, aig2 );
+
+  equivalence_checking_stats st;
+  const auto result = sweeping_equivalence_checking( miter_ntk, {}, &st );
+
+  CHECK( result );
+  CHECK( *result );
+  CHECK( st.functional_reduction_st.num_reduction > 0u );
+}
+
+TEST_CASE( "Sweeping equivalence check with a hard-to-simulate difference", "[equivalence_checking]" )
+{
+  aig_network aig1, aig2;
+
+  std::vector<aig_network::signal> xs1( 16u ), xs2( 16u );
+  std::generate( xs1.begin(), xs1.end(), [&]() { return aig1.create_pi(); } );
+  std::generate( xs2.begin(), xs2.end(), [&]() { return aig2.create_pi(); } );
+
+  aig1.create_po( aig1.create_nary_and( xs1 ) );
+  aig2.create_po( aig2.get_constant( false ) );
+
+  const auto miter_ntk = *miter<aig_network>( aig1, aig2 );
+
+  equivalence_checking_stats st;
+  const auto result = sweeping_equivalence_checking( miter_ntk, {}, &st );
+
+  CHECK( result );
+  CHECK( !*result );
+  CHECK( st.counter_example == std::vector<bool>( 16u, true ) );
+}
@@ -129,3 +129,74 @@ TEST_CASE( "functional reduction on XMG", "[functional_reduction]" )
   CHECK( ntk.size() == 9 );
   CHECK( vals == simulate<kitty::static_truth_table<4>>( ntk ) );
 }
+
+TEST_CASE( "functional reduction with equivalence classes on AIG", "[functional_reduction]" )
+{
+  aig_network ntk;
+
+  const auto a = ntk.create_pi();
+  const auto b = ntk.create_pi();
+  const auto c = ntk.create_pi();
+
+  const auto f1 = ntk.create_and( a, !b );
+  const auto f2 = ntk.create_and( !a, b );
+  const auto f3 = ntk.create_and( !a, !b );
+  const auto f4 = ntk.create_and( a, b );
+  const auto f5 = ntk.create_or( f1, f2 ); // a ^ b
+  const auto f6 = ntk.create_or( f3, f4 ); // a == b
+  const auto f7 = ntk.create_and( f5, c );
+  const auto f8 = ntk.create_and( !f6, c ); // f7
+  const auto f9 = ntk.create_and( f7, f6 ); // 0
+
+  ntk.create_po( f5 );
+  ntk.create_po( f6 );
+  ntk.create_po( f7 );
+  ntk.create_po( f8 );
+  ntk.create_po( f9 );
+
+  auto vals = simulate<kitty::static_truth_table<3>>( ntk );
+
+  CHECK( ntk.size() == 13 );
+  functional_reduction_params ps;
+  ps.equivalence_classes = true;
+  functional_reduction_stats st;
+  functional_reduction( ntk, ps, &st );
+  ntk = cleanup_dangling( ntk );
+  CHECK( ntk.size() == 8 );
+  CHECK( st.num_const_accepts == 1 );
+  CHECK( st.num_equ_accepts == 1 ); /* f8 is merged into f7 by structural hashing */
+  CHECK( vals == simulate<kitty::static_truth_table<3>>( ntk ) );
+}
+
+TEST_CASE( "functional reduction with equivalence classes on XAG", "[functional_reduction]" )
+{
+  xag_network ntk;
+
+  const auto a = ntk.create_pi();
+  const auto b = ntk.create_pi();
+  const auto c = ntk.create_pi();
+
+  const auto f1 = ntk.create_and( a, b );
+  const auto f2 = ntk.create_xnor( f1, c );
+
+  const auto f3 = ntk.create_and( a, !c );
+  const auto f4 = ntk.create_and( f3, b ); // ab!c
+  const auto f5 = ntk.create_and( !a, c );
+  const auto f6 = ntk.create_and( !b, c );
+  const auto f7 = ntk.create_or( f5, f6 ); // !ac + !bc
+  const auto f8 = ntk.create_or( f4, f7 ); // ab!c + !ac + !bc = (ab) ^ c
+
+  ntk.create_po( f2 );
+  ntk.create_po( f8 );
+  // f2 == !f8, f8 is replaced by the class representative f2
+
+  auto vals = simulate<kitty::static_truth_table<3>>( ntk );
+
+  CHECK( ntk.size() == 12 );
+  functional_reduction_params ps;
+  ps.equivalence_classes = true;
+  functional_reduction( ntk, ps );
+  ntk = cleanup_dangling( ntk );
+  CHECK( ntk.size() == 6 );
+  CHECK( vals == simulate<kitty::static_truth_table<3>>( ntk ) );
+}
@@ -0,0 +1,117 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <lorina/genlib.hpp>
+#include <mockturtle/algorithms/gate_sizing.hpp>
+#include <mockturtle/algorithms/mapper.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/utils/tech_library.hpp>
+
+using namespace mockturtle;
+
+std::string const sizing_test_library = "GATE   inv1     1 O=!a;     PIN * INV 1 999 0.9 0.3 0.9 0.3\n"
+                                        "GATE   inv2     2 O=!a;     PIN * INV 2 999 0.9 0.15 0.9 0.15\n"
+                                        "GATE   inv4     3 O=!a;     PIN * INV 4 999 0.9 0.07 0.9 0.07\n"
+                                        "GATE   buf2     2 O=a;      PIN * NONINV 1 999 1.2 0.1 1.2 0.1\n"
+                                        "GATE   nand2    2 O=!(ab);  PIN * INV 1 999 1.0 0.4 1.0 0.4\n"
+                                        "GATE   nand2x2  3 O=!(ab);  PIN * INV 2 999 1.0 0.2 1.0 0.2\n"
+                                        "GATE   nor2     2 O=!{ab};  PIN * INV 1 999 1.4 0.5 1.4 0.5\n"
+                                        "GATE   xor2     5 O=[ab];   PIN * UNKNOWN 2 999 1.9 0.5 1.9 0.5\n"
+                                        "GATE   zero     0 O=0;\n"
+                                        "GATE   one      0 O=1;";
+
+TEST_CASE( "Gate sizing of high-fanout network", "[gate_sizing]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( sizing_test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3> lib( gates );
+
+  /* one node with 16 fanouts on the critical path */
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  auto f = aig.create_and( a, b );
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    aig.create_po( aig.create_and( f, aig.create_pi() ) );
+  }
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    f = aig.create_and( f, aig.create_pi() );
+  }
+  aig.create_po( f );
+
+  map_params mps;
+  mps.load_dependent_delay = true;
+  map_stats mst;
+  auto mapped = map( aig, lib, mps, &mst );
+
+  const double eps{ 0.005 };
+  CHECK( mapped.compute_worst_delay( true ) > mst.delay - eps );
+  CHECK( mapped.compute_worst_delay( true ) < mst.delay + eps );
+
+  gate_sizing_params ps;
+  gate_sizing_stats st;
+  auto sized = gate_sizing( mapped, ps, &st );
+
+  CHECK( st.delay_before > mst.delay - eps );
+  CHECK( st.delay_before < mst.delay + eps );
+  CHECK( st.delay_after < st.delay_before );
+  CHECK( st.resized_gates + st.inserted_buffers > 0u );
+  CHECK( sized.compute_worst_delay( true ) > st.delay_after - eps );
+  CHECK( sized.compute_worst_delay( true ) < st.delay_after + eps );
+  CHECK( sized.compute_area() > st.area_after - eps );
+  CHECK( sized.compute_area() < st.area_after + eps );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim ) == simulate<kitty::dynamic_truth_table>( sized, sim ) );
+}
+
+TEST_CASE( "Gate sizing with fanout limit", "[gate_sizing]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( sizing_test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3> lib( gates );
+
+  aig_network aig;
+  std::vector<aig_network::signal> a( 6u ), b( 6u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( f );
+  }
+
+  map_params mps;
+  mps.load_dependent_delay = true;
+  auto mapped = map( aig, lib, mps );
+
+  gate_sizing_params ps;
+  ps.max_fanout = 3u;
+  gate_sizing_stats st;
+  auto sized = gate_sizing( mapped, ps, &st );
+
+  CHECK( st.inserted_buffers > 0u );
+  sized.foreach_gate( [&]( auto const& n ) {
+    CHECK( sized.fanout_size( n ) <= 3u );
+  } );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim ) == simulate<kitty::dynamic_truth_table>( sized, sim ) );
+}
@@ -1,5 +1,8 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include <mockturtle/traits.hpp>
 #include <mockturtle/algorithms/lut_mapping.hpp>
 #include <mockturtle/generators/arithmetic.hpp>
@@ -141,3 +144,106 @@ TEST_CASE( "LUT mapping with functions of full adder", "[lut_mapping]" )
   CHECK( mapped_aig.cell_function( aig.get_node( sum ) )._bits[0] == 0x96 );
   CHECK( mapped_aig.cell_function( aig.get_node( carry ) )._bits[0] == 0x17 );
 }
+
+TEST_CASE( "LUT mapping with priority cuts", "[lut_mapping]" )
+{
+  aig_network aig;
+
+  std::vector<aig_network::signal> a( 64 ), b( 64 );
+  std::generate( a.begin(), a.end(), [&aig]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&aig]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+
+  carry_ripple_adder_inplace( aig, a, b, carry );
+
+  std::for_each( a.begin(), a.end(), [&]( auto f ) { aig.create_po( f ); } );
+  aig.create_po( carry );
+
+  lut_mapping_params ps;
+  ps.priority_cuts = true;
+
+  mapping_view mapped_aig{ aig };
+  lut_mapping( mapped_aig, ps );
+
+  CHECK( mapped_aig.num_cells() == 96 );
+  aig.foreach_po( [&]( auto const& f ) {
+    CHECK( mapped_aig.is_cell_root( aig.get_node( f ) ) );
+  } );
+  mapped_aig.foreach_node( [&]( auto const& n ) {
+    if ( !mapped_aig.is_cell_root( n ) )
+      return;
+    auto num_leaves = 0u;
+    mapped_aig.foreach_cell_fanin( n, [&]( auto const& l ) {
+      ++num_leaves;
+      CHECK( ( aig.is_pi( l ) || aig.is_constant( l ) || mapped_aig.is_cell_root( l ) ) );
+    } );
+    CHECK( num_leaves <= 6u );
+  } );
+}
+
+TEST_CASE( "LUT mapping with large priority cuts", "[lut_mapping]" )
+{
+  aig_network aig;
+
+  /* balanced AND tree, in which the union of two fanin cuts can have up to
+     twice as many leaves as the cut size */
+  std::vector<aig_network::signal> level( 64 );
+  std::generate( level.begin(), level.end(), [&aig]() { return aig.create_pi(); } );
+  while ( level.size() > 1u )
+  {
+    std::vector<aig_network::signal> next;
+    for ( auto i = 0u; i < level.size(); i += 2u )
+    {
+      next.push_back( aig.create_and( level[i], level[i + 1] ) );
+    }
+    level = next;
+  }
+  aig.create_po( level.front() );
+
+  lut_mapping_params ps;
+  ps.priority_cuts = true;
+  ps.cut_enumeration_ps.cut_size = 12u;
+
+  mapping_view mapped_aig{ aig };
+  lut_mapping( mapped_aig, ps );
+
+  CHECK( mapped_aig.is_cell_root( aig.get_node( level.front() ) ) );
+  auto max_leaves = 0u;
+  mapped_aig.foreach_node( [&]( auto const& n ) {
+    if ( !mapped_aig.is_cell_root( n ) )
+      return;
+    auto num_leaves = 0u;
+    mapped_aig.foreach_cell_fanin( n, [&]( auto const& l ) {
+      ++num_leaves;
+      CHECK( ( aig.is_pi( l ) || mapped_aig.is_cell_root( l ) ) );
+    } );
+    max_leaves = std::max( max_leaves, num_leaves );
+  } );
+  CHECK( max_leaves > 8u );
+  CHECK( max_leaves <= 12u );
+}
+
+TEST_CASE( "LUT mapping with priority cuts and functions of full adder", "[lut_mapping]" )
+{
+  aig_network aig;
+
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+
+  const auto [sum, carry] = full_adder( aig, a, b, c );
+  aig.create_po( sum );
+  aig.create_po( carry );
+
+  lut_mapping_params ps;
+  ps.priority_cuts = true;
+
+  mapping_view<aig_network, true> mapped_aig{ aig };
+  lut_mapping<mapping_view<aig_network, true>, true>( mapped_aig, ps );
+
+  CHECK( mapped_aig.num_cells() == 2 );
+  CHECK( mapped_aig.is_cell_root( aig.get_node( sum ) ) );
+  CHECK( mapped_aig.is_cell_root( aig.get_node( carry ) ) );
+  CHECK( mapped_aig.cell_function( aig.get_node( sum ) )._bits[0] == 0x96 );
+  CHECK( mapped_aig.cell_function( aig.get_node( carry ) )._bits[0] == 0x17 );
+}
@@ -1,5 +1,6 @@
 #include <catch.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -8,6 +9,7 @@
 #include <mockturtle/algorithms/node_resynthesis/mig_npn.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xmg_npn.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/io/genlib_reader.hpp>
 #include <mockturtle/networks/aig.hpp>
@@ -124,6 +126,46 @@ TEST_CASE( "Map of full adder", "[mapper]" )
   CHECK( st.delay < 3.8f + eps );
 }
 
+TEST_CASE( "Map of full adder with load-dependent delay", "[mapper]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3> lib( gates );
+
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+
+  const auto [sum, carry] = full_adder( aig, a, b, c );
+  aig.create_po( sum );
+  aig.create_po( carry );
+
+  map_params ps;
+  ps.load_dependent_delay = true;
+  ps.output_load = 1.0;
+  map_stats st;
+  auto luts = map( aig, lib, ps, &st );
+
+  const double eps{ 0.005 };
+
+  luts.foreach_gate( [&]( auto const& n ) {
+    CHECK( luts.has_binding( n ) );
+  } );
+  CHECK( luts.compute_area() > st.area - eps );
+  CHECK( luts.compute_area() < st.area + eps );
+  CHECK( luts.compute_worst_delay( true, 1.0 ) > st.delay - eps );
+  CHECK( luts.compute_worst_delay( true, 1.0 ) < st.delay + eps );
+  CHECK( st.delay > luts.compute_worst_delay() );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim ) == simulate<kitty::dynamic_truth_table>( luts, sim ) );
+}
+
 TEST_CASE( "Map with inverters", "[mapper]" )
 {
   std::vector<gate> gates;
@@ -244,6 +286,82 @@ TEST_CASE( "Map of buffer and constant outputs", "[mapper]" )
   CHECK( st.delay < 1.9f + eps );
 }
 
+TEST_CASE( "Multi-threaded map of multiplier", "[mapper]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3> lib( gates );
+
+  aig_network aig;
+  std::vector<aig_network::signal> a( 16u ), b( 16u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( f );
+  }
+
+  map_params ps;
+  map_stats st1, st2;
+  klut_network luts1 = map( aig, lib, ps, &st1 );
+  ps.num_threads = 4u;
+  klut_network luts2 = map( aig, lib, ps, &st2 );
+
+  CHECK( st1.area == st2.area );
+  CHECK( st1.delay == st2.delay );
+  CHECK( luts1.size() == luts2.size() );
+  CHECK( luts1.num_pos() == luts2.num_pos() );
+
+  luts1.foreach_gate( [&]( auto const& n ) {
+    CHECK( luts1.node_function( n ) == luts2.node_function( n ) );
+    std::vector<klut_network::signal> fanins1, fanins2;
+    luts1.foreach_fanin( n, [&]( auto const& f ) { fanins1.push_back( f ); } );
+    luts2.foreach_fanin( n, [&]( auto const& f ) { fanins2.push_back( f ); } );
+    CHECK( fanins1 == fanins2 );
+  } );
+}
+
+TEST_CASE( "Map of multiplier with supergates", "[mapper]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3> lib( gates );
+
+  tech_library_params tps;
+  tps.supergate_levels = 2u;
+  tech_library<3> super_lib( gates, tps );
+  CHECK( super_lib.num_supergates() > 0u );
+
+  aig_network aig;
+  std::vector<aig_network::signal> a( 6u ), b( 6u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( f );
+  }
+
+  map_params ps;
+  map_stats st1, st2;
+  klut_network luts1 = map( aig, lib, ps, &st1 );
+  klut_network luts2 = map( aig, super_lib, ps, &st2 );
+
+  CHECK( st2.delay <= st1.delay );
+  CHECK( luts2.num_pis() == aig.num_pis() );
+  CHECK( luts2.num_pos() == aig.num_pos() );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim ) == simulate<kitty::dynamic_truth_table>( luts2, sim ) );
+}
+
 TEST_CASE( "Exact map of bad MAJ3 and constant output", "[mapper]" )
 {
   mig_npn_resynthesis resyn{ true };
@@ -1,12 +1,18 @@
 #include <catch.hpp>
 
+#include <cstdio>
+#include <fstream>
+
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
 
 #include <mockturtle/algorithms/node_resynthesis/exact.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/utils/exact_synthesis_cache.hpp>
 
 using namespace mockturtle;
 
@@ -170,3 +176,102 @@ TEST_CASE( "Exact XMG for XOR3", "[exact]" )
   CHECK( xmg.num_gates() == 1u );
   CHECK( simulate<kitty::dynamic_truth_table>( xmg, sim )[0] == _xor );
 }
+
+TEST_CASE( "Exact resynthesis with a disk cache", "[exact]" )
+{
+  std::remove( "mockturtle-test-exact-cache.bin" );
+
+  /* two NPN classes: majority and AND-XOR */
+  std::vector<kitty::dynamic_truth_table> functions;
+  for ( auto const& hex : {"e8", "d4", "2b", "8e", "28", "82"} )
+  {
+    functions.emplace_back( 3u );
+    kitty::create_from_hex_string( functions.back(), hex );
+  }
+
+  auto const resynthesize = [&]( std::shared_ptr<exact_synthesis_cache> const& cache ) {
+    exact_resynthesis_params ps;
+    ps.disk_cache = cache;
+    exact_xmg_resynthesis_params xps;
+    xps.disk_cache = cache;
+
+    exact_resynthesis<klut_network> klut_resyn( 2u, ps );
+    exact_aig_resynthesis<aig_network> aig_resyn( false, ps );
+    exact_xmg_resynthesis<xmg_network> xmg_resyn( xps );
+
+    default_simulator<kitty::dynamic_truth_table> sim( 3u );
+    for ( auto const& f : functions )
+    {
+      klut_network klut;
+      std::vector<klut_network::signal> klut_pis = {klut.create_pi(), klut.create_pi(), klut.create_pi()};
+      klut_resyn( klut, f, klut_pis.begin(), klut_pis.end(), [&]( auto const& s ) {
+        klut.create_po( s );
+      } );
+      CHECK( klut.num_pos() == 1u );
+      CHECK( simulate<kitty::dynamic_truth_table>( klut, sim )[0] == f );
+
+      aig_network aig;
+      std::vector<aig_network::signal> aig_pis = {aig.create_pi(), aig.create_pi(), aig.create_pi()};
+      aig_resyn( aig, f, aig_pis.begin(), aig_pis.end(), [&]( auto const& s ) {
+        aig.create_po( s );
+      } );
+      CHECK( aig.num_pos() == 1u );
+      CHECK( simulate<kitty::dynamic_truth_table>( aig, sim )[0] == f );
+
+      xmg_network xmg;
+      std::vector<xmg_network::signal> xmg_pis = {xmg.create_pi(), xmg.create_pi(), xmg.create_pi()};
+      xmg_resyn( xmg, f, xmg_pis.begin(), xmg_pis.end(), [&]( auto const& s ) {
+        xmg.create_po( s );
+        return true;
+      } );
+      CHECK( xmg.num_pos() > 0u );
+      for ( auto const& tt : simulate<kitty::dynamic_truth_table>( xmg, sim ) )
+      {
+        CHECK( tt == f );
+      }
+    }
+  };
+
+  auto cache = std::make_shared<exact_synthesis_cache>( "mockturtle-test-exact-cache.bin" );
+  resynthesize( cache );
+  CHECK( cache->size() == 6u );
+
+  /* a second cache reads the entries from the file */
+  auto reloaded = std::make_shared<exact_synthesis_cache>( "mockturtle-test-exact-cache.bin" );
+  CHECK( reloaded->size() == 6u );
+  resynthesize( reloaded );
+  CHECK( reloaded->size() == 6u );
+
+  std::remove( "mockturtle-test-exact-cache.bin" );
+}
+
+TEST_CASE( "Exact synthesis cache after a truncated record", "[exact]" )
+{
+  std::remove( "mockturtle-test-exact-cache-truncated.bin" );
+
+  kitty::dynamic_truth_table f( 3u ), g( 3u );
+  kitty::create_from_hex_string( f, "e8" );
+  kitty::create_from_hex_string( g, "96" );
+
+  exact_synthesis_cache cache( "mockturtle-test-exact-cache-truncated.bin" );
+  CHECK( cache.insert( "test", f, {} ) );
+
+  /* an incomplete record of odd length, as left by a crash during a write */
+  {
+    std::ofstream out( "mockturtle-test-exact-cache-truncated.bin", std::ios::binary | std::ios::app );
+    uint32_t const header[2] = {exact_synthesis_cache::magic, 64u};
+    out.write( reinterpret_cast<char const*>( header ), sizeof( header ) );
+    out.write( "abc", 3 );
+  }
+
+  exact_synthesis_cache appended( "mockturtle-test-exact-cache-truncated.bin" );
+  CHECK( appended.size() == 1u );
+  CHECK( appended.insert( "test", g, {} ) );
+
+  exact_synthesis_cache reloaded( "mockturtle-test-exact-cache-truncated.bin" );
+  CHECK( reloaded.size() == 2u );
+  CHECK( reloaded.find( "test", f ) );
+  CHECK( reloaded.find( "test", g ) );
+
+  std::remove( "mockturtle-test-exact-cache-truncated.bin" );
+}
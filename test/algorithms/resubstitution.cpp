@@ -4,11 +4,14 @@
 #include <mockturtle/views/fanout_view.hpp>
 #include <mockturtle/algorithms/resubstitution.hpp>
 #include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/equivalence_checking.hpp>
+#include <mockturtle/algorithms/miter.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xmg.hpp>
 #include <mockturtle/traits.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
 #include <mockturtle/io/write_verilog.hpp>
 
 #include <mockturtle/algorithms/aig_resub.hpp>
@@ -17,7 +20,9 @@
 #include <mockturtle/algorithms/xag_resub_withDC.hpp>
 #include <mockturtle/algorithms/sim_resub.hpp>
 
+#include <fmt/format.h>
 #include <kitty/static_truth_table.hpp>
+#include <lorina/aiger.hpp>
 
 using namespace mockturtle;
 
@@ -434,3 +439,32 @@ TEST_CASE( "Simulation-guided resubstitution", "[resubstitution]" )
   CHECK( aig.num_pos() == 1 );
   CHECK( aig.num_gates() == 1 );
 }
+
+TEST_CASE( "Parallel resubstitution of AIGs", "[resubstitution]" )
+{
+  for ( auto const& id : {1908, 2670, 5315, 7552} )
+  {
+    aig_network aig;
+    if ( lorina::read_aiger( fmt::format( "{}/c{}.aig", BENCHMARKS_PATH, id ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    resubstitution_params ps;
+    ps.max_inserts = 1u;
+    ps.num_threads = 4u;
+
+    auto const optimize = [&]() {
+      auto ntk = cleanup_dangling( aig );
+      aig_resubstitution( ntk, ps );
+      return cleanup_dangling( ntk );
+    };
+
+    auto const opt = optimize();
+    CHECK( opt.num_gates() < aig.num_gates() );
+    CHECK( *equivalence_checking( *miter<aig_network>( aig, opt ) ) );
+
+    /* the result does not depend on the thread schedule */
+    CHECK( optimize().num_gates() == opt.num_gates() );
+  }
+}
@@ -1,8 +1,12 @@
 #include <catch.hpp>
 
 #include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
 
 #include <kitty/static_truth_table.hpp>
 
@@ -254,3 +258,285 @@ TEST_CASE( "Bit packing", "[simulation]" )
   CHECK( ( sim.compute_pi( 3 )._bits[0] & 0x0f ) == 0x0d ); /* x3 = xx1x101 -> x1101 */
   CHECK( ( sim.compute_pi( 4 )._bits[0] & 0x1f ) == 0x1d ); /* x4 = x1x1101 -> 11101 */
 }
+
+template<class Ntk>
+void check_bit_parallel_simulation( Ntk const& ntk )
+{
+  partial_simulator sim( ntk.num_pis(), 150 );
+
+  /* bit-parallel */
+  unordered_node_map<kitty::partial_truth_table, Ntk> node_to_value( ntk );
+  simulate_nodes( ntk, node_to_value, sim, true );
+
+  /* node by node with `compute` */
+  unordered_node_map<kitty::partial_truth_table, Ntk> expected( ntk );
+  simulate_nodes( ntk, expected, sim );
+
+  ntk.foreach_gate( [&]( auto const& n ) {
+    CHECK( node_to_value[n] == expected[n] );
+  } );
+
+  /* re-simulate the last block after adding patterns */
+  for ( auto i = 0u; i < 20u; ++i )
+  {
+    std::vector<bool> pattern( ntk.num_pis() );
+    for ( auto j = 0u; j < pattern.size(); ++j )
+    {
+      pattern[j] = ( ( i + j ) % 3u ) == 0u;
+    }
+    sim.add_pattern( pattern );
+  }
+  simulate_nodes( ntk, node_to_value, sim, false );
+
+  expected.reset();
+  simulate_nodes( ntk, expected, sim );
+
+  ntk.foreach_gate( [&]( auto const& n ) {
+    CHECK( node_to_value[n].num_bits() == 170u );
+    CHECK( node_to_value[n] == expected[n] );
+  } );
+}
+
+TEST_CASE( "Bit-parallel simulation of AIG and XAG", "[simulation]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_xor( a, !b );
+  const auto f2 = aig.create_and( f1, !c );
+  aig.create_po( aig.create_or( f2, !a ) );
+  check_bit_parallel_simulation( aig );
+
+  xag_network xag;
+  const auto d = xag.create_pi();
+  const auto e = xag.create_pi();
+  const auto f = xag.create_pi();
+  const auto g1 = xag.create_xor( d, !e );
+  const auto g2 = xag.create_and( g1, !f );
+  xag.create_po( xag.create_xnor( g2, !d ) );
+  check_bit_parallel_simulation( xag );
+}
+
+TEST_CASE( "Bit-parallel simulation of MIG and XMG", "[simulation]" )
+{
+  mig_network mig;
+  const auto a = mig.create_pi();
+  const auto b = mig.create_pi();
+  const auto c = mig.create_pi();
+  const auto f1 = mig.create_maj( a, !b, c );
+  const auto f2 = mig.create_and( f1, !c );
+  mig.create_po( mig.create_maj( !f1, f2, !a ) );
+  check_bit_parallel_simulation( mig );
+
+  xmg_network xmg;
+  const auto d = xmg.create_pi();
+  const auto e = xmg.create_pi();
+  const auto f = xmg.create_pi();
+  const auto g1 = xmg.create_xor3( d, !e, f );
+  const auto g2 = xmg.create_maj( g1, !f, e );
+  xmg.create_po( xmg.create_xor3( !g1, g2, d ) );
+  check_bit_parallel_simulation( xmg );
+}
+
+TEST_CASE( "Bit-parallel simulation after substitute_node", "[simulation]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto n1 = aig.create_and( a, b );
+  const auto n2 = aig.create_and( n1, c );
+  aig.create_po( n2 );
+
+  /* n2 now has a fanin with a larger index */
+  const auto n3 = aig.create_or( a, b );
+  aig.substitute_node( aig.get_node( n1 ), n3 );
+
+  partial_simulator sim( aig.num_pis(), 100 );
+  unordered_node_map<kitty::partial_truth_table, aig_network> node_to_value( aig );
+  simulate_nodes( aig, node_to_value, sim, true );
+
+  unordered_node_map<kitty::partial_truth_table, aig_network> expected( aig );
+  aig.foreach_gate( [&]( auto const& n ) {
+    simulate_node( aig, n, expected, sim );
+    CHECK( node_to_value[n] == expected[n] );
+  } );
+
+  /* re-simulate the last block */
+  sim.add_pattern( {true, true, true} );
+  simulate_nodes( aig, node_to_value, sim, false );
+
+  expected.reset();
+  aig.foreach_gate( [&]( auto const& n ) {
+    simulate_node( aig, n, expected, sim );
+    CHECK( node_to_value[n] == expected[n] );
+  } );
+}
+
+TEST_CASE( "Streaming simulation", "[simulation]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, !b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_xor( f2, !a );
+  const auto f4 = aig.create_or( f3, b );
+  aig.create_po( f4 );
+  aig.create_po( !f2 );
+
+  partial_simulator sim( aig.num_pis(), 200 );
+  const auto expected = simulate_nodes<kitty::partial_truth_table>( aig, sim );
+
+  uint32_t num_visited{0};
+  const auto tts = simulate_nodes_streaming<kitty::partial_truth_table>( aig, sim, {aig.get_node( f1 )}, [&]( auto const& n, auto const& tt ) {
+    ++num_visited;
+    CHECK( tt == expected[n] );
+  } );
+  CHECK( num_visited == aig.size() );
+
+  CHECK( tts.has( aig.get_node( f1 ) ) );
+  CHECK( tts.has( aig.get_node( f2 ) ) );
+  CHECK( tts.has( aig.get_node( f4 ) ) );
+  CHECK( !tts.has( aig.get_node( a ) ) );
+  CHECK( !tts.has( aig.get_node( f3 ) ) );
+  CHECK( tts[f1] == expected[f1] );
+  CHECK( tts[f2] == expected[f2] );
+  CHECK( tts[f4] == expected[f4] );
+
+  /* generic simulation values */
+  const auto expected_tt = simulate_nodes<kitty::static_truth_table<3u>>( aig );
+  const auto static_tts = simulate_nodes_streaming<kitty::static_truth_table<3u>>( aig );
+  CHECK( !static_tts.has( aig.get_node( f1 ) ) );
+  CHECK( static_tts[f2] == expected_tt[f2] );
+  CHECK( static_tts[f4] == expected_tt[f4] );
+}
+
+TEST_CASE( "Streaming simulation after substitute_node", "[simulation]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto n1 = aig.create_and( a, b );
+  const auto n2 = aig.create_and( n1, c );
+  const auto n3 = aig.create_and( n2, !a );
+  aig.create_po( n3 );
+
+  const auto n4 = aig.create_or( a, b );
+  aig.substitute_node( aig.get_node( n1 ), n4 );
+
+  partial_simulator sim( aig.num_pis(), 100 );
+  unordered_node_map<kitty::partial_truth_table, aig_network> expected( aig );
+  aig.foreach_gate( [&]( auto const& n ) {
+    simulate_node( aig, n, expected, sim );
+  } );
+
+  uint32_t num_visited{0};
+  const auto tts = simulate_nodes_streaming<kitty::partial_truth_table>( aig, sim, {}, [&]( auto const& n, auto const& tt ) {
+    if ( aig.is_pi( n ) || aig.is_constant( n ) )
+      return;
+    ++num_visited;
+    CHECK( tt == expected[n] );
+  } );
+  CHECK( num_visited == aig.num_gates() );
+  CHECK( tts[n3] == expected[n3] );
+}
+
+TEST_CASE( "Multi-threaded simulation", "[simulation]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 8 ), b( 8 );
+  std::generate( a.begin(), a.end(), [&aig]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&aig]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( f );
+  }
+
+  /* more than 3 chunks of words, the last one partially filled */
+  partial_simulator sim( aig.num_pis(), 13000 );
+  const auto expected = simulate_nodes<kitty::partial_truth_table>( aig, sim );
+
+  const auto tts = simulate_nodes_parallel( aig, sim, 4u );
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( tts[n] == expected[n] );
+  } );
+
+  unordered_node_map<kitty::partial_truth_table, aig_network> node_to_value( aig );
+  simulate_nodes( aig, node_to_value, sim, true, 4u );
+  aig.foreach_gate( [&]( auto const& n ) {
+    CHECK( node_to_value[n] == expected[n] );
+  } );
+
+  /* generic simulation with `compute` */
+  klut_network klut;
+  const auto x1 = klut.create_pi();
+  const auto x2 = klut.create_pi();
+  const auto x3 = klut.create_pi();
+  const auto g1 = klut.create_maj( x1, x2, x3 );
+  const auto g2 = klut.create_xor( g1, x1 );
+  const auto g3 = klut.create_not( klut.create_ite( g2, x2, g1 ) );
+  klut.create_po( g3 );
+
+  partial_simulator klut_sim( klut.num_pis(), 9000 );
+  const auto klut_expected = simulate_nodes<kitty::partial_truth_table>( klut, klut_sim );
+  const auto klut_tts = simulate_nodes_parallel( klut, klut_sim, 3u );
+  klut.foreach_node( [&]( auto const& n ) {
+    CHECK( klut_tts[n] == klut_expected[n] );
+  } );
+}
+
+TEST_CASE( "Multi-threaded simulation after substitute_node", "[simulation]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 4 ), b( 4 );
+  std::generate( a.begin(), a.end(), [&aig]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&aig]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( f );
+  }
+
+  /* the fanouts of a[0] & b[0] get a fanin with a larger index */
+  const auto f = aig.create_and( a[0], b[0] );
+  const auto g = aig.create_or( a[1], b[1] );
+  aig.substitute_node( aig.get_node( f ), g );
+
+  partial_simulator sim( aig.num_pis(), 9000 );
+  unordered_node_map<kitty::partial_truth_table, aig_network> expected( aig );
+  aig.foreach_gate( [&]( auto const& n ) {
+    simulate_node( aig, n, expected, sim );
+  } );
+
+  const auto tts = simulate_nodes_parallel( aig, sim, 3u );
+  unordered_node_map<kitty::partial_truth_table, aig_network> node_to_value( aig );
+  simulate_nodes( aig, node_to_value, sim, true, 3u );
+  aig.foreach_gate( [&]( auto const& n ) {
+    CHECK( tts[n] == expected[n] );
+    CHECK( node_to_value[n] == expected[n] );
+  } );
+
+  /* generic simulation with `compute` */
+  klut_network klut;
+  const auto x1 = klut.create_pi();
+  const auto x2 = klut.create_pi();
+  const auto x3 = klut.create_pi();
+  const auto g1 = klut.create_and( x1, x2 );
+  const auto g2 = klut.create_xor( g1, x3 );
+  klut.create_po( g2 );
+  const auto g3 = klut.create_maj( x1, x2, x3 );
+  klut.substitute_node( klut.get_node( g1 ), g3 );
+
+  partial_simulator klut_sim( klut.num_pis(), 9000 );
+  const auto v1 = klut_sim.compute_pi( 0u );
+  const auto v2 = klut_sim.compute_pi( 1u );
+  const auto v3 = klut_sim.compute_pi( 2u );
+  const auto maj = ( v1 & v2 ) | ( v1 & v3 ) | ( v2 & v3 );
+
+  const auto klut_tts = simulate_nodes_parallel( klut, klut_sim, 3u );
+  CHECK( klut_tts[g3] == maj );
+  CHECK( klut_tts[g2] == ( maj ^ v3 ) );
+}
@@ -0,0 +1,128 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/equivalence_checking.hpp>
+#include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/io/binary_aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+#include <fmt/format.h>
+#include <kitty/static_truth_table.hpp>
+#include <lorina/aiger.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace mockturtle;
+
+TEST_CASE( "read binary AIGER from memory", "[binary_aiger_reader]" )
+{
+  /* XOR with 4 AND gates, see write_aiger test */
+  std::string const file{
+      'a', 'i', 'g', ' ', '6', ' ', '2', ' ', '0', ' ', '1', ' ', '4', '\n',
+      '1', '3', '\n',
+      0x02, 0x02,
+      0x01, 0x05,
+      0x03, 0x03,
+      0x01, 0x02,
+      'c'};
+
+  aig_network aig;
+  CHECK( read_binary_aiger( file.data(), file.data() + file.size(), aig ) == lorina::return_code::success );
+
+  CHECK( aig.num_pis() == 2u );
+  CHECK( aig.num_pos() == 1u );
+  CHECK( aig.num_gates() == 4u );
+  CHECK( aig.fanout_size( aig.pi_at( 0 ) ) == 2u );
+  CHECK( simulate<kitty::static_truth_table<2u>>( aig )[0]._bits == 0x6 );
+
+  /* variable indexes are preserved */
+  CHECK( aig.get_node( aig.po_at( 0 ) ) == 6u );
+}
+
+TEST_CASE( "merge trivial and duplicate gates in binary AIGER", "[binary_aiger_reader]" )
+{
+  /* 6 = 2 & 4, 8 = 2 & 4, 10 = 2 & 2, 12 = 8 & 10 */
+  std::string const file{
+      'a', 'i', 'g', ' ', '6', ' ', '2', ' ', '0', ' ', '1', ' ', '4', '\n',
+      '1', '2', '\n',
+      0x02, 0x02,
+      0x04, 0x02,
+      0x08, 0x00,
+      0x02, 0x06};
+
+  soa_aig_network aig;
+  CHECK( read_binary_aiger( file.data(), file.data() + file.size(), aig ) == lorina::return_code::success );
+
+  CHECK( aig.num_gates() == 1u );
+  CHECK( aig.get_node( aig.po_at( 0 ) ) == 3u );
+  CHECK( aig.fanout_size( 3u ) == 1u );
+  CHECK( simulate<kitty::static_truth_table<2u>>( aig )[0]._bits == 0x8 );
+
+  /* structural hashing still works afterwards */
+  CHECK( aig.create_and( aig.make_signal( aig.pi_at( 1 ) ), aig.make_signal( aig.pi_at( 0 ) ) ) == aig.po_at( 0 ) );
+}
+
+TEST_CASE( "read binary AIGER with fanout tracking", "[binary_aiger_reader]" )
+{
+  /* XOR with 4 AND gates, see write_aiger test */
+  std::string const file{
+      'a', 'i', 'g', ' ', '6', ' ', '2', ' ', '0', ' ', '1', ' ', '4', '\n',
+      '1', '3', '\n',
+      0x02, 0x02,
+      0x01, 0x05,
+      0x03, 0x03,
+      0x01, 0x02};
+
+  aig_network aig;
+  aig.enable_fanout_tracking();
+  CHECK( read_binary_aiger( file.data(), file.data() + file.size(), aig ) == lorina::return_code::success );
+  CHECK( aig.has_fanout_tracking() );
+
+  /* substitution finds all parents through the tracked fanouts */
+  auto const a = aig.make_signal( aig.pi_at( 0 ) );
+  auto const b = aig.make_signal( aig.pi_at( 1 ) );
+  aig.substitute_node( 3u, aig.create_and( a, !aig.create_and( a, !b ) ) );
+  CHECK( aig.is_dead( 3u ) );
+
+  std::vector<uint32_t> num_fanouts( aig.size(), 0u );
+  aig.foreach_gate( [&]( auto const& n ) {
+    aig.foreach_fanin( n, [&]( auto const& f ) {
+      CHECK( aig.get_node( f ) != 3u );
+      ++num_fanouts[aig.get_node( f )];
+    } );
+  } );
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( aig._storage->data.fanouts.size( static_cast<uint32_t>( n ) ) == num_fanouts[n] );
+  } );
+}
+
+TEST_CASE( "reject malformed binary AIGER", "[binary_aiger_reader]" )
+{
+  std::string const ascii{"aag 1 1 0 1 0\n2\n2\n"};
+  aig_network aig1;
+  CHECK( read_binary_aiger( ascii.data(), ascii.data() + ascii.size(), aig1 ) == lorina::return_code::parse_error );
+
+  std::string const truncated{'a', 'i', 'g', ' ', '3', ' ', '2', ' ', '0', ' ', '1', ' ', '1', '\n', '6', '\n', 0x02};
+  aig_network aig2;
+  CHECK( read_binary_aiger( truncated.data(), truncated.data() + truncated.size(), aig2 ) == lorina::return_code::parse_error );
+}
+
+TEST_CASE( "read binary AIGER benchmark", "[binary_aiger_reader]" )
+{
+  aig_network aig1, aig2;
+  CHECK( lorina::read_aiger( fmt::format( "{}/c432.aig", BENCHMARKS_PATH ), aiger_reader( aig1 ) ) == lorina::return_code::success );
+  CHECK( read_binary_aiger( fmt::format( "{}/c432.aig", BENCHMARKS_PATH ), aig2 ) == lorina::return_code::success );
+
+  CHECK( aig1.num_pis() == aig2.num_pis() );
+  CHECK( aig1.num_pos() == aig2.num_pos() );
+  CHECK( aig1.num_gates() == aig2.num_gates() );
+
+  const auto result = equivalence_checking( *miter<aig_network>( aig1, aig2 ) );
+  CHECK( result );
+  CHECK( *result );
+
+  aig_network aig3;
+  CHECK( read_binary_aiger( "does-not-exist.aig", aig3 ) == lorina::return_code::parse_error );
+}
@@ -0,0 +1,161 @@
+#include <catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/io/snapshot.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/views/names_view.hpp>
+
+using namespace mockturtle;
+
+template<class Ntk>
+void check_snapshot_round_trip()
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( 4 ), b( 4 );
+  std::generate( a.begin(), a.end(), [&ntk]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&ntk]() { return ntk.create_pi(); } );
+  auto carry = ntk.create_pi();
+  carry_ripple_adder_inplace( ntk, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto f ) { ntk.create_po( f ); } );
+  ntk.create_po( !carry );
+
+  /* a dead node */
+  const auto f = ntk.create_and( a[0], b[1] );
+  ntk.substitute_node( ntk.get_node( f ), a[0] );
+
+  CHECK( write_snapshot( ntk, "snapshot.tmp.snp" ) );
+  const auto loaded = read_snapshot<Ntk>( "snapshot.tmp.snp" );
+  std::remove( "snapshot.tmp.snp" );
+  REQUIRE( loaded );
+  auto ntk2 = *loaded;
+
+  CHECK( ntk2.size() == ntk.size() );
+  CHECK( ntk2.num_pis() == ntk.num_pis() );
+  CHECK( ntk2.num_pos() == ntk.num_pos() );
+  CHECK( ntk2.num_gates() == ntk.num_gates() );
+  CHECK( ntk2._storage->nodes == ntk._storage->nodes );
+  CHECK( ntk2._storage->inputs == ntk._storage->inputs );
+  CHECK( ntk2._storage->outputs == ntk._storage->outputs );
+  CHECK( ntk2._storage->hash.size() == ntk._storage->hash.size() );
+  CHECK( simulate<kitty::static_truth_table<9u>>( ntk2 ) == simulate<kitty::static_truth_table<9u>>( ntk ) );
+
+  /* the structural hash table is usable */
+  const auto size = ntk2.size();
+  ntk2.foreach_gate( [&]( auto const& n ) {
+    if ( ntk2.is_dead( n ) )
+      return;
+    std::vector<typename Ntk::signal> children;
+    ntk2.foreach_fanin( n, [&]( auto const& c ) { children.push_back( c ); } );
+    if constexpr ( Ntk::max_fanin_size == 2 )
+    {
+      if ( ntk2.is_and( n ) )
+        CHECK( ntk2.create_and( children[0], children[1] ) == ntk2.make_signal( n ) );
+    }
+    else
+    {
+      if ( ntk2.is_maj( n ) )
+        CHECK( ntk2.create_maj( children[0], children[1], children[2] ) == ntk2.make_signal( n ) );
+    }
+  } );
+  CHECK( ntk2.size() == size );
+}
+
+TEST_CASE( "snapshots of AIGs, XAGs, MIGs, and XMGs", "[snapshot]" )
+{
+  check_snapshot_round_trip<aig_network>();
+  check_snapshot_round_trip<xag_network>();
+  check_snapshot_round_trip<mig_network>();
+  check_snapshot_round_trip<xmg_network>();
+}
+
+template<class Ntk>
+void check_klut_snapshot_round_trip()
+{
+  Ntk klut;
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+  kitty::dynamic_truth_table tt( 3u );
+  kitty::create_from_hex_string( tt, "96" );
+  const auto f1 = klut.create_node( {a, b, c}, tt );
+  const auto f2 = klut.create_maj( a, b, f1 );
+  const auto f3 = klut.create_and( f1, f2 );
+  klut.create_po( f2 );
+  klut.create_po( f3 );
+
+  CHECK( write_snapshot( klut, "snapshot.tmp.snp" ) );
+  const auto loaded = read_snapshot<Ntk>( "snapshot.tmp.snp" );
+  std::remove( "snapshot.tmp.snp" );
+  REQUIRE( loaded );
+  auto klut2 = *loaded;
+
+  CHECK( klut2.size() == klut.size() );
+  CHECK( klut2.num_pis() == klut.num_pis() );
+  CHECK( klut2.num_pos() == klut.num_pos() );
+  CHECK( klut2.function_cache()->size() == klut.function_cache()->size() );
+  klut.foreach_node( [&]( auto const& n ) {
+    CHECK( klut2.node_function( n ) == klut.node_function( n ) );
+    CHECK( klut2.fanin_size( n ) == klut.fanin_size( n ) );
+    CHECK( klut2.fanout_size( n ) == klut.fanout_size( n ) );
+  } );
+  CHECK( simulate<kitty::static_truth_table<3u>>( klut2 ) == simulate<kitty::static_truth_table<3u>>( klut ) );
+
+  /* existing nodes and functions are found again */
+  const auto size = klut2.size();
+  CHECK( klut2.create_node( {a, b, c}, tt ) == f1 );
+  CHECK( klut2.create_xor( a, b ) != f1 );
+  CHECK( klut2.size() == size + 1 );
+}
+
+TEST_CASE( "snapshots of k-LUT networks", "[snapshot]" )
+{
+  check_klut_snapshot_round_trip<klut_network>();
+  check_klut_snapshot_round_trip<inline_klut_network>();
+}
+
+TEST_CASE( "snapshots with names and fanout tracking", "[snapshot]" )
+{
+  names_view<aig_network> aig;
+  aig.set_network_name( "top" );
+  const auto a = aig.create_pi( "a" );
+  const auto b = aig.create_pi( "b" );
+  const auto f = aig.create_and( a, !b );
+  aig.set_name( !f, "nf" );
+  aig.create_po( f, "y" );
+  aig.enable_fanout_tracking();
+
+  CHECK( write_snapshot( aig, "snapshot.tmp.snp" ) );
+  const auto loaded = read_snapshot<names_view<aig_network>>( "snapshot.tmp.snp" );
+  REQUIRE( loaded );
+  CHECK( loaded->get_network_name() == "top" );
+  CHECK( loaded->get_name( a ) == "a" );
+  CHECK( loaded->get_name( b ) == "b" );
+  CHECK( !loaded->has_name( f ) );
+  CHECK( loaded->get_name( !f ) == "nf" );
+  CHECK( loaded->get_output_name( 0 ) == "y" );
+  CHECK( loaded->has_fanout_tracking() );
+
+  /* wrong network type */
+  CHECK( !read_snapshot<xag_network>( "snapshot.tmp.snp" ) );
+
+  /* corrupted contents */
+  {
+    std::fstream file( "snapshot.tmp.snp", std::fstream::in | std::fstream::out | std::fstream::binary );
+    file.seekp( 60 );
+    file.put( 0x5a );
+  }
+  CHECK( !read_snapshot<names_view<aig_network>>( "snapshot.tmp.snp" ) );
+  std::remove( "snapshot.tmp.snp" );
+
+  CHECK( !read_snapshot<aig_network>( "snapshot.tmp.snp" ) );
+}
@@ -9,6 +9,11 @@
 #include <kitty/operations.hpp>
 #include <kitty/operators.hpp>
 
+#include <limits>
+#include <list>
+#include <random>
+#include <vector>
+
 using namespace mockturtle;
 
 TEST_CASE( "create and use constants in an AIG", "[aig]" )
@@ -932,3 +937,194 @@ TEST_CASE( "substitute multiple nodes", "[aig]" )
     }
   });
 }
+
+TEST_CASE( "substitute nodes with fanout tracking", "[aig]" )
+{
+  using node = aig_network::node;
+  using signal = aig_network::signal;
+
+  /* builds the same random AIG on each call */
+  auto const build = []( aig_network& aig ) {
+    std::mt19937 rng( 42u );
+    std::vector<signal> fs;
+    for ( auto i = 0u; i < 16u; ++i )
+    {
+      fs.emplace_back( aig.create_pi() );
+    }
+    for ( auto i = 0u; i < 500u; ++i )
+    {
+      auto const a = fs[rng() % fs.size()] ^ ( rng() % 2u == 0u );
+      auto const b = fs[rng() % fs.size()] ^ ( rng() % 2u == 0u );
+      fs.emplace_back( aig.create_and( a, b ) );
+    }
+    for ( auto i = 0u; i < 16u; ++i )
+    {
+      aig.create_po( fs[fs.size() - 1u - i] );
+    }
+  };
+
+  /* substitutes random gates by random older signals */
+  auto const substitute = []( aig_network& aig ) {
+    std::mt19937 rng( 7u );
+    for ( auto i = 0u; i < 100u; ++i )
+    {
+      auto const n = 17u + rng() % ( aig.size() - 17u );
+      auto const m = 1u + rng() % ( n - 1u );
+      if ( aig.is_dead( n ) || aig.is_dead( m ) )
+      {
+        continue;
+      }
+      if ( i % 2u == 0u )
+      {
+        aig.substitute_node( n, aig.make_signal( m ) ^ ( rng() % 2u == 0u ) );
+      }
+      else
+      {
+        aig.substitute_nodes( std::list<std::pair<node, signal>>{{n, aig.make_signal( m )}} );
+      }
+    }
+  };
+
+  aig_network aig1, aig2;
+  build( aig1 );
+  build( aig2 );
+  aig2.enable_fanout_tracking();
+  CHECK( !aig1.has_fanout_tracking() );
+  CHECK( aig2.has_fanout_tracking() );
+
+  substitute( aig1 );
+  substitute( aig2 );
+
+  /* both networks have the same structure */
+  CHECK( aig1.size() == aig2.size() );
+  aig1.foreach_node( [&]( auto const& n ) {
+    CHECK( aig1.is_dead( n ) == aig2.is_dead( n ) );
+    if ( aig1.is_dead( n ) || !aig1.is_and( n ) )
+    {
+      return;
+    }
+    CHECK( aig1.fanout_size( n ) == aig2.fanout_size( n ) );
+    aig1.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      CHECK( f == aig2._storage->nodes[n].children[i] );
+    } );
+  } );
+  aig1.foreach_po( [&]( auto const& f, auto i ) {
+    CHECK( f == aig2.po_at( i ) );
+  } );
+
+  /* tracked fanouts match the gates */
+  std::vector<uint32_t> num_fanouts( aig2.size(), 0u );
+  aig2.foreach_gate( [&]( auto const& n ) {
+    aig2.foreach_fanin( n, [&]( auto const& f ) {
+      ++num_fanouts[aig2.get_node( f )];
+    } );
+  } );
+  aig2.foreach_node( [&]( auto const& n ) {
+    CHECK( aig2._storage->data.fanouts.size( n ) == num_fanouts[n] );
+  } );
+}
+
+TEST_CASE( "compact an AIG with dead nodes", "[aig]" )
+{
+  aig_network aig;
+  auto const x1 = aig.create_pi();
+  auto const x2 = aig.create_pi();
+  auto const x3 = aig.create_pi();
+  auto const n4 = aig.create_and( x1, x2 );
+  auto const n5 = aig.create_and( n4, x3 );
+  auto const n6 = aig.create_and( !n4, !x3 );
+  auto const n7 = aig.create_or( n5, n6 );
+  aig.create_po( n7 );
+  aig.create_po( !n5 );
+
+  /* n8 is created after the fanouts of n4, which breaks the topological
+     index order until the network is compacted */
+  auto const n8 = aig.create_and( x2, !x1 );
+  aig.substitute_node( aig.get_node( n4 ), aig.create_or( n8, aig.create_and( x1, !x2 ) ) );
+  auto const num_gates = aig.num_gates();
+  CHECK( aig.size() > 1u + 3u + num_gates );
+
+  auto const old_to_new = aig.compact();
+  CHECK( old_to_new.size() > aig.size() );
+  CHECK( aig.size() == 1u + 3u + num_gates );
+  CHECK( aig.num_gates() == num_gates );
+  CHECK( old_to_new[aig.get_node( n4 )] == std::numeric_limits<aig_network::node>::max() );
+  CHECK( old_to_new[aig.get_node( x3 )] == 3u );
+
+  aig.foreach_pi( [&]( auto const& n, auto i ) {
+    CHECK( n == i + 1u );
+  } );
+  aig.foreach_gate( [&]( auto const& n ) {
+    CHECK( !aig.is_dead( n ) );
+    aig.foreach_fanin( n, [&]( auto const& f ) {
+      CHECK( aig.get_node( f ) < n );
+    } );
+  } );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig )[0]._bits == 0x69u );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig )[1]._bits == 0x9fu );
+
+  /* structural hashing still finds the existing gates */
+  auto const size = aig.size();
+  aig.create_and( x3, aig.make_signal( old_to_new[aig.get_node( n8 )] ) );
+  CHECK( aig.size() == size + 1u );
+  aig.create_and( x3, aig.make_signal( old_to_new[aig.get_node( n8 )] ) );
+  CHECK( aig.size() == size + 1u );
+  aig.foreach_gate( [&]( auto const& n ) {
+    std::vector<aig_network::signal> fanins;
+    aig.foreach_fanin( n, [&]( auto const& f ) {
+      fanins.push_back( f );
+    } );
+    CHECK( aig.get_node( aig.create_and( fanins[0], fanins[1] ) ) == n );
+  } );
+  CHECK( aig.size() == size + 1u );
+}
+
+TEST_CASE( "AIG with structure-of-arrays storage", "[aig]" )
+{
+  CHECK( is_network_type_v<soa_aig_network> );
+  CHECK( sizeof( aig_soa_storage::node_type ) == 8u );
+
+  soa_aig_network aig;
+  const auto x1 = aig.create_pi();
+  const auto x2 = aig.create_pi();
+  const auto x3 = aig.create_pi();
+
+  const auto f1 = aig.create_maj( x1, x2, x3 );
+  const auto f2 = aig.create_ite( x1, x2, x3 );
+  CHECK( aig.create_and( x1, x2 ) == aig.create_and( x2, x1 ) );
+
+  aig.create_po( f1 );
+  aig.create_po( f2 );
+
+  CHECK( aig.size() == 10u );
+  CHECK( aig.num_gates() == 6u );
+  CHECK( aig.fanout_size( aig.get_node( x1 ) ) == 3u );
+
+  auto result = simulate<kitty::dynamic_truth_table>( aig, default_simulator<kitty::dynamic_truth_table>( 3 ) );
+  CHECK( result[0]._bits[0] == 0xe8u );
+  CHECK( result[1]._bits[0] == 0xd8u );
+
+  aig.clear_values();
+  aig.clear_visited();
+  aig.foreach_node( [&]( auto n ) {
+    CHECK( aig.value( n ) == 0u );
+    CHECK( aig.visited( n ) == 0u );
+    aig.set_value( n, static_cast<uint32_t>( n ) );
+    aig.set_visited( n, aig.trav_id() );
+    CHECK( aig.incr_value( n ) == n );
+    CHECK( aig.value( n ) == n + 1 );
+  } );
+
+  /* substitute x1 by constant 1 */
+  aig.substitute_node( aig.get_node( x1 ), aig.get_constant( true ) );
+  const auto aig2 = cleanup_dangling<soa_aig_network, aig_network>( aig );
+  CHECK( aig2.num_gates() == 1u );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig2 )[0]._bits == 0xfcu );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig2 )[1]._bits == 0xccu );
+
+  /* remove the dead nodes in place */
+  aig.compact();
+  CHECK( aig.size() == 1u + 3u + aig.num_gates() );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig )[0]._bits == 0xfcu );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig )[1]._bits == 0xccu );
+}
@@ -573,3 +573,59 @@ TEST_CASE( "visited values in k-LUT networks", "[klut]" )
     CHECK( klut.visited( n ) == 0 );
   } );
 }
+
+TEST_CASE( "k-LUT network with inline fan-ins", "[klut]" )
+{
+  CHECK( is_network_type_v<inline_klut_network> );
+  CHECK( sizeof( klut_inline_storage::node_type ) == 48u );
+
+  inline_klut_network klut;
+
+  std::vector<inline_klut_network::signal> pis;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    pis.emplace_back( klut.create_pi() );
+  }
+
+  kitty::dynamic_truth_table tt_maj( 3u ), tt_xor( 3u ), tt_and8( 8u );
+  kitty::create_from_hex_string( tt_maj, "e8" );
+  kitty::create_from_hex_string( tt_xor, "96" );
+  kitty::set_bit( tt_and8, 255u );
+
+  const auto _maj = klut.create_node( {pis[0], pis[1], pis[2]}, tt_maj );
+  const auto _xor = klut.create_node( {pis[0], pis[1], pis[2]}, tt_xor );
+  CHECK( klut.create_node( {pis[0], pis[1], pis[2]}, tt_maj ) == _maj );
+
+  /* more fan-ins than fit into the node */
+  const auto _and8 = klut.create_node( pis, tt_and8 );
+  CHECK( klut.fanin_size( _and8 ) == 8u );
+  CHECK( klut.create_node( pis, tt_and8 ) == _and8 );
+
+  klut.create_po( _maj );
+  klut.create_po( _xor );
+  klut.create_po( _and8 );
+
+  CHECK( klut.size() == 13u );
+  CHECK( klut.num_gates() == 3u );
+  CHECK( klut.fanout_size( pis[0] ) == 3u );
+
+  std::vector<inline_klut_network::node> fanins;
+  klut.foreach_fanin( _and8, [&]( auto const& f ) {
+    fanins.emplace_back( klut.get_node( f ) );
+  } );
+  CHECK( fanins == std::vector<inline_klut_network::node>( pis.begin(), pis.end() ) );
+
+  /* copies of the network keep the fan-ins */
+  inline_klut_network copy{std::make_shared<klut_inline_storage>( *klut._storage )};
+  CHECK( copy.fanin_size( _and8 ) == 8u );
+  CHECK( copy.fanin_size( _xor ) == 3u );
+
+  /* substitute a PI by the output of the majority gate */
+  klut.substitute_node( pis[7], _maj );
+  fanins.clear();
+  klut.foreach_fanin( _and8, [&]( auto const& f ) {
+    fanins.emplace_back( klut.get_node( f ) );
+  } );
+  CHECK( fanins.back() == _maj );
+  CHECK( copy.fanin_size( _and8 ) == 8u );
+}
@@ -687,3 +687,46 @@ TEST_CASE( "node substitution in MIGs", "[mig]" )
     }
   } );
 }
+
+TEST_CASE( "node substitution in MIGs with fanout tracking", "[mig]" )
+{
+  mig_network mig;
+  mig.enable_fanout_tracking();
+  CHECK( mig.has_fanout_tracking() );
+
+  const auto a = mig.create_pi();
+  const auto b = mig.create_pi();
+  const auto c = mig.create_pi();
+  const auto f1 = mig.create_and( a, b );
+  const auto f2 = mig.create_maj( f1, b, c );
+  const auto f3 = mig.create_or( f1, c );
+  mig.create_po( f2 );
+  mig.create_po( f3 );
+
+  CHECK( mig._storage->data.fanouts.size( mig.get_node( f1 ) ) == 2u );
+  CHECK( mig._storage->data.fanouts.size( mig.get_node( c ) ) == 2u );
+
+  /* f1 = a is replaced in f2 and f3 */
+  mig.substitute_node( mig.get_node( f1 ), a );
+
+  CHECK( mig.is_dead( mig.get_node( f1 ) ) );
+  CHECK( mig._storage->data.fanouts.size( mig.get_node( f1 ) ) == 0u );
+  CHECK( mig._storage->data.fanouts.size( mig.get_node( a ) ) == 2u );
+  CHECK( mig._storage->data.fanouts.size( mig.get_node( b ) ) == 1u );
+  mig.foreach_po( [&]( auto const& f ) {
+    mig.foreach_fanin( mig.get_node( f ), [&]( auto const& s ) {
+      CHECK( mig.get_node( s ) != mig.get_node( f1 ) );
+    } );
+  } );
+
+  mig.substitute_node_of_parents( {mig.get_node( f2 )}, mig.get_node( a ), !a );
+  CHECK( mig._storage->data.fanouts.size( mig.get_node( a ) ) == 2u );
+
+  /* compaction keeps the fanouts */
+  auto const old_to_new = mig.compact();
+  CHECK( mig.size() == 1u + 3u + mig.num_gates() );
+  CHECK( mig._storage->data.fanouts.size( static_cast<uint32_t>( old_to_new[mig.get_node( a )] ) ) == 2u );
+
+  mig.disable_fanout_tracking();
+  CHECK( !mig.has_fanout_tracking() );
+}
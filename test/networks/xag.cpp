@@ -729,3 +729,70 @@ TEST_CASE( "create nary functions in XAGs", "[xag]" )
   kitty::create_parity( copy );
   CHECK( result[2] == copy );
 }
+
+TEST_CASE( "XAG with structure-of-arrays storage", "[xag]" )
+{
+  CHECK( is_network_type_v<soa_xag_network> );
+
+  soa_xag_network xag;
+  const auto x1 = xag.create_pi();
+  const auto x2 = xag.create_pi();
+  const auto x3 = xag.create_pi();
+
+  const auto f1 = xag.create_maj( x1, x2, x3 );
+  const auto f2 = xag.create_xor( x1, xag.create_and( x2, x3 ) );
+  xag.create_po( f1 );
+  xag.create_po( f2 );
+
+  CHECK( xag.num_gates() == 6u );
+  CHECK( xag.is_xor( xag.get_node( f2 ) ) );
+  CHECK( xag.is_and( xag.get_node( xag.create_and( x2, x3 ) ) ) );
+
+  auto result = simulate<kitty::static_truth_table<3u>>( xag );
+  CHECK( result[0]._bits == 0xe8u );
+  CHECK( result[1]._bits == 0x6au );
+
+  xag.substitute_node( xag.get_node( x3 ), xag.get_constant( false ) );
+  result = simulate<kitty::static_truth_table<3u>>( xag );
+  CHECK( result[0]._bits == 0x88u );
+  CHECK( result[1]._bits == 0xaau );
+}
+
+TEST_CASE( "compact an XAG with dead nodes", "[xag]" )
+{
+  xag_network xag;
+  auto const x1 = xag.create_pi();
+  auto const x2 = xag.create_pi();
+  auto const x3 = xag.create_pi();
+  auto const n4 = xag.create_and( x1, x2 );
+  auto const n5 = xag.create_and( n4, x3 );
+  auto const n6 = xag.create_and( x2, x3 );
+  auto const n7 = xag.create_or( x1, x3 );
+  auto const n8 = xag.create_xor( n7, n6 );
+  xag.create_po( n5 );
+  xag.create_po( n8 );
+
+  /* after the substitution, n7 is reached before n6 in topological order,
+     which swaps the relative order of the fan-ins of the XOR gate n8 */
+  xag.substitute_node( xag.get_node( n4 ), n7 );
+  auto const num_gates = xag.num_gates();
+
+  auto const old_to_new = xag.compact();
+  CHECK( xag.size() == 1u + 3u + num_gates );
+  CHECK( old_to_new[xag.get_node( n7 )] < old_to_new[xag.get_node( n6 )] );
+  CHECK( xag.is_xor( old_to_new[xag.get_node( n8 )] ) );
+  CHECK( simulate<kitty::static_truth_table<3u>>( xag )[0]._bits == 0xf0u );
+  CHECK( simulate<kitty::static_truth_table<3u>>( xag )[1]._bits == 0x3au );
+
+  /* structural hashing finds the existing gates */
+  auto const size = xag.size();
+  xag.foreach_gate( [&]( auto const& n ) {
+    std::vector<xag_network::signal> fanins;
+    xag.foreach_fanin( n, [&]( auto const& f ) {
+      fanins.push_back( f );
+    } );
+    auto const f = xag.is_xor( n ) ? xag.create_xor( fanins[0], fanins[1] ) : xag.create_and( fanins[0], fanins[1] );
+    CHECK( xag.get_node( f ) == n );
+  } );
+  CHECK( xag.size() == size );
+}
@@ -1,5 +1,7 @@
 #include <catch.hpp>
 
+#include <vector>
+
 #include <kitty/algorithm.hpp>
 #include <kitty/bit_operations.hpp>
 #include <kitty/constructors.hpp>
@@ -791,3 +793,42 @@ TEST_CASE( "create nary functions in XMGs", "[xmg]" )
   kitty::create_parity( copy );
   CHECK( result[2] == copy );
 }
+
+TEST_CASE( "compact an XMG with dead nodes", "[xmg]" )
+{
+  xmg_network xmg;
+  auto const x1 = xmg.create_pi();
+  auto const x2 = xmg.create_pi();
+  auto const x3 = xmg.create_pi();
+  auto const n4 = xmg.create_and( x1, x2 );
+  auto const n5 = xmg.create_and( n4, x3 );
+  auto const n6 = xmg.create_and( x2, x3 );
+  auto const n7 = xmg.create_or( x1, x3 );
+  auto const n8 = xmg.create_xor3( n7, n6, x1 );
+  xmg.create_po( n5 );
+  xmg.create_po( n8 );
+
+  /* after the substitution, n7 is reached before n6 in topological order,
+     which swaps the relative order of the fan-ins of the XOR3 gate n8 */
+  xmg.substitute_node( xmg.get_node( n4 ), n7 );
+  auto const num_gates = xmg.num_gates();
+
+  auto const old_to_new = xmg.compact();
+  CHECK( xmg.size() == 1u + 3u + num_gates );
+  CHECK( old_to_new[xmg.get_node( n7 )] < old_to_new[xmg.get_node( n6 )] );
+  CHECK( xmg.is_xor3( old_to_new[xmg.get_node( n8 )] ) );
+  CHECK( simulate<kitty::static_truth_table<3u>>( xmg )[0]._bits == 0xf0u );
+  CHECK( simulate<kitty::static_truth_table<3u>>( xmg )[1]._bits == 0x90u );
+
+  /* structural hashing finds the existing gates */
+  auto const size = xmg.size();
+  xmg.foreach_gate( [&]( auto const& n ) {
+    std::vector<xmg_network::signal> fanins;
+    xmg.foreach_fanin( n, [&]( auto const& f ) {
+      fanins.push_back( f );
+    } );
+    auto const f = xmg.is_xor3( n ) ? xmg.create_xor3( fanins[0], fanins[1], fanins[2] ) : xmg.create_maj( fanins[0], fanins[1], fanins[2] );
+    CHECK( xmg.get_node( f ) == n );
+  } );
+  CHECK( xmg.size() == size );
+}
@@ -0,0 +1,25 @@
+#include <catch.hpp>
+
+#include <kitty/npn.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/utils/npn4_table.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "NPN4 table agrees with exact NPN canonization", "[npn4_table]" )
+{
+  auto const& npn4 = npn4_table::get();
+  CHECK( &npn4 == &npn4_table::get() );
+  CHECK( npn4.representatives().size() == 222u );
+
+  kitty::static_truth_table<4u> tt;
+  do
+  {
+    const auto config = kitty::exact_npn_canonization( tt );
+    CHECK( npn4.canonization( tt ) == config );
+    CHECK( npn4.representative( tt ) == std::get<0>( config ) );
+    CHECK( npn4.representatives()[npn4.class_index( tt )] == std::get<0>( config ) );
+    kitty::next_inplace( tt );
+  } while ( !kitty::is_const0( tt ) );
+}
@@ -159,4 +159,150 @@ TEST_CASE( "Complete library generation", "[tech_library]" )
     kitty::exact_np_enumeration( tt, test_enumeration );
   }
   
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Library generation with supergates", "[tech_library]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( simple_test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+
+  CHECK( result == lorina::return_code::success );
+
+  tech_library_params ps;
+  ps.supergate_levels = 2u;
+  ps.supergate_inputs = 3u;
+  tech_library<3> lib( gates, ps );
+
+  CHECK( lib.num_supergates() == 1u );
+
+  /* nand2( nand2( a, b ), c ) */
+  kitty::static_truth_table<3> tt;
+  kitty::create_from_expression( tt, "!(!(ab)c)" );
+
+  auto const supergates = lib.get_supergates( tt );
+  CHECK( supergates != nullptr );
+  CHECK( supergates->size() == 1u );
+
+  auto const& sg = ( *supergates )[0];
+  CHECK( sg.root->name == "nand2" );
+  CHECK( sg.tree->is_super() );
+  CHECK( sg.area == 4.0f );
+  CHECK( sg.worstDelay == 2.0f );
+  CHECK( sg.tdelay == std::array<float, 3>{ 2.0f, 2.0f, 1.0f } );
+  CHECK( sg.polarity == 0u );
+
+  /* one fanin is a leaf, the other one the inner nand2 */
+  auto const inner = std::min( sg.tree->fanin[0], sg.tree->fanin[1] );
+  CHECK( std::max( sg.tree->fanin[0], sg.tree->fanin[1] ) == composed_gate<3>::leaf );
+  REQUIRE( inner != composed_gate<3>::leaf );
+  CHECK( lib.get_composed_gates()[inner].root->name == "nand2" );
+
+  /* the single gates are unchanged */
+  kitty::create_from_expression( tt, "!(ab)" );
+  CHECK( lib.get_supergates( tt )->size() == 1u );
+  CHECK( ( *lib.get_supergates( tt ) )[0].root->name == "nand2" );
+}
+
+TEST_CASE( "Library generation with many supergates", "[tech_library]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+
+  CHECK( result == lorina::return_code::success );
+
+  tech_library_params ps;
+  ps.supergate_levels = 2u;
+  ps.supergate_inputs = 5u;
+  ps.max_supergates = 200u;
+  tech_library<5> lib( gates, ps );
+
+  CHECK( lib.num_supergates() == 200u );
+
+  /* the matches of each function are sorted by area and contain neither two
+     configurations that are equal up to symmetries nor dominated supergates */
+  uint32_t num_unsorted{ 0u }, num_redundant{ 0u };
+  kitty::static_truth_table<5> tt;
+  do
+  {
+    auto const list = lib.get_supergates( tt );
+    for ( auto i = 0u; list != nullptr && i < list->size(); ++i )
+    {
+      for ( auto j = i + 1u; j < list->size(); ++j )
+      {
+        auto const& sg1 = ( *list )[i];
+        auto const& sg2 = ( *list )[j];
+        num_unsorted += sg1.area > sg2.area ? 1u : 0u;
+
+        bool redundant = sg1.tree == sg2.tree && sg1.polarity == sg2.polarity && sg1.tdelay == sg2.tdelay && sg1.tdelay_loaded == sg2.tdelay_loaded && sg1.input_load == sg2.input_load;
+        bool dominated = sg2.tree->is_super() && sg1.area <= sg2.area && sg1.fanout_delay <= sg2.fanout_delay;
+        for ( auto k = 0u; k < 5u; ++k )
+        {
+          dominated = dominated && sg1.tdelay[k] <= sg2.tdelay[k] && sg1.tdelay_loaded[k] <= sg2.tdelay_loaded[k] && sg1.input_load[k] <= sg2.input_load[k];
+        }
+        num_redundant += ( redundant || dominated ) ? 1u : 0u;
+      }
+    }
+    kitty::next_inplace( tt );
+  } while ( !kitty::is_const0( tt ) );
+
+  CHECK( num_unsorted == 0u );
+  CHECK( num_redundant == 0u );
+}
+
+TEST_CASE( "Library cache", "[tech_library]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+
+  CHECK( result == lorina::return_code::success );
+
+  std::string const filename = "tech_library_cache.bin";
+  std::remove( filename.c_str() );
+
+  tech_library_params ps;
+  ps.supergate_levels = 2u;
+  ps.supergate_inputs = 4u;
+  ps.cache_filename = filename;
+  tech_library<4> lib1( gates, ps );
+  tech_library<4> lib2( gates, ps );
+
+  CHECK( lib1.num_supergates() > 0u );
+  CHECK( lib1.num_supergates() == lib2.num_supergates() );
+
+  kitty::static_truth_table<4> tt;
+  do
+  {
+    auto const list1 = lib1.get_supergates( tt );
+    auto const list2 = lib2.get_supergates( tt );
+    CHECK( ( list1 == nullptr ) == ( list2 == nullptr ) );
+    if ( list1 != nullptr && list2 != nullptr )
+    {
+      CHECK( list1->size() == list2->size() );
+      for ( auto i = 0u; i < std::min( list1->size(), list2->size() ); ++i )
+      {
+        auto const& sg1 = ( *list1 )[i];
+        auto const& sg2 = ( *list2 )[i];
+        CHECK( sg1.root->id == sg2.root->id );
+        CHECK( sg1.tree->function == sg2.tree->function );
+        CHECK( sg1.area == sg2.area );
+        CHECK( sg1.tdelay == sg2.tdelay );
+        CHECK( sg1.permutation == sg2.permutation );
+        CHECK( sg1.polarity == sg2.polarity );
+      }
+    }
+    kitty::next_inplace( tt );
+  } while ( !kitty::is_const0( tt ) );
+
+  /* a library generated with other parameters is not loaded */
+  ps.supergate_levels = 1u;
+  tech_library<4> lib3( gates, ps );
+  CHECK( lib3.num_supergates() == 0u );
+
+  std::remove( filename.c_str() );
+}
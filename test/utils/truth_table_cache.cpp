@@ -1,8 +1,13 @@
 #include <catch.hpp>
 
+#include <set>
+#include <thread>
+#include <vector>
+
 #include <mockturtle/utils/truth_table_cache.hpp>
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
 
 using namespace mockturtle;
 
@@ -45,3 +50,90 @@ TEST_CASE( "working with a truth table cache", "[truth_table_cache]" )
   CHECK( cache[8] == f_maj );
   CHECK( cache[9] == ~f_maj );
 }
+
+TEST_CASE( "truth table cache with many entries of different sizes", "[truth_table_cache]" )
+{
+  truth_table_cache<kitty::dynamic_truth_table> cache( 10u );
+
+  std::vector<kitty::dynamic_truth_table> tts;
+  std::vector<uint32_t> literals;
+  for ( auto i = 0u; i < 5000u; ++i )
+  {
+    kitty::dynamic_truth_table tt( i % 9u );
+    kitty::create_random( tt, i );
+    tts.push_back( tt );
+    literals.push_back( cache.insert( tt ) );
+  }
+
+  for ( auto i = 0u; i < tts.size(); ++i )
+  {
+    CHECK( cache[literals[i]] == tts[i] );
+    CHECK( cache.insert( tts[i] ) == literals[i] );
+    CHECK( cache.insert( ~tts[i] ) == ( literals[i] ^ 1 ) );
+  }
+
+  const auto copy = cache;
+  CHECK( copy.size() == cache.size() );
+  for ( auto i = 0u; i < tts.size(); ++i )
+  {
+    CHECK( copy[literals[i]] == tts[i] );
+  }
+}
+
+TEST_CASE( "truth table cache with static truth tables", "[truth_table_cache]" )
+{
+  truth_table_cache<kitty::static_truth_table<3u>> cache;
+
+  for ( auto i = 0u; i < 256u; ++i )
+  {
+    kitty::static_truth_table<3u> tt;
+    kitty::create_from_words( tt, &i, &i + 1 );
+    const auto lit = cache.insert( tt );
+    CHECK( ( lit & 1 ) == ( i & 1 ) );
+    CHECK( cache[lit] == tt );
+    CHECK( cache[lit ^ 1] == ~tt );
+  }
+  CHECK( cache.size() == 128u );
+}
+
+TEST_CASE( "concurrent inserts into a truth table cache", "[truth_table_cache]" )
+{
+  truth_table_cache<kitty::dynamic_truth_table> cache;
+
+  std::vector<kitty::dynamic_truth_table> tts;
+  for ( auto i = 0u; i < 4000u; ++i )
+  {
+    kitty::dynamic_truth_table tt( 4u + i % 4u );
+    kitty::create_random( tt, i % 1000u );
+    tts.push_back( tt );
+  }
+
+  std::vector<std::vector<uint32_t>> literals( 4u, std::vector<uint32_t>( tts.size() ) );
+  std::vector<std::thread> threads;
+  for ( auto t = 0u; t < 4u; ++t )
+  {
+    threads.emplace_back( [&, t]() {
+      for ( auto i = 0u; i < tts.size(); ++i )
+      {
+        const auto j = ( i + t * 1000u ) % tts.size();
+        literals[t][j] = cache.insert( tts[j] );
+      }
+    } );
+  }
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+
+  std::set<uint32_t> indexes;
+  for ( auto i = 0u; i < tts.size(); ++i )
+  {
+    for ( auto t = 1u; t < 4u; ++t )
+    {
+      CHECK( literals[t][i] == literals[0][i] );
+    }
+    CHECK( cache[literals[0][i]] == tts[i] );
+    indexes.insert( literals[0][i] >> 1 );
+  }
+  CHECK( indexes.size() == cache.size() );
+}
@@ -0,0 +1,79 @@
+#include <catch.hpp>
+
+#include <sstream>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <lorina/genlib.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/views/binding_view.hpp>
+
+using namespace mockturtle;
+
+std::string const binding_test_library = "GATE   inv1    1 O=!a;     PIN * INV 1 999 0.9 0.3 0.9 0.3\n"
+                                         "GATE   inv2    2 O=!a;     PIN * INV 2 999 1.0 0.1 1.0 0.1\n"
+                                         "GATE   nand2   2 O=!(ab);  PIN * INV 1 999 1.0 0.2 1.0 0.2\n"
+                                         "GATE   zero    0 O=0;\n"
+                                         "GATE   one     0 O=1;";
+
+TEST_CASE( "Create binding view", "[binding_view]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( binding_test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  binding_view<klut_network> ntk( gates );
+
+  kitty::dynamic_truth_table nand_func( 2u );
+  kitty::create_from_hex_string( nand_func, "7" );
+
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const c = ntk.create_pi();
+  auto const n1 = ntk.create_node( { a, b }, nand_func );
+  auto const n2 = ntk.create_node( { n1, c }, nand_func );
+  auto const n3 = ntk.create_not( n1 );
+  ntk.create_po( n2 );
+  ntk.create_po( n3 );
+
+  CHECK( !ntk.has_binding( ntk.get_node( n1 ) ) );
+  CHECK( ntk.get_binding_index( ntk.get_node( n1 ) ) == binding_view<klut_network>::unbound );
+
+  ntk.add_binding( ntk.get_node( n1 ), 2u );
+  ntk.add_binding( ntk.get_node( n2 ), 2u );
+  ntk.add_binding( ntk.get_node( n3 ), 0u );
+
+  CHECK( ntk.has_binding( ntk.get_node( n1 ) ) );
+  CHECK( !ntk.has_binding( ntk.get_node( a ) ) );
+  CHECK( ntk.get_binding( ntk.get_node( n1 ) ).name == "nand2" );
+  CHECK( ntk.get_binding( ntk.get_node( n3 ) ).name == "inv1" );
+
+  const double eps{ 0.005 };
+
+  CHECK( ntk.compute_area() > 5.0 - eps );
+  CHECK( ntk.compute_area() < 5.0 + eps );
+  CHECK( ntk.compute_worst_delay() > 2.0 - eps );
+  CHECK( ntk.compute_worst_delay() < 2.0 + eps );
+
+  /* n1 drives two pins with load 1 */
+  CHECK( ntk.compute_worst_delay( true ) > 2.4 - eps );
+  CHECK( ntk.compute_worst_delay( true ) < 2.4 + eps );
+  CHECK( ntk.compute_worst_delay( true, 1.0 ) > 2.6 - eps );
+  CHECK( ntk.compute_worst_delay( true, 1.0 ) < 2.6 + eps );
+
+  /* copies share the bindings */
+  auto copy = ntk;
+  copy.add_binding( copy.get_node( n3 ), 1u );
+  CHECK( ntk.get_binding( ntk.get_node( n3 ) ).name == "inv2" );
+  CHECK( ntk.compute_area() > 6.0 - eps );
+  CHECK( ntk.compute_area() < 6.0 + eps );
+
+  ntk.remove_binding( ntk.get_node( n3 ) );
+  CHECK( !ntk.has_binding( ntk.get_node( n3 ) ) );
+  CHECK( ntk.compute_area() > 4.0 - eps );
+  CHECK( ntk.compute_area() < 4.0 + eps );
+}
@@ -238,3 +238,19 @@ TEST_CASE( "compute levels during node construction after move assignment", "[de
 
   CHECK( dxag.depth() == 3u );
 }
+
+TEST_CASE( "compute depth of a very deep AIG", "[depth_view]" )
+{
+  aig_network aig;
+  auto f = aig.create_pi();
+  for ( auto i = 0u; i < 1000000u; ++i )
+  {
+    f = aig.create_and( f, aig.create_pi() );
+  }
+  aig.create_po( f );
+
+  depth_view depth_aig{aig};
+  CHECK( depth_aig.depth() == 1000000u );
+  CHECK( depth_aig.is_on_critical_path( aig.get_node( f ) ) );
+  CHECK( depth_aig.is_on_critical_path( 1u ) );
+}
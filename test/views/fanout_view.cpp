@@ -1,6 +1,9 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <random>
 #include <set>
+#include <vector>
 
 #include <mockturtle/traits.hpp>
 #include <mockturtle/networks/aig.hpp>
@@ -199,3 +202,56 @@ TEST_CASE( "compute fanouts during node construction after move assignment", "[f
     CHECK( fanouts.size() + ( xag.get_node( f ) == n ) == xag.fanout_size( n ) );
   } );
 }
+
+TEST_CASE( "maintain fanouts under many network updates", "[fanout_view]" )
+{
+  fanout_view<aig_network> faig;
+
+  std::vector<aig_network::signal> fs;
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    fs.push_back( faig.create_pi() );
+  }
+
+  std::mt19937 rng( 1u );
+  for ( auto i = 0u; i < 5000u; ++i )
+  {
+    auto const a = fs[rng() % fs.size()];
+    auto const b = fs[rng() % fs.size()];
+    fs.push_back( faig.create_and( a ^ ( rng() & 1 ), b ) );
+  }
+  for ( auto i = fs.size() - 100u; i < fs.size(); ++i )
+  {
+    faig.create_po( fs[i] );
+  }
+
+  /* replace some gates by PIs */
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    auto const n = faig.get_node( fs[16u + rng() % 5000u] );
+    if ( !faig.is_dead( n ) && !faig.is_pi( n ) )
+    {
+      faig.substitute_node( n, fs[rng() % 16u] );
+    }
+  }
+
+  fanout_view<aig_network> fresh{ static_cast<aig_network const&>( faig ) };
+  faig.foreach_node( [&]( auto const& n ) {
+    std::vector<aig_network::node> fanouts1, fanouts2;
+    faig.foreach_fanout( n, [&]( auto const& fo ) {
+      if ( !faig.is_dead( fo ) )
+      {
+        fanouts1.push_back( fo );
+      }
+    } );
+    fresh.foreach_fanout( n, [&]( auto const& fo ) {
+      if ( !fresh.is_dead( fo ) )
+      {
+        fanouts2.push_back( fo );
+      }
+    } );
+    std::sort( fanouts1.begin(), fanouts1.end() );
+    std::sort( fanouts2.begin(), fanouts2.end() );
+    CHECK( fanouts1 == fanouts2 );
+  } );
+}
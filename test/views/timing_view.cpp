@@ -0,0 +1,162 @@
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/traits.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+#include <mockturtle/views/timing_view.hpp>
+
+using namespace mockturtle;
+
+template<class Ntk>
+void check_timing_from_scratch( timing_view<Ntk> const& ntk )
+{
+  /* the copy recomputes all values */
+  timing_view<Ntk> const ref{ntk};
+  CHECK( ntk.depth() == ref.depth() );
+  ntk.foreach_node( [&]( auto const& n ) {
+    CHECK( ntk.level( n ) == ref.level( n ) );
+    CHECK( ntk.required( n ) == ref.required( n ) );
+    CHECK( ntk.is_on_critical_path( n ) == ref.is_on_critical_path( n ) );
+  } );
+}
+
+TEST_CASE( "compute arrival and required times for AIG", "[timing_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_nand( a, b );
+  const auto f2 = aig.create_nand( a, f1 );
+  const auto f3 = aig.create_nand( b, f1 );
+  const auto f4 = aig.create_nand( f2, f3 );
+  const auto f5 = aig.create_and( c, b );
+  aig.create_po( f4 );
+  aig.create_po( f5 );
+
+  fanout_view fanout_aig{aig};
+  timing_view timing_aig{fanout_aig};
+  depth_view depth_aig{aig};
+
+  CHECK( has_depth_v<timing_view<fanout_view<aig_network>>> );
+  CHECK( has_level_v<timing_view<fanout_view<aig_network>>> );
+
+  CHECK( timing_aig.depth() == 3u );
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( timing_aig.level( n ) == depth_aig.level( n ) );
+    CHECK( timing_aig.is_on_critical_path( n ) == depth_aig.is_on_critical_path( n ) );
+  } );
+
+  CHECK( timing_aig.required( aig.get_node( f1 ) ) == 1u );
+  CHECK( timing_aig.required( aig.get_node( f5 ) ) == 3u );
+  CHECK( timing_aig.required( aig.get_node( c ) ) == 2u );
+  CHECK( timing_aig.slack( aig.get_node( c ) ) == 2 );
+  CHECK( timing_aig.slack( aig.get_node( f2 ) ) == 0 );
+}
+
+TEST_CASE( "update timing of AIG incrementally", "[timing_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto d = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_and( f2, d );
+  aig.create_po( f3 );
+
+  fanout_view fanout_aig{aig};
+  timing_view timing_aig{fanout_aig};
+  CHECK( timing_aig.depth() == 3u );
+
+  /* balance the chain: ( a & b ) & ( c & d ) */
+  const auto g = timing_aig.create_and( c, d );
+  CHECK( timing_aig.level( timing_aig.get_node( g ) ) == 1u );
+  check_timing_from_scratch( timing_aig );
+
+  timing_aig.substitute_node( timing_aig.get_node( f3 ), timing_aig.create_and( f1, g ) );
+  CHECK( timing_aig.depth() == 2u );
+  CHECK( timing_aig.is_on_critical_path( timing_aig.get_node( g ) ) );
+  CHECK( timing_aig.is_dead( timing_aig.get_node( f2 ) ) );
+  check_timing_from_scratch( timing_aig );
+
+  /* the depth grows with a new output */
+  const auto h = timing_aig.create_and( timing_aig.create_and( g, a ), b );
+  timing_aig.create_po( !h );
+  CHECK( timing_aig.depth() == 3u );
+  CHECK( !timing_aig.is_on_critical_path( timing_aig.get_node( f1 ) ) );
+  check_timing_from_scratch( timing_aig );
+}
+
+TEST_CASE( "update timing of MIG under random substitutions", "[timing_view]" )
+{
+  mig_network mig;
+  std::vector<mig_network::signal> a( 16u ), b( 16u );
+  std::generate( a.begin(), a.end(), [&]() { return mig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return mig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( mig, a, b ) )
+  {
+    mig.create_po( f );
+  }
+
+  depth_view_params ps;
+  ps.count_complements = true;
+  fanout_view fanout_mig{mig};
+  timing_view timing_mig{fanout_mig, unit_cost<fanout_view<mig_network>>(), ps};
+
+  /* substitute gates by new gates (with different timing) */
+  std::mt19937 rng( 1u );
+  uint32_t num_substitutions{0};
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    auto const n = static_cast<mig_network::node>( 1u + rng() % ( timing_mig.size() - 1u ) );
+    if ( timing_mig.is_ci( n ) || timing_mig.is_dead( n ) || !timing_mig.is_maj( n ) )
+    {
+      continue;
+    }
+
+    std::vector<mig_network::signal> fanins;
+    timing_mig.foreach_fanin( n, [&]( auto const& f ) { fanins.push_back( f ); } );
+    auto const x = a[rng() % a.size()];
+    auto const size = timing_mig.size();
+    auto const g = timing_mig.create_maj( fanins[0], fanins[1], x );
+    if ( timing_mig.size() == size + 1u && timing_mig.get_node( g ) != n )
+    {
+      timing_mig.substitute_node( n, g );
+      ++num_substitutions;
+    }
+  }
+  CHECK( num_substitutions > 50u );
+  check_timing_from_scratch( timing_mig );
+}
+
+TEST_CASE( "compute timing of a very deep AIG", "[timing_view]" )
+{
+  aig_network aig;
+  auto const x = aig.create_pi();
+  auto const y = aig.create_pi();
+  auto const first = aig.create_and( x, y );
+  auto f = first;
+  for ( auto i = 1u; i < 200000u; ++i )
+  {
+    f = aig.create_and( f, aig.create_pi() );
+  }
+  aig.create_po( f );
+
+  fanout_view fanout_aig{aig};
+  timing_view timing_aig{fanout_aig};
+  CHECK( timing_aig.depth() == 200000u );
+  CHECK( timing_aig.is_on_critical_path( aig.get_node( x ) ) );
+
+  /* shortening the chain at its input updates all levels */
+  timing_aig.substitute_node( aig.get_node( first ), y );
+  CHECK( timing_aig.depth() == 199999u );
+  CHECK( timing_aig.level( timing_aig.get_node( f ) ) == 199999u );
+}